@@ -25,3 +25,19 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(USE_MPI_PROFILER "Collect MPI call statistics per call site and peer" OFF)
+if(USE_MPI_PROFILER)
+  message(STATUS "Enable MPI call statistics")
+  add_compile_definitions(PPC_MPI_PROFILER)
+  if(UNIX)
+    # Export symbols of the test executables so call sites resolve to function names
+    add_link_options(-rdynamic)
+  endif(UNIX)
+endif(USE_MPI_PROFILER)
+
+option(USE_ALLOC_TRACKING "Count heap allocations of perf and functional runs via a global operator new" OFF)
+if(USE_ALLOC_TRACKING)
+  message(STATUS "Enable heap allocation tracking")
+  add_compile_definitions(PPC_ALLOC_TRACKING)
+endif(USE_ALLOC_TRACKING)
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/partition.hpp"
+
+namespace ppc::collective {
+
+/// @brief How the input of a distributed reduction reaches the ranks.
+enum class Distribution : uint8_t {
+  /// Only the root holds the input; every rank receives its block with MPI_Scatterv.
+  kScatter,
+  /// Every rank holds the whole input and reduces its own block in place, nothing is sent.
+  kReplicated,
+};
+
+/// @brief Options of DistributedReduce.
+struct ReduceOptions {
+  Distribution distribution = Distribution::kScatter;
+  /// Rank that owns the input in kScatter mode.
+  int root = 0;
+  MPI_Comm comm = MPI_COMM_WORLD;
+};
+
+/// @brief Value together with its global position in the reduced buffer.
+template <typename T>
+struct IndexedValue {
+  T value{};
+  std::size_t index = std::numeric_limits<std::size_t>::max();
+
+  friend bool operator==(const IndexedValue &, const IndexedValue &) = default;
+};
+
+// Reduction ops. Every op provides:
+//   ResultType                                   - type of partial and final results;
+//   Identity()                                   - result of an empty block;
+//   Local(span<const T> block, size_t offset)    - result of one block, `offset` is its global position;
+//   Combine(lhs, rhs)                            - associative merge, `lhs` always comes from lower positions;
+//   GetMpiOp()                                   - builtin MPI_Op equivalent to Combine, MPI_OP_NULL if none.
+
+/// @brief Sum of the elements, accumulated in AccType (e.g. int64_t for int input).
+template <typename T, typename AccType = T>
+  requires std::is_arithmetic_v<T> && std::is_arithmetic_v<AccType>
+struct Sum {
+  using ResultType = AccType;
+
+  [[nodiscard]] ResultType Identity() const {
+    return ResultType{};
+  }
+  [[nodiscard]] ResultType Local(std::span<const T> block, std::size_t /*offset*/) const {
+    const T *data = block.data();
+    const std::size_t count = block.size();
+    ResultType acc{};
+#pragma omp simd reduction(+ : acc)
+    for (std::size_t i = 0; i < count; i++) {
+      acc += static_cast<ResultType>(data[i]);
+    }
+    return acc;
+  }
+  [[nodiscard]] ResultType Combine(ResultType lhs, ResultType rhs) const {
+    return lhs + rhs;
+  }
+  [[nodiscard]] static MPI_Op GetMpiOp() {
+    return MPI_SUM;
+  }
+};
+
+/// @brief Smallest element; the identity (empty input) is the largest value of T.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+struct Min {
+  using ResultType = T;
+
+  [[nodiscard]] ResultType Identity() const {
+    return std::numeric_limits<T>::max();
+  }
+  [[nodiscard]] ResultType Local(std::span<const T> block, std::size_t /*offset*/) const {
+    const T *data = block.data();
+    const std::size_t count = block.size();
+    T acc = Identity();
+#pragma omp simd reduction(min : acc)
+    for (std::size_t i = 0; i < count; i++) {
+      acc = std::min(acc, data[i]);
+    }
+    return acc;
+  }
+  [[nodiscard]] ResultType Combine(ResultType lhs, ResultType rhs) const {
+    return std::min(lhs, rhs);
+  }
+  [[nodiscard]] static MPI_Op GetMpiOp() {
+    return MPI_MIN;
+  }
+};
+
+/// @brief Largest element; the identity (empty input) is the lowest value of T.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+struct Max {
+  using ResultType = T;
+
+  [[nodiscard]] ResultType Identity() const {
+    return std::numeric_limits<T>::lowest();
+  }
+  [[nodiscard]] ResultType Local(std::span<const T> block, std::size_t /*offset*/) const {
+    const T *data = block.data();
+    const std::size_t count = block.size();
+    T acc = Identity();
+#pragma omp simd reduction(max : acc)
+    for (std::size_t i = 0; i < count; i++) {
+      acc = std::max(acc, data[i]);
+    }
+    return acc;
+  }
+  [[nodiscard]] ResultType Combine(ResultType lhs, ResultType rhs) const {
+    return std::max(lhs, rhs);
+  }
+  [[nodiscard]] static MPI_Op GetMpiOp() {
+    return MPI_MAX;
+  }
+};
+
+/// @brief Smallest element and the position of its first occurrence.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+struct ArgMin {
+  using ResultType = IndexedValue<T>;
+
+  [[nodiscard]] ResultType Identity() const {
+    return {.value = std::numeric_limits<T>::max()};
+  }
+  [[nodiscard]] ResultType Local(std::span<const T> block, std::size_t offset) const {
+    if (block.empty()) {
+      return Identity();
+    }
+    // Vectorized value pass, then a scan for the first match instead of a branchy index-tracking loop
+    const T value = Min<T>{}.Local(block, offset);
+    const auto position = static_cast<std::size_t>(std::ranges::find(block, value) - block.begin());
+    return {.value = value, .index = offset + position};
+  }
+  [[nodiscard]] ResultType Combine(const ResultType &lhs, const ResultType &rhs) const {
+    if (rhs.value < lhs.value || (rhs.value == lhs.value && rhs.index < lhs.index)) {
+      return rhs;
+    }
+    return lhs;
+  }
+  [[nodiscard]] static MPI_Op GetMpiOp() {
+    return MPI_OP_NULL;
+  }
+};
+
+/// @brief Largest element and the position of its first occurrence.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+struct ArgMax {
+  using ResultType = IndexedValue<T>;
+
+  [[nodiscard]] ResultType Identity() const {
+    return {.value = std::numeric_limits<T>::lowest()};
+  }
+  [[nodiscard]] ResultType Local(std::span<const T> block, std::size_t offset) const {
+    if (block.empty()) {
+      return Identity();
+    }
+    const T value = Max<T>{}.Local(block, offset);
+    const auto position = static_cast<std::size_t>(std::ranges::find(block, value) - block.begin());
+    return {.value = value, .index = offset + position};
+  }
+  [[nodiscard]] ResultType Combine(const ResultType &lhs, const ResultType &rhs) const {
+    if (lhs.value < rhs.value || (rhs.value == lhs.value && rhs.index < lhs.index)) {
+      return rhs;
+    }
+    return lhs;
+  }
+  [[nodiscard]] static MPI_Op GetMpiOp() {
+    return MPI_OP_NULL;
+  }
+};
+
+/// @brief Number of elements that satisfy a predicate.
+template <typename T, typename Predicate>
+struct CountIf {
+  using ResultType = uint64_t;
+
+  Predicate predicate;
+
+  [[nodiscard]] ResultType Identity() const {
+    return 0;
+  }
+  [[nodiscard]] ResultType Local(std::span<const T> block, std::size_t /*offset*/) const {
+    const T *data = block.data();
+    const std::size_t count = block.size();
+    ResultType acc = 0;
+#pragma omp simd reduction(+ : acc)
+    for (std::size_t i = 0; i < count; i++) {
+      acc += predicate(data[i]) ? 1 : 0;
+    }
+    return acc;
+  }
+  [[nodiscard]] ResultType Combine(ResultType lhs, ResultType rhs) const {
+    return lhs + rhs;
+  }
+  [[nodiscard]] static MPI_Op GetMpiOp() {
+    return MPI_SUM;
+  }
+};
+
+/// @brief Makes a CountIf op for elements of type T, deducing the predicate type.
+template <typename T, typename Predicate>
+CountIf<T, Predicate> MakeCountIf(Predicate predicate) {
+  return CountIf<T, Predicate>{.predicate = std::move(predicate)};
+}
+
+/// @brief Combines the partial results of all ranks of `comm`; every rank gets the result.
+/// @details Uses MPI_Allreduce when the op has a builtin MPI equivalent. Otherwise the partial results are gathered
+/// and folded in rank order, which keeps the result deterministic (e.g. ArgMin returns the first position).
+template <typename Op>
+typename Op::ResultType AllCombine(const Op &op, const typename Op::ResultType &partial, MPI_Comm comm) {
+  using ResultType = typename Op::ResultType;
+  static_assert(std::is_trivially_copyable_v<ResultType>, "partial results are sent as raw bytes");
+
+  const MPI_Op mpi_op = Op::GetMpiOp();
+  const MPI_Datatype type = ppc::util::GetMpiType<ResultType>();
+  if (mpi_op != MPI_OP_NULL && type != MPI_DATATYPE_NULL) {
+    ResultType result{};
+    MPI_Allreduce(&partial, &result, 1, type, mpi_op, comm);
+    return result;
+  }
+
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  std::vector<ResultType> partials(static_cast<std::size_t>(size));
+  MPI_Allgather(&partial, static_cast<int>(sizeof(ResultType)), MPI_BYTE, partials.data(),
+                static_cast<int>(sizeof(ResultType)), MPI_BYTE, comm);
+  ResultType result = op.Identity();
+  for (const auto &value : partials) {
+    result = op.Combine(result, value);
+  }
+  return result;
+}
+
+/// @brief Distributes a contiguous buffer between the ranks of `options.comm`, reduces every block locally with
+/// `op` and combines the partial results.
+/// @param data Whole input: on the root in kScatter mode (ignored elsewhere), on every rank in kReplicated mode.
+/// @return Reduction of the whole buffer on every rank.
+/// @throws std::runtime_error In kScatter mode, if the input does not fit the int counts of MPI_Scatterv.
+template <std::ranges::contiguous_range Range, typename Op>
+typename Op::ResultType DistributedReduce(const Range &data, const Op &op, const ReduceOptions &options = {}) {
+  using T = std::ranges::range_value_t<Range>;
+  const std::span<const T> input(std::ranges::data(data), std::ranges::size(data));
+
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(options.comm, &rank);
+  MPI_Comm_size(options.comm, &size);
+
+  if (options.distribution == Distribution::kReplicated) {
+    const auto range = ppc::util::BlockPartition(input.size(), size).Range(rank);
+    return AllCombine(op, op.Local(input.subspan(range.begin, range.Size()), range.begin), options.comm);
+  }
+
+  uint64_t total = rank == options.root ? input.size() : 0;
+  MPI_Bcast(&total, 1, MPI_UINT64_T, options.root, options.comm);
+  const ppc::util::BlockPartition partition(total, size);
+  const auto range = partition.Range(rank);
+
+  // Arithmetic types are sent as themselves, anything else as raw bytes
+  MPI_Datatype type = ppc::util::GetMpiType<T>();
+  std::size_t unit = 1;
+  if (type == MPI_DATATYPE_NULL) {
+    type = MPI_BYTE;
+    unit = sizeof(T);
+  }
+  // Checked on every rank so that all of them throw together instead of hanging in the collective
+  if (total > static_cast<uint64_t>(INT_MAX) / unit) {
+    throw std::runtime_error("DistributedReduce: input is too large for the int counts of MPI_Scatterv");
+  }
+
+  if (rank == options.root) {
+    const std::vector<int> counts = partition.Counts(unit);
+    const std::vector<int> displs = partition.Displs(unit);
+    // The root reduces its block straight from the input, without copying it
+    MPI_Scatterv(input.data(), counts.data(), displs.data(), type, MPI_IN_PLACE, 0, type, options.root, options.comm);
+    return AllCombine(op, op.Local(input.subspan(range.begin, range.Size()), range.begin), options.comm);
+  }
+
+  std::vector<T> local(range.Size());
+  MPI_Scatterv(nullptr, nullptr, nullptr, type, local.data(), static_cast<int>(range.Size() * unit), type,
+               options.root, options.comm);
+  return AllCombine(op, op.Local(std::span<const T>(local), range.begin), options.comm);
+}
+
+}  // namespace ppc::collective
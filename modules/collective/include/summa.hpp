@@ -0,0 +1,104 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "util/include/partition.hpp"
+
+namespace ppc::collective {
+
+/// @brief The ranks of a communicator as a Rows() x Cols() Cartesian grid, with one communicator per grid row and
+/// one per grid column.
+/// @details The grid is the most square factorization of the number of ranks (MPI_Dims_create): 4 ranks give 2 x 2,
+/// 6 give 3 x 2 and a prime P gives P x 1. Ranks keep their numbers and fill the grid row by row.
+class ProcessGrid {
+ public:
+  explicit ProcessGrid(MPI_Comm comm = MPI_COMM_WORLD);
+  ~ProcessGrid();
+
+  ProcessGrid(const ProcessGrid &) = delete;
+  ProcessGrid &operator=(const ProcessGrid &) = delete;
+  ProcessGrid(ProcessGrid &&) = delete;
+  ProcessGrid &operator=(ProcessGrid &&) = delete;
+
+  [[nodiscard]] int Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] int Cols() const {
+    return cols_;
+  }
+  [[nodiscard]] int Row() const {
+    return row_;
+  }
+  [[nodiscard]] int Col() const {
+    return col_;
+  }
+  /// @brief Cartesian communicator of the whole grid; rank r is at (r / Cols(), r % Cols()).
+  [[nodiscard]] MPI_Comm Comm() const {
+    return grid_comm_;
+  }
+  /// @brief Ranks of the same grid row; the rank in it is the grid column.
+  [[nodiscard]] MPI_Comm RowComm() const {
+    return row_comm_;
+  }
+  /// @brief Ranks of the same grid column; the rank in it is the grid row.
+  [[nodiscard]] MPI_Comm ColComm() const {
+    return col_comm_;
+  }
+
+ private:
+  int rows_ = 1;
+  int cols_ = 1;
+  int row_ = 0;
+  int col_ = 0;
+  MPI_Comm grid_comm_ = MPI_COMM_NULL;
+  MPI_Comm row_comm_ = MPI_COMM_NULL;
+  MPI_Comm col_comm_ = MPI_COMM_NULL;
+};
+
+/// @brief Blocks of C = A * B (A is m x k, B is k x n) on a grid_rows x grid_cols process grid.
+/// @details Rank (r, c) holds the rows rows.Range(r) and the columns a_inner.Range(c) of A, the rows b_inner.Range(r)
+/// and the columns cols.Range(c) of B, and computes the rows rows.Range(r) and the columns cols.Range(c) of C.
+struct SummaLayout {
+  SummaLayout(std::size_t m, std::size_t n, std::size_t k, int grid_rows, int grid_cols)
+      : rows(m, grid_rows), cols(n, grid_cols), a_inner(k, grid_cols), b_inner(k, grid_rows) {}
+
+  /// @brief Boundaries of the k-panels multiplied one after another: 0, ..., k.
+  /// @details A panel is at most `panel` wide and lies in one block of a_inner and of b_inner, so one rank of every
+  /// grid row owns its part of A and one rank of every grid column its part of B.
+  /// @throws std::runtime_error If `panel` is 0.
+  [[nodiscard]] std::vector<std::size_t> Panels(std::size_t panel) const;
+
+  ppc::util::BlockPartition rows;
+  ppc::util::BlockPartition cols;
+  ppc::util::BlockPartition a_inner;
+  ppc::util::BlockPartition b_inner;
+};
+
+/// @brief Options of SummaMultiply.
+struct SummaOptions {
+  /// Largest width of the k-panels broadcast in one step.
+  std::size_t panel = 256;
+  /// Rank that holds A and B and receives C.
+  int root = 0;
+  MPI_Comm comm = MPI_COMM_WORLD;
+};
+
+/// @brief C = A * B for row-major double matrices with the SUMMA algorithm on a ProcessGrid of `options.comm`.
+/// @details The root sends every rank its blocks of A and B (SummaLayout). For every k-panel, the owner of the A panel
+/// broadcasts it along its grid row, the owner of the B panel along its grid column, and every rank adds the product
+/// of the two to its block of C with GemmAccumulate(). The broadcasts of the next panel are posted (MPI_Ibcast) before
+/// the product of the current one is computed, so they overlap. A rank receives about (m + n) k / sqrt(P) values
+/// instead of all of B. The blocks of C are collected on the root.
+/// @param m, n, k Dimensions, the same on every rank.
+/// @param a, b The matrices on the root; ignored on the other ranks.
+/// @return C (m x n) on the root, empty on the other ranks.
+/// @throws std::runtime_error If a block does not fit the int counts of MPI, or on the root if `a` or `b` is smaller
+/// than its matrix.
+std::vector<double> SummaMultiply(std::size_t m, std::size_t n, std::size_t k, std::span<const double> a,
+                                  std::span<const double> b, const SummaOptions &options = {});
+
+}  // namespace ppc::collective
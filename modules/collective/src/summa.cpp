@@ -0,0 +1,275 @@
+#include "collective/include/summa.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/gemm.hpp"
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/partition.hpp"
+
+namespace ppc::collective {
+
+namespace {
+
+constexpr int kBlockTag = 0;
+
+int ToInt(std::size_t value) {
+  if (value > static_cast<std::size_t>(INT_MAX)) {
+    throw std::runtime_error("SummaMultiply: a block does not fit the int counts of MPI");
+  }
+  return static_cast<int>(value);
+}
+
+/// Rows x cols block of a row-major matrix whose rows are `stride` elements apart.
+ppc::util::MpiDatatype BlockType(std::size_t rows, std::size_t cols, std::size_t stride) {
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_vector(ToInt(rows), ToInt(cols), ToInt(stride), MPI_DOUBLE, &type);
+  return ppc::util::MpiDatatype(type);
+}
+
+/// Sends every rank of the grid its block of a row-major matrix held by the root and returns the block of this rank.
+std::vector<double> ScatterBlocks(const double *matrix, std::size_t stride, const ppc::util::BlockPartition &row_blocks,
+                                  const ppc::util::BlockPartition &col_blocks, const ProcessGrid &grid, int root) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(grid.Comm(), &rank);
+  MPI_Comm_size(grid.Comm(), &size);
+  const auto my_rows = row_blocks.Range(grid.Row());
+  const auto my_cols = col_blocks.Range(grid.Col());
+  std::vector<double> block(my_rows.Size() * my_cols.Size());
+  if (rank != root) {
+    if (!block.empty()) {
+      MPI_Recv(block.data(), ToInt(block.size()), MPI_DOUBLE, root, kBlockTag, grid.Comm(), MPI_STATUS_IGNORE);
+    }
+    return block;
+  }
+  // The blocks are sent in place with strided datatypes, the root's own block is copied
+  std::vector<ppc::util::MpiDatatype> types;
+  std::vector<MPI_Request> requests;
+  for (int dest = 0; dest < size; dest++) {
+    const auto rows = row_blocks.Range(dest / grid.Cols());
+    const auto cols = col_blocks.Range(dest % grid.Cols());
+    if (dest == root || rows.Size() == 0 || cols.Size() == 0) {
+      continue;
+    }
+    types.push_back(BlockType(rows.Size(), cols.Size(), stride));
+    MPI_Request &request = requests.emplace_back();
+    MPI_Isend(matrix + (rows.begin * stride) + cols.begin, 1, types.back().Get(), dest, kBlockTag, grid.Comm(),
+              &request);
+  }
+  for (std::size_t i = 0; i < my_rows.Size(); i++) {
+    const double *row = matrix + ((my_rows.begin + i) * stride) + my_cols.begin;
+    std::copy(row, row + my_cols.Size(), block.begin() + static_cast<std::ptrdiff_t>(i * my_cols.Size()));
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  return block;
+}
+
+/// Inverse of ScatterBlocks: the root receives the block of every rank into its place in `matrix`.
+void GatherBlocks(const std::vector<double> &block, double *matrix, std::size_t stride,
+                  const ppc::util::BlockPartition &row_blocks, const ppc::util::BlockPartition &col_blocks,
+                  const ProcessGrid &grid, int root) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(grid.Comm(), &rank);
+  MPI_Comm_size(grid.Comm(), &size);
+  if (rank != root) {
+    if (!block.empty()) {
+      MPI_Send(block.data(), ToInt(block.size()), MPI_DOUBLE, root, kBlockTag, grid.Comm());
+    }
+    return;
+  }
+  std::vector<ppc::util::MpiDatatype> types;
+  std::vector<MPI_Request> requests;
+  for (int src = 0; src < size; src++) {
+    const auto rows = row_blocks.Range(src / grid.Cols());
+    const auto cols = col_blocks.Range(src % grid.Cols());
+    if (src == root || rows.Size() == 0 || cols.Size() == 0) {
+      continue;
+    }
+    types.push_back(BlockType(rows.Size(), cols.Size(), stride));
+    MPI_Request &request = requests.emplace_back();
+    MPI_Irecv(matrix + (rows.begin * stride) + cols.begin, 1, types.back().Get(), src, kBlockTag, grid.Comm(),
+              &request);
+  }
+  const auto my_rows = row_blocks.Range(grid.Row());
+  const auto my_cols = col_blocks.Range(grid.Col());
+  for (std::size_t i = 0; i < my_rows.Size(); i++) {
+    const auto row = block.begin() + static_cast<std::ptrdiff_t>(i * my_cols.Size());
+    std::copy(row, row + static_cast<std::ptrdiff_t>(my_cols.Size()),
+              matrix + ((my_rows.begin + i) * stride) + my_cols.begin);
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/// A k-panel of A (the rows of this grid row) and of B (the columns of this grid column) while it is broadcast.
+/// @details The owners broadcast straight from their blocks, the other ranks receive into the buffers.
+struct Panel {
+  std::vector<double> a_buffer;
+  std::vector<double> b_buffer;
+  ppc::util::MpiDatatype a_type;
+  std::array<MPI_Request, 2> requests{MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  const double *a = nullptr;
+  std::size_t lda = 0;
+  const double *b = nullptr;
+  std::size_t ldb = 0;
+};
+
+/// Local blocks of the operands and of the result on one rank of the grid.
+struct LocalBlocks {
+  ppc::util::PartitionRange rows;
+  ppc::util::PartitionRange cols;
+  ppc::util::PartitionRange a_inner;
+  ppc::util::PartitionRange b_inner;
+  std::vector<double> a;
+  std::vector<double> b;
+};
+
+void PostPanel(std::size_t begin, std::size_t end, const SummaLayout &layout, const ProcessGrid &grid,
+               LocalBlocks &local, Panel &panel) {
+  const std::size_t width = end - begin;
+  const std::size_t rows = local.rows.Size();
+  const std::size_t cols = local.cols.Size();
+  panel.requests = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+
+  // All ranks of a grid row share the rows, so either all of them or none take part in the broadcast
+  const int a_owner = layout.a_inner.Owner(begin);
+  if (grid.Col() == a_owner) {
+    panel.a = local.a.data() + (begin - local.a_inner.begin);
+    panel.lda = local.a_inner.Size();
+  } else {
+    panel.a_buffer.resize(rows * width);
+    panel.a = panel.a_buffer.data();
+    panel.lda = width;
+  }
+  if (rows != 0) {
+    if (grid.Col() == a_owner) {
+      panel.a_type = BlockType(rows, width, panel.lda);
+      MPI_Ibcast(local.a.data() + (begin - local.a_inner.begin), 1, panel.a_type.Get(), a_owner, grid.RowComm(),
+                 panel.requests.data());
+    } else {
+      MPI_Ibcast(panel.a_buffer.data(), ToInt(rows * width), MPI_DOUBLE, a_owner, grid.RowComm(),
+                 panel.requests.data());
+    }
+  }
+
+  // Rows of B are contiguous in the block of the owner
+  const int b_owner = layout.b_inner.Owner(begin);
+  double *b_data = nullptr;
+  if (grid.Row() == b_owner) {
+    b_data = local.b.data() + ((begin - local.b_inner.begin) * cols);
+  } else {
+    panel.b_buffer.resize(width * cols);
+    b_data = panel.b_buffer.data();
+  }
+  panel.b = b_data;
+  panel.ldb = cols;
+  if (cols != 0) {
+    MPI_Ibcast(b_data, ToInt(width * cols), MPI_DOUBLE, b_owner, grid.ColComm(), &panel.requests[1]);
+  }
+}
+
+}  // namespace
+
+ProcessGrid::ProcessGrid(MPI_Comm comm) {
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  std::array<int, 2> dims{0, 0};
+  MPI_Dims_create(size, 2, dims.data());
+  rows_ = dims[0];
+  cols_ = dims[1];
+  const std::array<int, 2> periods{0, 0};
+  MPI_Cart_create(comm, 2, dims.data(), periods.data(), 0, &grid_comm_);
+  int rank = 0;
+  MPI_Comm_rank(grid_comm_, &rank);
+  std::array<int, 2> coords{0, 0};
+  MPI_Cart_coords(grid_comm_, rank, 2, coords.data());
+  row_ = coords[0];
+  col_ = coords[1];
+  const std::array<int, 2> keep_cols{0, 1};
+  MPI_Cart_sub(grid_comm_, keep_cols.data(), &row_comm_);
+  const std::array<int, 2> keep_rows{1, 0};
+  MPI_Cart_sub(grid_comm_, keep_rows.data(), &col_comm_);
+}
+
+ProcessGrid::~ProcessGrid() {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized != 0) {
+    return;
+  }
+  for (MPI_Comm *comm : {&row_comm_, &col_comm_, &grid_comm_}) {
+    if (*comm != MPI_COMM_NULL) {
+      MPI_Comm_free(comm);
+    }
+  }
+}
+
+std::vector<std::size_t> SummaLayout::Panels(std::size_t panel) const {
+  if (panel == 0) {
+    throw std::runtime_error("SummaLayout: panel width must be positive");
+  }
+  const std::size_t k = a_inner.Total();
+  std::vector<std::size_t> boundaries;
+  for (std::size_t begin = 0; begin < k; begin += panel) {
+    boundaries.push_back(begin);
+  }
+  for (int part = 0; part < a_inner.Parts(); part++) {
+    boundaries.push_back(a_inner.Begin(part));
+  }
+  for (int part = 0; part < b_inner.Parts(); part++) {
+    boundaries.push_back(b_inner.Begin(part));
+  }
+  boundaries.push_back(k);
+  std::ranges::sort(boundaries);
+  const auto duplicates = std::ranges::unique(boundaries);
+  boundaries.erase(duplicates.begin(), duplicates.end());
+  return boundaries;
+}
+
+std::vector<double> SummaMultiply(std::size_t m, std::size_t n, std::size_t k, std::span<const double> a,
+                                  std::span<const double> b, const SummaOptions &options) {
+  const ProcessGrid grid(options.comm);
+  int rank = 0;
+  MPI_Comm_rank(grid.Comm(), &rank);
+  if (rank == options.root && (a.size() < m * k || b.size() < k * n)) {
+    throw std::runtime_error("SummaMultiply: matrix spans are smaller than their dimensions");
+  }
+  const SummaLayout layout(m, n, k, grid.Rows(), grid.Cols());
+  LocalBlocks local{.rows = layout.rows.Range(grid.Row()),
+                    .cols = layout.cols.Range(grid.Col()),
+                    .a_inner = layout.a_inner.Range(grid.Col()),
+                    .b_inner = layout.b_inner.Range(grid.Row()),
+                    .a = ScatterBlocks(a.data(), k, layout.rows, layout.a_inner, grid, options.root),
+                    .b = ScatterBlocks(b.data(), n, layout.b_inner, layout.cols, grid, options.root)};
+
+  // Two panels in flight: the broadcasts of panel p + 1 run while the product of panel p is computed
+  std::vector<double> c_block(local.rows.Size() * local.cols.Size(), 0.0);
+  const auto panels = layout.Panels(options.panel);
+  std::array<Panel, 2> in_flight;
+  if (panels.size() > 1) {
+    PostPanel(panels[0], panels[1], layout, grid, local, in_flight[0]);
+  }
+  for (std::size_t p = 0; p + 1 < panels.size(); p++) {
+    if (p + 2 < panels.size()) {
+      PostPanel(panels[p + 1], panels[p + 2], layout, grid, local, in_flight[(p + 1) % 2]);
+    }
+    Panel &panel = in_flight[p % 2];
+    MPI_Waitall(static_cast<int>(panel.requests.size()), panel.requests.data(), MPI_STATUSES_IGNORE);
+    ppc::util::GemmAccumulate(local.rows.Size(), local.cols.Size(), panels[p + 1] - panels[p], panel.a, panel.lda,
+                              panel.b, panel.ldb, c_block.data(), local.cols.Size());
+  }
+
+  std::vector<double> c(rank == options.root ? m * n : 0);
+  GatherBlocks(c_block, c.data(), n, layout.rows, layout.cols, grid, options.root);
+  return c;
+}
+
+}  // namespace ppc::collective
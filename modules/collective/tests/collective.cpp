@@ -0,0 +1,120 @@
+#include "collective/include/collective.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::collective {
+
+namespace {
+
+// Splits the data into `parts` blocks and folds their local results, as DistributedReduce does across ranks
+template <typename T, typename Op>
+typename Op::ResultType FoldBlocks(const std::vector<T> &data, const Op &op, int parts) {
+  const ppc::util::BlockPartition partition(data.size(), parts);
+  auto result = op.Identity();
+  for (int i = 0; i < parts; i++) {
+    const auto range = partition.Range(i);
+    result = op.Combine(result, op.Local(std::span<const T>(data).subspan(range.begin, range.Size()), range.begin));
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CollectiveTest, GetMpiTypeMapsArithmeticTypes) {
+  EXPECT_EQ(ppc::util::GetMpiType<int>(), MPI_INT32_T);
+  EXPECT_EQ(ppc::util::GetMpiType<int64_t>(), MPI_INT64_T);
+  EXPECT_EQ(ppc::util::GetMpiType<uint64_t>(), MPI_UINT64_T);
+  EXPECT_EQ(ppc::util::GetMpiType<double>(), MPI_DOUBLE);
+  EXPECT_EQ(ppc::util::GetMpiType<IndexedValue<int>>(), MPI_DATATYPE_NULL);
+}
+
+TEST(CollectiveTest, SumAccumulatesInWiderType) {
+  const std::vector<int> data(1000, std::numeric_limits<int>::max());
+  const auto expected = static_cast<int64_t>(std::numeric_limits<int>::max()) * 1000;
+  EXPECT_EQ((FoldBlocks(data, Sum<int, int64_t>{}, 3)), expected);
+  EXPECT_EQ(Sum<int>{}.Local({}, 0), 0);
+}
+
+TEST(CollectiveTest, MinAndMaxMatchSequentialResult) {
+  std::vector<double> data(257);
+  std::iota(data.begin(), data.end(), -100.0);
+  data[131] = -1000.0;
+  data[17] = 1000.0;
+  EXPECT_DOUBLE_EQ(FoldBlocks(data, Min<double>{}, 4), -1000.0);
+  EXPECT_DOUBLE_EQ(FoldBlocks(data, Max<double>{}, 4), 1000.0);
+  EXPECT_EQ(FoldBlocks(std::vector<int>{}, Max<int>{}, 2), std::numeric_limits<int>::lowest());
+}
+
+TEST(CollectiveTest, ArgMinAndArgMaxReturnFirstOccurrence) {
+  const std::vector<int> data = {5, 3, 9, 1, 9, 1, 7, 9};
+  for (int parts : {1, 2, 3, 8}) {
+    EXPECT_EQ(FoldBlocks(data, ArgMin<int>{}, parts), (IndexedValue<int>{.value = 1, .index = 3}));
+    EXPECT_EQ(FoldBlocks(data, ArgMax<int>{}, parts), (IndexedValue<int>{.value = 9, .index = 2}));
+  }
+}
+
+TEST(CollectiveTest, CountIfCountsMatchingElements) {
+  std::vector<int> data(1001);
+  std::iota(data.begin(), data.end(), 0);
+  const auto even = MakeCountIf<int>([](int value) { return value % 2 == 0; });
+  EXPECT_EQ(FoldBlocks(data, even, 5), 501U);
+}
+
+// DistributedReduce on the real communicator: sizes below and above the number of ranks, both distributions.
+// Runs when core_func_tests is started under mpirun (see run_tests.py), skipped otherwise
+TEST(CollectiveMpiTest, DistributedReduceMatchesSequentialResult) {
+  if (!ppc::util::IsUnderMpirun()) {
+    GTEST_SKIP();
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  for (std::size_t size : {0U, 1U, 2U, 7U, 1000U}) {
+    std::vector<int> data(size);
+    for (std::size_t i = 0; i < size; i++) {
+      data[i] = static_cast<int>((i * 7) % 11) - 5;
+    }
+    const auto expected_sum = std::accumulate(data.begin(), data.end(), int64_t{0});
+    const auto negative = [](int value) { return value < 0; };
+    const auto expected_negative = static_cast<uint64_t>(std::ranges::count_if(data, negative));
+
+    for (auto distribution : {Distribution::kScatter, Distribution::kReplicated}) {
+      SCOPED_TRACE("size " + std::to_string(size));
+      const bool has_data = distribution == Distribution::kReplicated || rank == 0;
+      const std::vector<int> input = has_data ? data : std::vector<int>();
+      const ReduceOptions options{.distribution = distribution};
+
+      EXPECT_EQ(DistributedReduce(input, Sum<int, int64_t>{}, options), expected_sum);
+      EXPECT_EQ(DistributedReduce(input, MakeCountIf<int>(negative), options), expected_negative);
+      const auto arg_min = DistributedReduce(input, ArgMin<int>{}, options);
+      const auto arg_max = DistributedReduce(input, ArgMax<int>{}, options);
+      if (size == 0) {
+        EXPECT_EQ(arg_min, ArgMin<int>{}.Identity());
+        EXPECT_EQ(arg_max, ArgMax<int>{}.Identity());
+        continue;
+      }
+      const auto min_it = std::ranges::min_element(data);
+      const auto max_it = std::ranges::max_element(data);
+      EXPECT_EQ(arg_min.value, *min_it);
+      EXPECT_EQ(arg_min.index, static_cast<std::size_t>(min_it - data.begin()));
+      EXPECT_EQ(arg_max.value, *max_it);
+      EXPECT_EQ(arg_max.index, static_cast<std::size_t>(max_it - data.begin()));
+    }
+  }
+}
+
+}  // namespace ppc::collective
@@ -0,0 +1,51 @@
+#include "collective/include/summa.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ppc::collective {
+
+TEST(SummaTest, LayoutSplitsOperandsAlongGrid) {
+  const SummaLayout layout(10, 7, 13, 3, 2);
+  EXPECT_EQ(layout.rows.Parts(), 3);
+  EXPECT_EQ(layout.rows.Total(), 10U);
+  EXPECT_EQ(layout.cols.Parts(), 2);
+  EXPECT_EQ(layout.cols.Total(), 7U);
+  EXPECT_EQ(layout.a_inner.Parts(), 2);
+  EXPECT_EQ(layout.b_inner.Parts(), 3);
+  EXPECT_EQ(layout.a_inner.Total(), 13U);
+  EXPECT_EQ(layout.b_inner.Total(), 13U);
+}
+
+TEST(SummaTest, PanelsLieInOneBlockOfEachOperand) {
+  for (int grid_rows : {1, 2, 3}) {
+    for (int grid_cols : {1, 2, 4}) {
+      for (std::size_t panel : {1U, 3U, 5U, 256U}) {
+        const SummaLayout layout(4, 4, 23, grid_rows, grid_cols);
+        const auto panels = layout.Panels(panel);
+        ASSERT_GE(panels.size(), 2U);
+        EXPECT_EQ(panels.front(), 0U);
+        EXPECT_EQ(panels.back(), 23U);
+        for (std::size_t p = 0; p + 1 < panels.size(); p++) {
+          const std::size_t begin = panels[p];
+          const std::size_t end = panels[p + 1];
+          ASSERT_LT(begin, end);
+          EXPECT_LE(end - begin, panel);
+          EXPECT_EQ(layout.a_inner.Owner(begin), layout.a_inner.Owner(end - 1));
+          EXPECT_EQ(layout.b_inner.Owner(begin), layout.b_inner.Owner(end - 1));
+        }
+      }
+    }
+  }
+}
+
+TEST(SummaTest, PanelsOfEmptyInnerDimension) {
+  const SummaLayout layout(3, 3, 0, 2, 2);
+  EXPECT_EQ(layout.Panels(8), std::vector<std::size_t>{0});
+  EXPECT_THROW((void)layout.Panels(0), std::runtime_error);
+}
+
+}  // namespace ppc::collective
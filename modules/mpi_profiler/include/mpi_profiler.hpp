@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::mpi_profiler {
+
+/// @brief Peer value of calls that involve every rank of the communicator (Allreduce, Alltoall, Win_fence, ...).
+inline constexpr int kAllPeers = -1000;
+/// @brief Peer value of calls without a peer rank (Wait, Waitall).
+inline constexpr int kNoPeer = -1001;
+
+/// @brief Aggregated statistics of one intercepted MPI function called from one call site for one peer.
+struct CallStats {
+  /// @brief MPI function name, e.g. "MPI_Bcast".
+  std::string call;
+  /// @brief Resolved caller ("function+0xoffset" or "module+0xoffset").
+  std::string site;
+  /// @brief Destination/source rank for point-to-point calls, root for rooted collectives, kAllPeers otherwise.
+  int peer = kAllPeers;
+  std::uint64_t calls = 0;
+  /// @brief Total size of the send and receive buffers passed to the calls on this rank.
+  std::uint64_t bytes = 0;
+  /// @brief Total wall time in seconds spent inside the calls.
+  double time = 0.0;
+};
+
+/// @brief Returns true if MPI calls are intercepted through the PMPI interface in this build.
+/// @details Interception does not depend on USE_MPI_PROFILER: GetCommTime() and tracing need it in every build.
+/// @note Interception is not available on Windows (MS-MPI), where all counters stay at zero.
+bool IsAvailable();
+
+/// @brief Returns true if the build collects per call site statistics (CMake option USE_MPI_PROFILER).
+bool IsCallStatsEnabled();
+
+/// @brief Returns the total wall time in seconds spent inside intercepted MPI calls on this rank.
+double GetCommTime();
+
+/// @brief Resets the accumulated communication time.
+void ResetCommTime();
+
+/// @brief Returns the total size of the send and receive buffers passed to intercepted MPI calls on this rank.
+/// @details Same accounting as CallStats::bytes: what a rank hands to MPI, not what travels over the network.
+std::uint64_t GetCommBytes();
+
+/// @brief Resets the accumulated communication volume.
+void ResetCommBytes();
+
+/// @brief Makes intercepted calls count their buffer sizes for GetCommBytes() in builds without call statistics.
+/// @details Off by default: sizing the buffers takes datatype and communicator lookups in every call, which only
+/// runs that report the volume should pay for.
+void SetCommBytesEnabled(bool enabled);
+
+/// @brief Returns true if GetCommBytes() is counted: with call statistics, tracing or SetCommBytesEnabled().
+bool IsCommBytesEnabled();
+
+/// @brief Returns the statistics collected on this rank since the last reset, the most expensive first.
+std::vector<CallStats> GetCallStats();
+
+/// @brief Drops the collected call statistics.
+void ResetCallStats();
+
+/// @brief Formats statistics of one rank as human-readable lines prefixed with the rank number.
+std::string FormatCallStats(int rank, const std::vector<CallStats> &stats);
+
+/// @brief Prints the statistics of all ranks on rank 0 and resets them.
+/// @details Collective over MPI_COMM_WORLD. Does nothing if call statistics are disabled.
+/// @param title Header printed before the statistics, usually the test name.
+void PrintCallStatsSummary(const std::string &title);
+
+}  // namespace ppc::mpi_profiler
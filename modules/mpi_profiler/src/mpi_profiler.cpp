@@ -0,0 +1,489 @@
+#include "mpi_profiler/include/mpi_profiler.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "trace/include/trace.hpp"
+
+#ifndef _WIN32
+#  include <cxxabi.h>
+#  include <dlfcn.h>
+#endif
+
+namespace ppc::mpi_profiler {
+
+namespace {
+
+#if defined(PPC_MPI_PROFILER) && !defined(_WIN32)
+constexpr bool kCallStatsEnabled = true;
+#else
+constexpr bool kCallStatsEnabled = false;
+#endif
+
+double &CommTimeStorage() {
+  static double comm_time = 0.0;
+  return comm_time;
+}
+
+std::uint64_t &CommBytesStorage() {
+  static std::uint64_t comm_bytes = 0;
+  return comm_bytes;
+}
+
+bool &CommBytesEnabledStorage() {
+  static bool enabled = false;
+  return enabled;
+}
+
+/// @brief Per call site counters keyed by (MPI function, return address, peer).
+class CallStatsStorage {
+ public:
+  static CallStatsStorage &Instance() {
+    static CallStatsStorage storage;
+    return storage;
+  }
+
+  void Record(std::string_view call, const void *site, int peer, std::uint64_t bytes, double time) {
+    const std::scoped_lock lock(mutex_);
+    auto &stats = stats_[Key{call, reinterpret_cast<std::uintptr_t>(site), peer}];
+    stats.calls++;
+    stats.bytes += bytes;
+    stats.time += time;
+  }
+
+  std::vector<CallStats> Snapshot();
+
+  void Reset() {
+    const std::scoped_lock lock(mutex_);
+    stats_.clear();
+  }
+
+ private:
+  using Key = std::tuple<std::string_view, std::uintptr_t, int>;
+
+  std::mutex mutex_;
+  std::map<Key, CallStats> stats_;
+};
+
+std::string ResolveSite(std::uintptr_t address) {
+  std::ostringstream os;
+  os << std::hex;
+#ifndef _WIN32
+  Dl_info info{};
+  if (dladdr(reinterpret_cast<void *>(address), &info) != 0) {
+    if (info.dli_sname != nullptr) {
+      int status = 0;
+      std::unique_ptr<char, void (*)(void *)> demangled{
+          abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), std::free};
+      os << (status == 0 ? demangled.get() : info.dli_sname) << "+0x"
+         << address - reinterpret_cast<std::uintptr_t>(info.dli_saddr);
+      return os.str();
+    }
+    if (info.dli_fname != nullptr) {
+      os << std::filesystem::path(info.dli_fname).filename().string() << "+0x"
+         << address - reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+      return os.str();
+    }
+  }
+#endif
+  os << "0x" << address;
+  return os.str();
+}
+
+std::vector<CallStats> CallStatsStorage::Snapshot() {
+  std::vector<CallStats> result;
+  {
+    const std::scoped_lock lock(mutex_);
+    result.reserve(stats_.size());
+    for (const auto &[key, stats] : stats_) {
+      auto &entry = result.emplace_back(stats);
+      entry.call = std::string(std::get<0>(key));
+      entry.site = ResolveSite(std::get<1>(key));
+      entry.peer = std::get<2>(key);
+    }
+  }
+  std::ranges::stable_sort(result, [](const CallStats &lhs, const CallStats &rhs) { return lhs.time > rhs.time; });
+  return result;
+}
+
+/// @brief Adds the lifetime of the object to the communication time of the rank
+///        and, if enabled, to the statistics of the call site.
+class ScopedCommTimer {
+ public:
+  ScopedCommTimer(std::string_view call, const void *site, int peer, std::uint64_t bytes)
+      : call_(call), site_(site), peer_(peer), bytes_(bytes), begin_(std::chrono::steady_clock::now()) {}
+  ScopedCommTimer(const ScopedCommTimer &) = delete;
+  ScopedCommTimer &operator=(const ScopedCommTimer &) = delete;
+  ScopedCommTimer(ScopedCommTimer &&) = delete;
+  ScopedCommTimer &operator=(ScopedCommTimer &&) = delete;
+  ~ScopedCommTimer() {
+    const auto end = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(end - begin_).count();
+    CommTimeStorage() += elapsed;
+    CommBytesStorage() += bytes_;
+    if constexpr (kCallStatsEnabled) {
+      CallStatsStorage::Instance().Record(call_, site_, peer_, bytes_, elapsed);
+    }
+    if (ppc::trace::IsEnabled()) {
+      ppc::trace::RecordSpan(call_, "mpi", begin_, end,
+                             {{.key = "peer", .value = peer_},
+                              {.key = "bytes", .value = static_cast<std::int64_t>(bytes_)}});
+    }
+  }
+
+ private:
+  std::string_view call_;
+  const void *site_;
+  int peer_;
+  std::uint64_t bytes_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+// Byte accounting helpers: they return zeros when neither call statistics, tracing nor the communication volume
+// need them, so the plain build only pays for the timer.
+
+bool NeedsCallDetails() {
+  return IsCommBytesEnabled();
+}
+
+std::uint64_t BufferBytes(const void *buffer, int count, MPI_Datatype datatype) {
+  int type_size = 0;
+  if (!NeedsCallDetails() || buffer == MPI_IN_PLACE || count <= 0 ||
+      PMPI_Type_size(datatype, &type_size) != MPI_SUCCESS) {
+    return 0;
+  }
+  return static_cast<std::uint64_t>(count) * static_cast<std::uint64_t>(type_size);
+}
+
+std::uint64_t BufferBytes(const void *buffer, const int counts[], int num_counts, MPI_Datatype datatype) {
+  if (!NeedsCallDetails() || counts == nullptr || num_counts <= 0) {
+    return 0;
+  }
+  const int total = std::accumulate(counts, counts + num_counts, 0);
+  return BufferBytes(buffer, total, datatype);
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  if (NeedsCallDetails()) {
+    PMPI_Comm_size(comm, &size);
+  }
+  return size;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = -1;
+  if (NeedsCallDetails()) {
+    PMPI_Comm_rank(comm, &rank);
+  }
+  return rank == root;
+}
+
+std::string FormatPeer(int peer) {
+  if (peer == kAllPeers) {
+    return "all";
+  }
+  if (peer == kNoPeer) {
+    return "-";
+  }
+  if (peer == MPI_ANY_SOURCE) {
+    return "any";
+  }
+  return std::to_string(peer);
+}
+
+}  // namespace
+
+bool IsAvailable() {
+#ifdef _WIN32
+  return false;
+#else
+  return true;
+#endif
+}
+
+bool IsCallStatsEnabled() {
+  return kCallStatsEnabled;
+}
+
+double GetCommTime() {
+  return CommTimeStorage();
+}
+
+void ResetCommTime() {
+  CommTimeStorage() = 0.0;
+}
+
+std::uint64_t GetCommBytes() {
+  return CommBytesStorage();
+}
+
+void ResetCommBytes() {
+  CommBytesStorage() = 0;
+}
+
+void SetCommBytesEnabled(bool enabled) {
+  CommBytesEnabledStorage() = enabled;
+}
+
+bool IsCommBytesEnabled() {
+  return kCallStatsEnabled || ppc::trace::IsEnabled() || CommBytesEnabledStorage();
+}
+
+std::vector<CallStats> GetCallStats() {
+  return CallStatsStorage::Instance().Snapshot();
+}
+
+void ResetCallStats() {
+  CallStatsStorage::Instance().Reset();
+}
+
+std::string FormatCallStats(int rank, const std::vector<CallStats> &stats) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(10);
+  CallStats total;
+  for (const auto &entry : stats) {
+    os << "rank " << rank << ' ' << entry.call << " peer=" << FormatPeer(entry.peer) << " calls=" << entry.calls
+       << " bytes=" << entry.bytes << " time=" << entry.time << " site=" << entry.site << '\n';
+    total.calls += entry.calls;
+    total.bytes += entry.bytes;
+    total.time += entry.time;
+  }
+  os << "rank " << rank << " total calls=" << total.calls << " bytes=" << total.bytes << " time=" << total.time
+     << '\n';
+  return os.str();
+}
+
+void PrintCallStatsSummary(const std::string &title) {
+  if (!kCallStatsEnabled) {
+    return;
+  }
+  // PMPI entry points keep the summary exchange itself out of the statistics.
+  int rank = 0;
+  int size = 1;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const std::string local = FormatCallStats(rank, GetCallStats());
+  ResetCallStats();
+
+  int length = static_cast<int>(local.size());
+  std::vector<int> lengths(rank == 0 ? size : 0);
+  PMPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  std::vector<int> displs(lengths.size(), 0);
+  std::string summary;
+  if (rank == 0) {
+    std::exclusive_scan(lengths.begin(), lengths.end(), displs.begin(), 0);
+    summary.resize(static_cast<std::size_t>(displs.back() + lengths.back()));
+  }
+  PMPI_Gatherv(local.data(), length, MPI_CHAR, summary.data(), lengths.data(), displs.data(), MPI_CHAR, 0,
+               MPI_COMM_WORLD);
+  if (rank == 0) {
+    std::cout << "[ MPI PROFILE ] " << title << '\n' << summary << std::flush;
+  }
+}
+
+}  // namespace ppc::mpi_profiler
+
+#ifndef _WIN32
+
+// PMPI interposition: these definitions take precedence over the MPI library symbols
+// and forward to the PMPI_ entry points while timing the call.
+// The return address identifies the call site in the task code.
+// They are built regardless of USE_MPI_PROFILER: the per-rank communication time of every perf run and the MPI
+// spans of PPC_TRACE come from them. The option only adds the per call site bookkeeping; without it a call costs
+// two clock reads.
+// NOLINTBEGIN(readability-identifier-naming,readability-inconsistent-declaration-parameter-name)
+extern "C" {
+
+using ppc::mpi_profiler::BufferBytes;
+using ppc::mpi_profiler::CommSize;
+using ppc::mpi_profiler::IsRoot;
+using ppc::mpi_profiler::kAllPeers;
+using ppc::mpi_profiler::kNoPeer;
+using ppc::mpi_profiler::ScopedCommTimer;
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  const ScopedCommTimer timer("MPI_Send", __builtin_return_address(0), dest, BufferBytes(buf, count, datatype));
+  return PMPI_Send(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  const ScopedCommTimer timer("MPI_Recv", __builtin_return_address(0), source, BufferBytes(buf, count, datatype));
+  return PMPI_Recv(buf, count, datatype, source, tag, comm, status);
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  const ScopedCommTimer timer("MPI_Sendrecv", __builtin_return_address(0), dest,
+                              BufferBytes(sendbuf, sendcount, sendtype) + BufferBytes(recvbuf, recvcount, recvtype));
+  return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                       comm, status);
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  const ScopedCommTimer timer("MPI_Isend", __builtin_return_address(0), dest, BufferBytes(buf, count, datatype));
+  return PMPI_Isend(buf, count, datatype, dest, tag, comm, request);
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request *request) {
+  const ScopedCommTimer timer("MPI_Irecv", __builtin_return_address(0), source, BufferBytes(buf, count, datatype));
+  return PMPI_Irecv(buf, count, datatype, source, tag, comm, request);
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  const ScopedCommTimer timer("MPI_Wait", __builtin_return_address(0), kNoPeer, 0);
+  return PMPI_Wait(request, status);
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]) {
+  const ScopedCommTimer timer("MPI_Waitall", __builtin_return_address(0), kNoPeer, 0);
+  return PMPI_Waitall(count, array_of_requests, array_of_statuses);
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  const ScopedCommTimer timer("MPI_Probe", __builtin_return_address(0), source, 0);
+  return PMPI_Probe(source, tag, comm, status);
+}
+
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status) {
+  const ScopedCommTimer timer("MPI_Iprobe", __builtin_return_address(0), source, 0);
+  return PMPI_Iprobe(source, tag, comm, flag, status);
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  const ScopedCommTimer timer("MPI_Barrier", __builtin_return_address(0), kAllPeers, 0);
+  return PMPI_Barrier(comm);
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  const ScopedCommTimer timer("MPI_Bcast", __builtin_return_address(0), root, BufferBytes(buffer, count, datatype));
+  return PMPI_Bcast(buffer, count, datatype, root, comm);
+}
+
+int MPI_Ibcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Request *request) {
+  const ScopedCommTimer timer("MPI_Ibcast", __builtin_return_address(0), root, BufferBytes(buffer, count, datatype));
+  return PMPI_Ibcast(buffer, count, datatype, root, comm, request);
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const auto send_bytes = IsRoot(root, comm) ? BufferBytes(sendbuf, sendcount, sendtype) * CommSize(comm) : 0;
+  const ScopedCommTimer timer("MPI_Scatter", __builtin_return_address(0), root,
+                              send_bytes + BufferBytes(recvbuf, recvcount, recvtype));
+  return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const auto send_bytes = IsRoot(root, comm) ? BufferBytes(sendbuf, sendcounts, CommSize(comm), sendtype) : 0;
+  const ScopedCommTimer timer("MPI_Scatterv", __builtin_return_address(0), root,
+                              send_bytes + BufferBytes(recvbuf, recvcount, recvtype));
+  return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const auto recv_bytes = IsRoot(root, comm) ? BufferBytes(recvbuf, recvcount, recvtype) * CommSize(comm) : 0;
+  const ScopedCommTimer timer("MPI_Gather", __builtin_return_address(0), root,
+                              BufferBytes(sendbuf, sendcount, sendtype) + recv_bytes);
+  return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const auto recv_bytes = IsRoot(root, comm) ? BufferBytes(recvbuf, recvcounts, CommSize(comm), recvtype) : 0;
+  const ScopedCommTimer timer("MPI_Gatherv", __builtin_return_address(0), root,
+                              BufferBytes(sendbuf, sendcount, sendtype) + recv_bytes);
+  return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+}
+
+int MPI_Igatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                 const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  const auto recv_bytes = IsRoot(root, comm) ? BufferBytes(recvbuf, recvcounts, CommSize(comm), recvtype) : 0;
+  const ScopedCommTimer timer("MPI_Igatherv", __builtin_return_address(0), root,
+                              BufferBytes(sendbuf, sendcount, sendtype) + recv_bytes);
+  return PMPI_Igatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm, request);
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCommTimer timer(
+      "MPI_Allgather", __builtin_return_address(0), kAllPeers,
+      BufferBytes(sendbuf, sendcount, sendtype) + (BufferBytes(recvbuf, recvcount, recvtype) * CommSize(comm)));
+  return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCommTimer timer(
+      "MPI_Allgatherv", __builtin_return_address(0), kAllPeers,
+      BufferBytes(sendbuf, sendcount, sendtype) + BufferBytes(recvbuf, recvcounts, CommSize(comm), recvtype));
+  return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  const auto recv_bytes = IsRoot(root, comm) ? BufferBytes(recvbuf, count, datatype) : 0;
+  const ScopedCommTimer timer("MPI_Reduce", __builtin_return_address(0), root,
+                              BufferBytes(sendbuf, count, datatype) + recv_bytes);
+  return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const ScopedCommTimer timer("MPI_Allreduce", __builtin_return_address(0), kAllPeers,
+                              BufferBytes(sendbuf, count, datatype) + BufferBytes(recvbuf, count, datatype));
+  return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const ScopedCommTimer timer("MPI_Scan", __builtin_return_address(0), kAllPeers,
+                              BufferBytes(sendbuf, count, datatype) + BufferBytes(recvbuf, count, datatype));
+  return PMPI_Scan(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCommTimer timer(
+      "MPI_Alltoall", __builtin_return_address(0), kAllPeers,
+      (BufferBytes(sendbuf, sendcount, sendtype) + BufferBytes(recvbuf, recvcount, recvtype)) * CommSize(comm));
+  return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const int size = CommSize(comm);
+  const ScopedCommTimer timer(
+      "MPI_Alltoallv", __builtin_return_address(0), kAllPeers,
+      BufferBytes(sendbuf, sendcounts, size, sendtype) + BufferBytes(recvbuf, recvcounts, size, recvtype));
+  return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+}
+
+int MPI_Win_fence(int assert, MPI_Win win) {
+  const ScopedCommTimer timer("MPI_Win_fence", __builtin_return_address(0), kAllPeers, 0);
+  return PMPI_Win_fence(assert, win);
+}
+
+}  // extern "C"
+// NOLINTEND(readability-identifier-naming,readability-inconsistent-declaration-parameter-name)
+
+#endif  // _WIN32
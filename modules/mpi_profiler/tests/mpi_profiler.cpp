@@ -0,0 +1,52 @@
+#include "mpi_profiler/include/mpi_profiler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "trace/include/trace.hpp"
+
+namespace ppc::mpi_profiler {
+
+TEST(MpiProfilerTest, ResetCommTimeClearsCounter) {
+  ResetCommTime();
+  EXPECT_DOUBLE_EQ(GetCommTime(), 0.0);
+}
+
+TEST(MpiProfilerTest, ResetCommBytesClearsCounter) {
+  ResetCommBytes();
+  EXPECT_EQ(GetCommBytes(), 0U);
+}
+
+TEST(MpiProfilerTest, CommBytesCanBeEnabled) {
+  SetCommBytesEnabled(true);
+  EXPECT_TRUE(IsCommBytesEnabled());
+  SetCommBytesEnabled(false);
+  EXPECT_EQ(IsCommBytesEnabled(), IsCallStatsEnabled() || ppc::trace::IsEnabled());
+}
+
+TEST(MpiProfilerTest, CallStatsAreEmptyAfterReset) {
+  ResetCallStats();
+  EXPECT_TRUE(GetCallStats().empty());
+}
+
+TEST(MpiProfilerTest, FormatCallStatsPrintsEntriesAndTotal) {
+  const std::vector<CallStats> stats = {
+      {.call = "MPI_Bcast", .site = "Run()+0x10", .peer = 0, .calls = 2, .bytes = 800, .time = 0.5},
+      {.call = "MPI_Allreduce", .site = "Run()+0x20", .peer = kAllPeers, .calls = 1, .bytes = 16, .time = 0.25},
+      {.call = "MPI_Waitall", .site = "Run()+0x30", .peer = kNoPeer, .calls = 3, .bytes = 0, .time = 0.0},
+  };
+  const std::string text = FormatCallStats(1, stats);
+  EXPECT_NE(text.find("rank 1 MPI_Bcast peer=0 calls=2 bytes=800 time=0.5000000000 site=Run()+0x10\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("rank 1 MPI_Allreduce peer=all calls=1"), std::string::npos);
+  EXPECT_NE(text.find("rank 1 MPI_Waitall peer=- calls=3"), std::string::npos);
+  EXPECT_NE(text.find("rank 1 total calls=6 bytes=816 time=0.7500000000\n"), std::string::npos);
+}
+
+TEST(MpiProfilerTest, FormatCallStatsPrintsTotalForEmptyStats) {
+  EXPECT_EQ(FormatCallStats(0, {}), "rank 0 total calls=0 bytes=0 time=0.0000000000\n");
+}
+
+}  // namespace ppc::mpi_profiler
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Hardware events collected around the measured iterations.
+enum class HwEvent : uint8_t {
+  kCycles,
+  kInstructions,
+  kCacheReferences,
+  kCacheMisses,
+  kBranches,
+  kBranchMisses,
+  kLlcLoads,
+  kLlcLoadMisses,
+};
+
+inline constexpr std::size_t kNumHwEvents = 8;
+
+/// @brief Returns the snake_case name used for the event in reports ("cache_misses", ...).
+std::string_view GetHwEventName(HwEvent event);
+
+/// @brief Hardware counter values; events the machine or the kernel does not provide stay empty.
+struct HwCounterResults {
+  std::array<std::optional<double>, kNumHwEvents> values{};
+
+  [[nodiscard]] std::optional<double> Get(HwEvent event) const {
+    return values[static_cast<std::size_t>(event)];
+  }
+  /// @brief Returns true if at least one event was counted.
+  [[nodiscard]] bool HasValues() const {
+    for (const auto &value : values) {
+      if (value.has_value()) {
+        return true;
+      }
+    }
+    return false;
+  }
+  /// @brief Instructions per cycle, if both events were counted.
+  [[nodiscard]] std::optional<double> GetIpc() const {
+    const auto cycles = Get(HwEvent::kCycles);
+    const auto instructions = Get(HwEvent::kInstructions);
+    if (!cycles.has_value() || !instructions.has_value() || *cycles <= 0.0) {
+      return std::nullopt;
+    }
+    return *instructions / *cycles;
+  }
+  /// @brief Returns the events counted between two readings; events missing from either one stay empty.
+  [[nodiscard]] HwCounterResults Since(const HwCounterResults &begin) const {
+    HwCounterResults delta;
+    for (std::size_t i = 0; i < kNumHwEvents; i++) {
+      if (values[i].has_value() && begin.values[i].has_value()) {
+        delta.values[i] = *values[i] - *begin.values[i];
+      }
+    }
+    return delta;
+  }
+};
+
+/// @brief Counts hardware events of the calling process with Linux perf_event_open.
+/// @details Every event is opened separately, so unsupported events (e.g. LLC events in virtual machines)
+///          do not disable the others, and values are scaled when the kernel multiplexes counters.
+///          User-space events of all threads of the process are counted: every thread that exists when the
+///          counters are created (including idle OpenMP and TBB workers) gets its own descriptor, and threads
+///          created afterwards are followed through inheritance. An event that cannot be opened for one of the
+///          threads (e.g. when descriptors run out) is left empty rather than under-reported.
+///          On other platforms, or when perf events are not permitted, no event is available
+///          and Stop() returns empty results.
+class HwCounters {
+ public:
+  HwCounters();
+  HwCounters(const HwCounters &) = delete;
+  HwCounters &operator=(const HwCounters &) = delete;
+  HwCounters(HwCounters &&) = delete;
+  HwCounters &operator=(HwCounters &&) = delete;
+  ~HwCounters();
+
+  /// @brief Returns true if at least one event could be opened.
+  [[nodiscard]] bool IsAvailable() const;
+  /// @brief Resets and enables all opened events.
+  void Start();
+  /// @brief Returns the values since Start() without disabling the events.
+  [[nodiscard]] HwCounterResults Read() const;
+  /// @brief Disables the events and returns their values since Start().
+  HwCounterResults Stop();
+
+ private:
+  /// @brief Descriptors of every event, one per counted thread.
+  std::array<std::vector<int>, kNumHwEvents> fds_;
+};
+
+}  // namespace ppc::performance
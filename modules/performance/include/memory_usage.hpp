@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::performance {
+
+/// @brief Number and total size of heap allocations made through operator new.
+struct AllocationStats {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+/// @brief Returns the peak resident set size of the process in bytes, 0 if it cannot be determined.
+std::size_t GetPeakRss();
+
+/// @brief Returns the current resident set size of the process in bytes, 0 if it cannot be determined.
+std::size_t GetCurrentRss();
+
+/// @brief Resets the peak resident set size to the current one, so GetPeakRss() covers only what follows.
+/// @return False if the platform does not support resetting (the peak then covers the process lifetime).
+bool ResetPeakRss();
+
+/// @brief Returns true if the global operator new is replaced to count allocations
+///        (CMake option USE_ALLOC_TRACKING).
+bool IsAllocationTrackingEnabled();
+
+/// @brief Returns the allocations counted since the start of the process (zeros if tracking is disabled).
+AllocationStats GetAllocationStats();
+
+}  // namespace ppc::performance
@@ -1,14 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_usage.hpp"
+#include "performance/include/roofline.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
@@ -21,20 +29,179 @@ inline double DefaultTimer() {
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Number of untimed iterations executed before the measurement starts.
+  uint64_t num_warmup = 0;
+  /// @brief Time every iteration separately and compute order statistics over the samples.
+  bool collect_samples = false;
+  /// @brief Coefficient of variation the samples have to reach; 0 disables the stability check.
+  /// @details While the check fails, more iterations are measured and the statistics are
+  ///          computed over the last num_running samples.
+  double max_cv = 0.0;
+  /// @brief Upper bound on measured iterations while re-running for a stable result.
+  uint64_t max_num_running = 100;
+  /// @brief Optional function combining the coefficient of variation of this process with those of the others.
+  /// @details The stability check uses its result, so it has to be the same on every process: processes that run
+  ///          collectives must measure the same number of iterations. MPI tasks take the maximum over the ranks.
+  /// @cond
+  std::function<double(double)> combine_cv;
+  /// @endcond
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
+  /// @brief Optional function returning the cumulative time in seconds spent inside communication calls.
+  /// @cond
+  std::function<double()> comm_timer;
+  /// @endcond
+  /// @brief Optional function returning the cumulative bytes passed to communication calls.
+  /// @cond
+  std::function<double()> comm_bytes_counter;
+  /// @endcond
+  /// @brief Count hardware events (cycles, cache and branch misses, ...) during the measured iterations.
+  bool collect_hw_counters = false;
+  /// @brief Record the peak resident set size and, if tracking is compiled in, heap allocations.
+  bool collect_memory = false;
+};
+
+/// @brief Order statistics over per-iteration samples.
+struct PerfStatistics {
+  double min = 0.0;
+  double median = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double mean = 0.0;
+  double stddev = 0.0;
+  /// @brief Coefficient of variation (stddev / mean).
+  double cv = 0.0;
+  /// @brief False if PerfAttr::max_cv was not reached within PerfAttr::max_num_running iterations.
+  bool stable = true;
 };
 
+/// @brief Returns the percentile of sorted samples using linear interpolation between closest ranks.
+/// @param sorted Samples in ascending order.
+/// @param percentile Percentile in the range [0, 100].
+inline double GetPercentile(const std::vector<double> &sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double pos = (percentile / 100.0) * static_cast<double>(sorted.size() - 1);
+  const auto lower = static_cast<std::size_t>(pos);
+  const auto upper = std::min(lower + 1, sorted.size() - 1);
+  const double frac = pos - static_cast<double>(lower);
+  return sorted[lower] + ((sorted[upper] - sorted[lower]) * frac);
+}
+
+/// @brief Computes min/median/p90/p99/mean/stddev/cv of the given samples.
+inline PerfStatistics ComputeStatistics(std::vector<double> samples) {
+  PerfStatistics stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::ranges::sort(samples);
+  const auto count = static_cast<double>(samples.size());
+  stats.min = samples.front();
+  stats.median = GetPercentile(samples, 50.0);
+  stats.p90 = GetPercentile(samples, 90.0);
+  stats.p99 = GetPercentile(samples, 99.0);
+  stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+  double sq_sum = 0.0;
+  for (double sample : samples) {
+    sq_sum += (sample - stats.mean) * (sample - stats.mean);
+  }
+  stats.stddev = samples.size() > 1 ? std::sqrt(sq_sum / (count - 1.0)) : 0.0;
+  stats.cv = stats.mean > 0.0 ? stats.stddev / stats.mean : 0.0;
+  return stats;
+}
+
 struct PerfResults {
   /// @brief Measured execution time in seconds.
   double time_sec = 0.0;
+  /// @brief Per-iteration durations in seconds, filled when PerfAttr::collect_samples is set.
+  std::vector<double> samples;
+  /// @brief Statistics over samples; time_sec equals statistics.mean in this mode.
+  PerfStatistics statistics;
+  /// @brief Mean time in seconds per iteration spent in communication, measured by PerfAttr::comm_timer.
+  double comm_time_sec = 0.0;
+  /// @brief Mean bytes per iteration passed to communication calls, measured by PerfAttr::comm_bytes_counter.
+  double comm_bytes = 0.0;
+  /// @brief Mean time in seconds per iteration spent in each pipeline stage of the task.
+  /// @details Only the run stage is measured in TaskRun mode.
+  ppc::task::StageTimes stage_times;
+  /// @brief Hardware events per iteration, filled when PerfAttr::collect_hw_counters is set and supported.
+  HwCounterResults hw_counters;
+  /// @brief Peak resident set size of this rank in bytes, filled when PerfAttr::collect_memory is set.
+  /// @details Covers only the measured iterations where the peak can be reset (Linux), otherwise
+  ///          the whole process lifetime.
+  std::size_t peak_rss_bytes = 0;
+  /// @brief Heap allocations per iteration on this rank (USE_ALLOC_TRACKING builds only).
+  double alloc_count = 0.0;
+  double alloc_bytes = 0.0;
   enum class TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone };
   TypeOfRunning type_of_running = TypeOfRunning::kNone;
   constexpr static double kMaxTime = 10.0;
 };
 
+/// @brief Distribution of per-rank times of one perf case.
+struct PerfRankSummary {
+  double max_time = 0.0;
+  double min_time = 0.0;
+  double mean_time = 0.0;
+  /// @brief Slowest rank time divided by the mean time; 1.0 means perfectly balanced ranks.
+  double imbalance = 1.0;
+  /// @brief Mean over ranks of the time spent outside communication calls.
+  double mean_compute_time = 0.0;
+  double mean_comm_time = 0.0;
+  double max_comm_time = 0.0;
+  /// @brief Mean and largest communication volume per iteration of a rank, in bytes.
+  double mean_comm_bytes = 0.0;
+  double max_comm_bytes = 0.0;
+};
+
+/// @brief Summarizes per-rank iteration times and the communication part of them.
+/// @param times Mean iteration time of every rank.
+/// @param comm_times Mean communication time per iteration of every rank (may be empty).
+/// @param comm_bytes Mean communication volume per iteration of every rank (may be empty).
+inline PerfRankSummary SummarizeRanks(const std::vector<double> &times, const std::vector<double> &comm_times,
+                                      const std::vector<double> &comm_bytes = {}) {
+  PerfRankSummary summary;
+  if (times.empty()) {
+    return summary;
+  }
+  const auto count = static_cast<double>(times.size());
+  summary.max_time = *std::ranges::max_element(times);
+  summary.min_time = *std::ranges::min_element(times);
+  summary.mean_time = std::accumulate(times.begin(), times.end(), 0.0) / count;
+  summary.imbalance = summary.mean_time > 0.0 ? summary.max_time / summary.mean_time : 1.0;
+  if (comm_times.size() == times.size()) {
+    summary.max_comm_time = *std::ranges::max_element(comm_times);
+    summary.mean_comm_time = std::accumulate(comm_times.begin(), comm_times.end(), 0.0) / count;
+  }
+  if (comm_bytes.size() == times.size()) {
+    summary.max_comm_bytes = *std::ranges::max_element(comm_bytes);
+    summary.mean_comm_bytes = std::accumulate(comm_bytes.begin(), comm_bytes.end(), 0.0) / count;
+  }
+  summary.mean_compute_time = summary.mean_time - summary.mean_comm_time;
+  return summary;
+}
+
+/// @brief Peak memory of one perf case over all ranks.
+struct PerfRankMemory {
+  double max_peak_rss = 0.0;
+  /// @brief Sum of the rank peaks: an upper bound for the memory needed when all ranks share a node.
+  double total_peak_rss = 0.0;
+};
+
+/// @brief Summarizes the peak resident set sizes of all ranks.
+inline PerfRankMemory SummarizeRankMemory(const std::vector<double> &peak_rss) {
+  PerfRankMemory memory;
+  if (peak_rss.empty()) {
+    return memory;
+  }
+  memory.max_peak_rss = *std::ranges::max_element(peak_rss);
+  memory.total_peak_rss = std::accumulate(peak_rss.begin(), peak_rss.end(), 0.0);
+  return memory;
+}
+
 template <typename InType, typename OutType>
 class Perf {
  public:
@@ -87,6 +254,10 @@ class Perf {
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSamplesStatistic(test_id, type_test_name);
+      PrintStageTimes(test_id, type_test_name);
+      PrintHwCounters(test_id, type_test_name);
+      PrintMemoryUsage(test_id, type_test_name);
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -106,13 +277,162 @@ class Perf {
  private:
   PerfResults perf_results_;
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
-    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+  /// @brief Cumulative counters read before and after the measured iterations.
+  struct CounterSnapshot {
+    ppc::task::StageTimes stages;
+    double comm_time = 0.0;
+    double comm_bytes = 0.0;
+    AllocationStats allocs;
+    HwCounterResults hw;
+  };
+  CounterSnapshot TakeSnapshot(const PerfAttr &perf_attr, const HwCounters *hw_counters) const {
+    return CounterSnapshot{.stages = task_->GetStageTimes(),
+                           .comm_time = perf_attr.comm_timer ? perf_attr.comm_timer() : 0.0,
+                           .comm_bytes = perf_attr.comm_bytes_counter ? perf_attr.comm_bytes_counter() : 0.0,
+                           .allocs = GetAllocationStats(),
+                           .hw = hw_counters != nullptr ? hw_counters->Read() : HwCounterResults{}};
+  }
+  void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
       pipeline();
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    if (perf_attr.collect_memory) {
+      ResetPeakRss();
+    }
+    std::unique_ptr<HwCounters> hw_counters;
+    if (perf_attr.collect_hw_counters) {
+      hw_counters = std::make_unique<HwCounters>();
+      hw_counters->Start();
+    }
+    // Per-iteration metrics cover the same iterations as time_sec: with re-runs for stability only the
+    // last window of samples is kept, so a snapshot is taken before every measured iteration
+    std::vector<CounterSnapshot> begins;
+    uint64_t iterations = perf_attr.num_running;
+    if (perf_attr.collect_samples) {
+      iterations = SampledRun(perf_attr, pipeline, [&] { begins.push_back(TakeSnapshot(perf_attr, hw_counters.get())); },
+                              perf_results);
+    } else {
+      begins.push_back(TakeSnapshot(perf_attr, hw_counters.get()));
+      auto begin = perf_attr.current_timer();
+      for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+        pipeline();
+      }
+      auto end = perf_attr.current_timer();
+      perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    }
+    const auto end = TakeSnapshot(perf_attr, hw_counters.get());
+    const auto &begin = perf_attr.collect_samples ? begins[begins.size() - iterations] : begins.front();
+    const auto count = static_cast<double>(iterations);
+    if (perf_attr.comm_timer) {
+      perf_results.comm_time_sec = (end.comm_time - begin.comm_time) / count;
+    }
+    if (perf_attr.comm_bytes_counter) {
+      perf_results.comm_bytes = (end.comm_bytes - begin.comm_bytes) / count;
+    }
+    perf_results.stage_times = {.validation = (end.stages.validation - begin.stages.validation) / count,
+                                .pre_processing = (end.stages.pre_processing - begin.stages.pre_processing) / count,
+                                .run = (end.stages.run - begin.stages.run) / count,
+                                .post_processing = (end.stages.post_processing - begin.stages.post_processing) / count};
+    if (hw_counters) {
+      hw_counters->Stop();
+      perf_results.hw_counters = end.hw.Since(begin.hw);
+      for (auto &value : perf_results.hw_counters.values) {
+        if (value.has_value()) {
+          *value /= count;
+        }
+      }
+    }
+    if (perf_attr.collect_memory) {
+      perf_results.peak_rss_bytes = GetPeakRss();
+      perf_results.alloc_count = static_cast<double>(end.allocs.count - begin.allocs.count) / count;
+      perf_results.alloc_bytes = static_cast<double>(end.allocs.bytes - begin.allocs.bytes) / count;
+    }
+  }
+  /// @param before_iteration Called before every measured iteration, outside the timed region.
+  /// @return Number of iterations the statistics are computed over: the last ones measured.
+  static uint64_t SampledRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline,
+                             const std::function<void()> &before_iteration, PerfResults &perf_results) {
+    const auto window = static_cast<std::size_t>(std::max<uint64_t>(perf_attr.num_running, 1));
+    const auto limit = std::max<uint64_t>(perf_attr.max_num_running, window);
+    std::vector<double> all_samples;
+    auto measure_once = [&] {
+      before_iteration();
+      auto begin = perf_attr.current_timer();
+      pipeline();
+      auto end = perf_attr.current_timer();
+      all_samples.push_back(end - begin);
+    };
+    for (std::size_t i = 0; i < window; i++) {
+      measure_once();
+    }
+    const bool check_cv = perf_attr.max_cv > 0.0;
+    auto agreed_cv = [&perf_attr](const PerfStatistics &stats) {
+      return perf_attr.combine_cv ? perf_attr.combine_cv(stats.cv) : stats.cv;
+    };
+    auto stats = ComputeStatistics(all_samples);
+    double cv = check_cv ? agreed_cv(stats) : stats.cv;
+    while (check_cv && cv > perf_attr.max_cv && all_samples.size() < limit) {
+      measure_once();
+      stats = ComputeStatistics(
+          std::vector<double>(all_samples.end() - static_cast<std::ptrdiff_t>(window), all_samples.end()));
+      cv = agreed_cv(stats);
+    }
+    stats.stable = !check_cv || cv <= perf_attr.max_cv;
+    perf_results.samples.assign(all_samples.end() - static_cast<std::ptrdiff_t>(window), all_samples.end());
+    perf_results.statistics = stats;
+    perf_results.time_sec = stats.mean;
+    return window;
+  }
+  void PrintSamplesStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.samples.empty()) {
+      return;
+    }
+    const auto &stats = perf_results_.statistics;
+    std::stringstream stats_str;
+    stats_str << std::fixed << std::setprecision(10) << "min=" << stats.min << " median=" << stats.median
+              << " p90=" << stats.p90 << " p99=" << stats.p99 << " stddev=" << stats.stddev << " cv=" << stats.cv
+              << " n=" << perf_results_.samples.size() << " stable=" << (stats.stable ? 1 : 0);
+    std::cout << test_id << ":" << type_test_name << "_stats:" << stats_str.str() << '\n';
+  }
+  void PrintStageTimes(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.type_of_running != PerfResults::TypeOfRunning::kPipeline) {
+      return;
+    }
+    const auto &stages = perf_results_.stage_times;
+    std::stringstream stages_str;
+    stages_str << std::fixed << std::setprecision(10) << "validation=" << stages.validation
+               << " pre_processing=" << stages.pre_processing << " run=" << stages.run
+               << " post_processing=" << stages.post_processing
+               << " overhead=" << (perf_results_.time_sec - stages.Total());
+    std::cout << test_id << ":" << type_test_name << "_stages:" << stages_str.str() << '\n';
+  }
+  void PrintHwCounters(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &counters = perf_results_.hw_counters;
+    if (!counters.HasValues()) {
+      return;
+    }
+    std::stringstream counters_str;
+    counters_str << std::fixed << std::setprecision(1);
+    for (std::size_t i = 0; i < kNumHwEvents; i++) {
+      if (counters.values[i].has_value()) {
+        counters_str << GetHwEventName(static_cast<HwEvent>(i)) << "=" << *counters.values[i] << " ";
+      }
+    }
+    const auto ipc = counters.GetIpc();
+    counters_str << std::setprecision(4) << "ipc=" << (ipc.has_value() ? *ipc : 0.0);
+    std::cout << test_id << ":" << type_test_name << "_hw:" << counters_str.str() << '\n';
+  }
+  void PrintMemoryUsage(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.peak_rss_bytes == 0) {
+      return;
+    }
+    std::stringstream memory_str;
+    memory_str << "peak_rss=" << perf_results_.peak_rss_bytes;
+    if (IsAllocationTrackingEnabled()) {
+      memory_str << std::fixed << std::setprecision(1) << " allocs=" << perf_results_.alloc_count
+                 << " alloc_bytes=" << perf_results_.alloc_bytes;
+    }
+    std::cout << test_id << ":" << type_test_name << "_memory:" << memory_str.str() << '\n';
   }
 };
 
@@ -126,4 +446,42 @@ inline std::string GetStringParamName(PerfResults::TypeOfRunning type_of_running
   return "none";
 }
 
+/// @brief Prints the per-rank summary line (test_id:type_ranks:...) for automation checkers.
+inline void PrintRankSummary(const std::string &test_id, PerfResults::TypeOfRunning type_of_running,
+                             const PerfRankSummary &summary) {
+  std::stringstream summary_str;
+  summary_str << std::fixed << std::setprecision(10) << "max=" << summary.max_time << " min=" << summary.min_time
+              << " mean=" << summary.mean_time << " imbalance=" << summary.imbalance
+              << " compute_mean=" << summary.mean_compute_time << " comm_mean=" << summary.mean_comm_time
+              << " comm_max=" << summary.max_comm_time << std::setprecision(0)
+              << " comm_bytes_mean=" << summary.mean_comm_bytes << " comm_bytes_max=" << summary.max_comm_bytes;
+  std::cout << test_id << ":" << GetStringParamName(type_of_running) << "_ranks:" << summary_str.str() << '\n';
+}
+
+/// @brief Prints the per-rank memory line (test_id:type_memory_ranks:...) for automation checkers.
+inline void PrintRankMemory(const std::string &test_id, PerfResults::TypeOfRunning type_of_running,
+                            const std::vector<double> &peak_rss) {
+  const auto memory = SummarizeRankMemory(peak_rss);
+  std::stringstream memory_str;
+  memory_str << std::fixed << std::setprecision(0) << "max_peak_rss=" << memory.max_peak_rss
+             << " total_peak_rss=" << memory.total_peak_rss << " ranks=";
+  for (std::size_t i = 0; i < peak_rss.size(); i++) {
+    memory_str << (i == 0 ? "" : ";") << peak_rss[i];
+  }
+  std::cout << test_id << ":" << GetStringParamName(type_of_running) << "_memory_ranks:" << memory_str.str() << '\n';
+}
+
+/// @brief Prints the throughput and roofline line (test_id:type_roofline:...) for automation checkers.
+inline void PrintRoofline(const std::string &test_id, PerfResults::TypeOfRunning type_of_running,
+                          const RooflineResult &roofline, const MachinePeaks &peaks) {
+  std::stringstream roofline_str;
+  roofline_str << std::fixed << std::setprecision(3) << "gb_per_sec=" << roofline.bytes_per_sec * 1e-9
+               << " gflop_per_sec=" << roofline.flops_per_sec * 1e-9 << " elements_per_sec=" << std::setprecision(0)
+               << roofline.elements_per_sec << std::setprecision(3) << " intensity=" << roofline.intensity
+               << " bound=" << roofline.bound << " peak_gb_per_sec=" << peaks.bytes_per_sec * 1e-9
+               << " peak_gflop_per_sec=" << peaks.flops_per_sec * 1e-9 << std::setprecision(1)
+               << " roofline=" << roofline.fraction * 100.0 << "%";
+  std::cout << test_id << ":" << GetStringParamName(type_of_running) << "_roofline:" << roofline_str.str() << '\n';
+}
+
 }  // namespace ppc::performance
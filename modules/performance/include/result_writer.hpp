@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "performance/include/roofline.hpp"
+
+namespace ppc::performance {
+
+/// @brief Version of the record layout, written as "schema_version" of every JSON record. Bump it when a released
+/// layout changes: a field is removed or renamed, or changes meaning.
+constexpr int kPerfRecordSchemaVersion = 1;
+
+/// @brief One performance measurement as stored by the structured result sink.
+struct PerfRecord {
+  /// @brief Full gtest parameter name of the perf case.
+  std::string test_name;
+  /// @brief Namespace of the task implementation.
+  std::string task_namespace;
+  /// @brief Parallel technology of the task ("mpi", "omp", "seq", ...).
+  std::string technology;
+  /// @brief Type of running ("pipeline" or "task_run").
+  std::string mode;
+  int num_proc = 1;
+  int num_threads = 1;
+  /// @brief Number of elements in the input, 0 if it cannot be deduced.
+  std::size_t input_size = 0;
+  /// @brief Problem size of a size-parameterized perf case, 0 otherwise.
+  std::size_t problem_size = 0;
+  /// @brief Bytes held by the input.
+  std::size_t input_bytes = 0;
+  /// @brief Input bytes moved into the task instead of being copied.
+  std::size_t input_saved_bytes = 0;
+  /// @brief Results measured on the writing rank.
+  PerfResults results;
+  /// @brief Mean iteration time of every MPI rank, indexed by rank.
+  std::vector<double> rank_times;
+  /// @brief Mean communication time per iteration of every MPI rank, indexed by rank.
+  std::vector<double> rank_comm_times;
+  /// @brief Mean communication volume in bytes per iteration of every MPI rank, indexed by rank.
+  std::vector<double> rank_comm_bytes;
+  /// @brief Peak resident set size in bytes of every MPI rank, indexed by rank (empty if not collected).
+  std::vector<double> rank_peak_rss;
+  /// @brief Bind policy of the run (PPC_BIND).
+  std::string bind = "none";
+  /// @brief NUMA policy of the run (PPC_NUMA).
+  std::string numa = "none";
+  /// @brief Number of NUMA nodes of the host.
+  int numa_nodes = 1;
+  /// @brief CPU list (e.g. "0-3") every MPI rank was bound to, indexed by rank; empty strings if not bound.
+  std::vector<std::string> rank_cpus;
+  /// @brief Work declared by the perf test; empty if it declares none (no throughput is written then).
+  Workload workload;
+  /// @brief Peaks of the resources the task ran on.
+  MachinePeaks peaks;
+  /// @brief Achieved rates and roofline position of results.time_sec.
+  RooflineResult roofline;
+};
+
+/// @brief Host information attached to every record.
+struct HostInfo {
+  std::string hostname;
+  unsigned int hardware_threads = 0;
+  std::string os;
+  std::string compiler;
+};
+
+/// @brief Collects information about the machine the tests run on.
+HostInfo GetHostInfo();
+
+/// @brief Serializes a record into a single-line JSON object.
+std::string PerfRecordToJson(const PerfRecord &record, const HostInfo &host);
+
+/// @brief Returns the CSV header matching PerfRecordToCsv.
+std::string GetPerfRecordCsvHeader();
+
+/// @brief Serializes a record into a single CSV row (samples and rank times are ';'-separated).
+std::string PerfRecordToCsv(const PerfRecord &record, const HostInfo &host);
+
+/// @brief Appends a record to the file at path.
+/// @details Files with the ".csv" extension get CSV rows (the header is written to an empty file),
+///          any other path gets one JSON object per line.
+/// @throws std::runtime_error If the file cannot be opened, or if it is a CSV file whose header differs from
+///         GetPerfRecordCsvHeader() (it was written by another version; rows would not line up with its columns).
+void AppendPerfRecord(const PerfRecord &record, const std::string &path);
+
+}  // namespace ppc::performance
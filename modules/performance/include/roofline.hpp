@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string_view>
+
+namespace ppc::performance {
+
+/// @brief Work done by one run of a task, as declared by its perf test (BaseRunPerfTests::GetWorkload).
+struct Workload {
+  /// @brief Bytes the algorithm has to move to and from memory, e.g. 4 * n for a max search over n ints.
+  double bytes = 0.0;
+  /// @brief Floating-point operations, e.g. 2 * n^3 for a dense n x n matrix product.
+  double flops = 0.0;
+  /// @brief Elements processed, for an elements/s rate.
+  double elements = 0.0;
+
+  [[nodiscard]] bool IsEmpty() const {
+    return bytes <= 0.0 && flops <= 0.0 && elements <= 0.0;
+  }
+};
+
+/// @brief Sustained memory bandwidth and arithmetic throughput of the resources a task runs on.
+struct MachinePeaks {
+  double bytes_per_sec = 0.0;
+  double flops_per_sec = 0.0;
+};
+
+/// @brief Measures the peaks of this process with num_threads OpenMP threads.
+/// @details Bandwidth is the best of several STREAM triad passes (a[i] = b[i] + s * c[i], 24 bytes per element) over
+/// arrays far larger than the caches; arithmetic throughput is the best of several passes of independent
+/// multiply-add chains built for the widest vector instructions the CPU supports, i.e. what the project's kernels
+/// can reach, not the datasheet peak.
+/// Takes about a second and allocates about 200 MB.
+MachinePeaks MeasureMachinePeaks(int num_threads);
+
+/// @brief Achieved rates of a run and their position under the roofline.
+struct RooflineResult {
+  double bytes_per_sec = 0.0;
+  double flops_per_sec = 0.0;
+  double elements_per_sec = 0.0;
+  /// @brief Arithmetic intensity in FLOP per byte, 0 if the workload moves no bytes.
+  double intensity = 0.0;
+  /// @brief "memory" or "compute": the resource whose peak limits the workload.
+  std::string_view bound = "memory";
+  /// @brief Shortest time the peaks allow for the workload divided by the measured time (1 = on the roofline).
+  double fraction = 0.0;
+};
+
+/// @brief Places a run of time_sec seconds under the roofline of the given peaks.
+/// @details The roofline time is max(bytes / peak bandwidth, flops / peak throughput).
+RooflineResult EvaluateRoofline(const Workload &workload, double time_sec, const MachinePeaks &peaks);
+
+}  // namespace ppc::performance
@@ -0,0 +1,196 @@
+#include "performance/include/hw_counters.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <cerrno>
+#  include <charconv>
+#  include <filesystem>
+#  include <string>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+constexpr std::array<std::string_view, kNumHwEvents> kHwEventNames = {
+    "cycles", "instructions", "cache_references", "cache_misses", "branches", "branch_misses", "llc_loads",
+    "llc_load_misses"};
+
+#ifdef __linux__
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr uint64_t MakeCacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8U) | (result << 16U);
+}
+
+constexpr std::array<EventConfig, kNumHwEvents> kEventConfigs = {{
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CPU_CYCLES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_INSTRUCTIONS},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_REFERENCES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_MISSES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_MISSES},
+    {.type = PERF_TYPE_HW_CACHE,
+     .config = MakeCacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+    {.type = PERF_TYPE_HW_CACHE,
+     .config = MakeCacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+}};
+
+int OpenEvent(const EventConfig &event, pid_t tid) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  // Threads created later by a counted thread are counted as well
+  attr.inherit = 1;
+  // User-space only: allowed with the default perf_event_paranoid setting.
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+/// @brief Thread ids of the process; the calling thread only (0) if /proc is not readable.
+std::vector<pid_t> ListThreads() {
+  std::vector<pid_t> threads;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+    const auto name = entry.path().filename().string();
+    pid_t tid = 0;
+    if (std::from_chars(name.data(), name.data() + name.size(), tid).ec == std::errc{}) {
+      threads.push_back(tid);
+    }
+  }
+  if (ec || threads.empty()) {
+    return {0};
+  }
+  return threads;
+}
+
+std::optional<double> ReadEvent(int fd) {
+  std::array<uint64_t, 3> data{};  // value, time enabled, time running
+  if (read(fd, data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+    return std::nullopt;
+  }
+  if (data[1] == 0) {
+    // The thread was not scheduled while the event was enabled (an idle pool worker)
+    return 0.0;
+  }
+  if (data[2] == 0) {
+    return std::nullopt;
+  }
+  // Scale up if the event was multiplexed with others and counted only part of the time.
+  return static_cast<double>(data[0]) * (static_cast<double>(data[1]) / static_cast<double>(data[2]));
+}
+
+void CloseAll(std::vector<int> &fds) {
+  for (int fd : fds) {
+    close(fd);
+  }
+  fds.clear();
+}
+#endif
+
+}  // namespace
+
+std::string_view GetHwEventName(HwEvent event) {
+  return kHwEventNames[static_cast<std::size_t>(event)];
+}
+
+HwCounters::HwCounters() {
+#ifdef __linux__
+  // Worker pools (OpenMP, TBB) usually exist already, so every thread gets its own descriptor; inherit only
+  // follows threads created after the events are opened
+  const auto threads = ListThreads();
+  for (std::size_t i = 0; i < kNumHwEvents; i++) {
+    for (pid_t tid : threads) {
+      const int fd = OpenEvent(kEventConfigs[i], tid);
+      if (fd >= 0) {
+        fds_[i].push_back(fd);
+      } else if (errno != ESRCH) {
+        // A count missing some threads would under-report, so the event is dropped; ESRCH is a thread that exited
+        CloseAll(fds_[i]);
+        break;
+      }
+    }
+  }
+#endif
+}
+
+HwCounters::~HwCounters() {
+#ifdef __linux__
+  for (auto &fds : fds_) {
+    CloseAll(fds);
+  }
+#endif
+}
+
+bool HwCounters::IsAvailable() const {
+  for (const auto &fds : fds_) {
+    if (!fds.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HwCounters::Start() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+HwCounterResults HwCounters::Read() const {
+  HwCounterResults results;
+#ifdef __linux__
+  for (std::size_t i = 0; i < kNumHwEvents; i++) {
+    if (fds_[i].empty()) {
+      continue;
+    }
+    std::optional<double> total = 0.0;
+    for (int fd : fds_[i]) {
+      const auto value = ReadEvent(fd);
+      if (!value.has_value()) {
+        total.reset();
+        break;
+      }
+      *total += *value;
+    }
+    results.values[i] = total;
+  }
+#endif
+  return results;
+}
+
+HwCounterResults HwCounters::Stop() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+#endif
+  return Read();
+}
+
+}  // namespace ppc::performance
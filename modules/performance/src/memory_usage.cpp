@@ -0,0 +1,234 @@
+#include "performance/include/memory_usage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#ifdef PPC_ALLOC_TRACKING
+#  include <atomic>
+#  include <cstdlib>
+#  include <new>
+#endif
+
+#if defined(__APPLE__)
+#  include <sys/resource.h>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+#ifdef __linux__
+/// @brief Reads a "<key>: <value> kB" entry of /proc/self/status in bytes.
+std::size_t ReadProcStatusBytes(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string name;
+  while (status >> name) {
+    if (name == key) {
+      std::size_t kilobytes = 0;
+      status >> kilobytes;
+      return kilobytes * 1024;
+    }
+    std::getline(status, name);
+  }
+  return 0;
+}
+#endif
+
+#ifdef PPC_ALLOC_TRACKING
+struct AllocationCounters {
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> bytes{0};
+};
+
+// Constant-initialized, so it is usable from operator new during static initialization.
+AllocationCounters &GetAllocationCounters() {
+  static AllocationCounters counters;
+  return counters;
+}
+#endif
+
+}  // namespace
+
+std::size_t GetPeakRss() {
+#if defined(__linux__)
+  return ReadProcStatusBytes("VmHWM:");
+#elif defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  return static_cast<std::size_t>(usage.ru_maxrss);  // bytes on macOS
+#else
+  return 0;
+#endif
+}
+
+std::size_t GetCurrentRss() {
+#ifdef __linux__
+  return ReadProcStatusBytes("VmRSS:");
+#else
+  return 0;
+#endif
+}
+
+bool ResetPeakRss() {
+#ifdef __linux__
+  // Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0+)
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if (!clear_refs.is_open()) {
+    return false;
+  }
+  clear_refs << "5";
+  clear_refs.flush();
+  return clear_refs.good();
+#else
+  return false;
+#endif
+}
+
+bool IsAllocationTrackingEnabled() {
+#ifdef PPC_ALLOC_TRACKING
+  return true;
+#else
+  return false;
+#endif
+}
+
+AllocationStats GetAllocationStats() {
+#ifdef PPC_ALLOC_TRACKING
+  const auto &counters = GetAllocationCounters();
+  return AllocationStats{.count = counters.count.load(std::memory_order_relaxed),
+                         .bytes = counters.bytes.load(std::memory_order_relaxed)};
+#else
+  return {};
+#endif
+}
+
+}  // namespace ppc::performance
+
+#ifdef PPC_ALLOC_TRACKING
+
+// Replacement of the global allocation functions: every operator new is counted
+// and served by malloc (or the aligned allocator for over-aligned types).
+// NOLINTBEGIN(cppcoreguidelines-no-malloc,misc-new-delete-overloads)
+namespace {
+
+void RecordAllocation(std::size_t size) {
+  auto &counters = ppc::performance::GetAllocationCounters();
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void *AllocateOrNull(std::size_t size, std::size_t alignment) {
+#ifdef _WIN32
+  return alignment == 0 ? std::malloc(size) : _aligned_malloc(size, alignment);
+#else
+  if (alignment == 0) {
+    return std::malloc(size);
+  }
+  void *ptr = nullptr;
+  return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void *TrackedAllocate(std::size_t size, std::size_t alignment = 0) {
+  RecordAllocation(size);
+  if (size == 0) {
+    size = 1;
+  }
+  while (true) {
+    if (void *ptr = AllocateOrNull(size, alignment)) {
+      return ptr;
+    }
+    auto *handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void *TrackedAllocateNoThrow(std::size_t size, std::size_t alignment = 0) noexcept {
+  try {
+    return TrackedAllocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void AlignedFree(void *ptr) noexcept {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  return TrackedAllocate(size);
+}
+void *operator new[](std::size_t size) {
+  return TrackedAllocate(size);
+}
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAllocateNoThrow(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAllocateNoThrow(size);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return TrackedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return TrackedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAllocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAllocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*alignment*/, const std::nothrow_t & /*tag*/) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*alignment*/, const std::nothrow_t & /*tag*/) noexcept {
+  AlignedFree(ptr);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc,misc-new-delete-overloads)
+
+#endif  // PPC_ALLOC_TRACKING
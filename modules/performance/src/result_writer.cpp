@@ -0,0 +1,287 @@
+#include "performance/include/result_writer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_usage.hpp"
+#include "performance/include/performance.hpp"
+#include "performance/include/roofline.hpp"
+
+#ifdef _WIN32
+#  include <libenvpp/detail/get.hpp>
+#else
+#  include <unistd.h>
+
+#  include <array>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+std::string GetHostName() {
+#ifdef _WIN32
+  const auto name = env::get<std::string>("COMPUTERNAME");
+  return name.has_value() ? name.value() : std::string("unknown");
+#else
+  std::array<char, 256> buffer{};
+  if (gethostname(buffer.data(), buffer.size() - 1) != 0) {
+    return "unknown";
+  }
+  return {buffer.data()};
+#endif
+}
+
+std::string GetOsName() {
+#if defined(_WIN32)
+  return "windows";
+#elif defined(__APPLE__)
+  return "macos";
+#elif defined(__linux__)
+  return "linux";
+#else
+  return "unknown";
+#endif
+}
+
+std::string GetCompilerName() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_VER);
+#else
+  return "unknown";
+#endif
+}
+
+int64_t GetUnixTimestamp() {
+  return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string JoinValues(const std::vector<double> &values) {
+  std::ostringstream os;
+  os.precision(10);
+  for (std::size_t i = 0; i < values.size(); i++) {
+    if (i != 0) {
+      os << ';';
+    }
+    os << std::fixed << values[i];
+  }
+  return os.str();
+}
+
+std::string JoinStrings(const std::vector<std::string> &values) {
+  std::string joined;
+  for (std::size_t i = 0; i < values.size(); i++) {
+    if (i != 0) {
+      joined += ';';
+    }
+    joined += values[i];
+  }
+  return joined;
+}
+
+std::string EscapeCsv(const std::string &value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) {
+    return value;
+  }
+  std::string escaped = "\"";
+  for (char ch : value) {
+    if (ch == '"') {
+      escaped += '"';
+    }
+    escaped += ch;
+  }
+  return escaped + "\"";
+}
+
+}  // namespace
+
+HostInfo GetHostInfo() {
+  return HostInfo{.hostname = GetHostName(),
+                  .hardware_threads = std::thread::hardware_concurrency(),
+                  .os = GetOsName(),
+                  .compiler = GetCompilerName()};
+}
+
+std::string PerfRecordToJson(const PerfRecord &record, const HostInfo &host) {
+  const auto &results = record.results;
+  const auto &stats = results.statistics;
+  nlohmann::json json;
+  json["schema_version"] = kPerfRecordSchemaVersion;
+  json["timestamp"] = GetUnixTimestamp();
+  json["test_name"] = record.test_name;
+  json["task_namespace"] = record.task_namespace;
+  json["technology"] = record.technology;
+  json["mode"] = record.mode;
+  json["num_proc"] = record.num_proc;
+  json["num_threads"] = record.num_threads;
+  json["input_size"] = record.input_size;
+  json["problem_size"] = record.problem_size;
+  json["input_bytes"] = record.input_bytes;
+  json["input_saved_bytes"] = record.input_saved_bytes;
+  json["time_sec"] = results.time_sec;
+  json["samples"] = results.samples;
+  json["statistics"]["min"] = stats.min;
+  json["statistics"]["median"] = stats.median;
+  json["statistics"]["p90"] = stats.p90;
+  json["statistics"]["p99"] = stats.p99;
+  json["statistics"]["mean"] = stats.mean;
+  json["statistics"]["stddev"] = stats.stddev;
+  json["statistics"]["cv"] = stats.cv;
+  json["statistics"]["stable"] = stats.stable;
+  json["rank_times"] = record.rank_times;
+  json["rank_comm_times"] = record.rank_comm_times;
+  json["rank_comm_bytes"] = record.rank_comm_bytes;
+  const auto summary = SummarizeRanks(record.rank_times, record.rank_comm_times, record.rank_comm_bytes);
+  json["ranks"]["max"] = summary.max_time;
+  json["ranks"]["min"] = summary.min_time;
+  json["ranks"]["mean"] = summary.mean_time;
+  json["ranks"]["imbalance"] = summary.imbalance;
+  json["ranks"]["compute_mean"] = summary.mean_compute_time;
+  json["ranks"]["comm_mean"] = summary.mean_comm_time;
+  json["ranks"]["comm_max"] = summary.max_comm_time;
+  json["ranks"]["comm_bytes_mean"] = summary.mean_comm_bytes;
+  json["ranks"]["comm_bytes_max"] = summary.max_comm_bytes;
+  json["stages"]["validation"] = results.stage_times.validation;
+  json["stages"]["pre_processing"] = results.stage_times.pre_processing;
+  json["stages"]["run"] = results.stage_times.run;
+  json["stages"]["post_processing"] = results.stage_times.post_processing;
+  for (std::size_t i = 0; i < kNumHwEvents; i++) {
+    if (results.hw_counters.values[i].has_value()) {
+      json["hw_counters"][std::string(GetHwEventName(static_cast<HwEvent>(i)))] = *results.hw_counters.values[i];
+    }
+  }
+  if (const auto ipc = results.hw_counters.GetIpc(); ipc.has_value()) {
+    json["hw_counters"]["ipc"] = *ipc;
+  }
+  if (results.peak_rss_bytes != 0) {
+    const auto memory = SummarizeRankMemory(record.rank_peak_rss);
+    json["memory"]["peak_rss"] = results.peak_rss_bytes;
+    json["memory"]["rank_peak_rss"] = record.rank_peak_rss;
+    json["memory"]["max_peak_rss"] = memory.max_peak_rss;
+    json["memory"]["total_peak_rss"] = memory.total_peak_rss;
+    if (IsAllocationTrackingEnabled()) {
+      json["memory"]["allocs"] = results.alloc_count;
+      json["memory"]["alloc_bytes"] = results.alloc_bytes;
+    }
+  }
+  if (!record.workload.IsEmpty()) {
+    json["throughput"]["bytes"] = record.workload.bytes;
+    json["throughput"]["flops"] = record.workload.flops;
+    json["throughput"]["elements"] = record.workload.elements;
+    json["throughput"]["gb_per_sec"] = record.roofline.bytes_per_sec * 1e-9;
+    json["throughput"]["gflop_per_sec"] = record.roofline.flops_per_sec * 1e-9;
+    json["throughput"]["elements_per_sec"] = record.roofline.elements_per_sec;
+    json["roofline"]["peak_gb_per_sec"] = record.peaks.bytes_per_sec * 1e-9;
+    json["roofline"]["peak_gflop_per_sec"] = record.peaks.flops_per_sec * 1e-9;
+    json["roofline"]["intensity"] = record.roofline.intensity;
+    json["roofline"]["bound"] = std::string(record.roofline.bound);
+    json["roofline"]["fraction"] = record.roofline.fraction;
+  }
+  json["placement"]["bind"] = record.bind;
+  json["placement"]["numa"] = record.numa;
+  json["placement"]["numa_nodes"] = record.numa_nodes;
+  json["placement"]["rank_cpus"] = record.rank_cpus;
+  json["host"]["hostname"] = host.hostname;
+  json["host"]["hardware_threads"] = host.hardware_threads;
+  json["host"]["os"] = host.os;
+  json["host"]["compiler"] = host.compiler;
+  return json.dump();
+}
+
+std::string GetPerfRecordCsvHeader() {
+  std::string header =
+      "timestamp,test_name,task_namespace,technology,mode,num_proc,num_threads,input_size,time_sec,min,median,"
+      "p90,p99,stddev,cv,samples,rank_times,rank_comm_times,imbalance,hostname,hardware_threads,"
+      "validation_time,pre_processing_time,run_time,post_processing_time,input_bytes,input_saved_bytes,peak_rss,"
+      "rank_peak_rss,allocs,alloc_bytes,problem_size,bind,numa,numa_nodes,rank_cpus,gb_per_sec,gflop_per_sec,"
+      "elements_per_sec,roofline_fraction";
+  for (std::size_t i = 0; i < kNumHwEvents; i++) {
+    header += ",";
+    header += GetHwEventName(static_cast<HwEvent>(i));
+  }
+  return header + ",ipc,rank_comm_bytes";
+}
+
+std::string PerfRecordToCsv(const PerfRecord &record, const HostInfo &host) {
+  const auto &results = record.results;
+  const auto &stats = results.statistics;
+  std::ostringstream os;
+  os.precision(10);
+  os << GetUnixTimestamp() << ',' << EscapeCsv(record.test_name) << ',' << EscapeCsv(record.task_namespace) << ','
+     << record.technology << ',' << record.mode << ',' << record.num_proc << ',' << record.num_threads << ','
+     << record.input_size << ',' << std::fixed << results.time_sec << ',' << stats.min << ',' << stats.median << ','
+     << stats.p90 << ',' << stats.p99 << ',' << stats.stddev << ',' << stats.cv << ',' << JoinValues(results.samples)
+     << ',' << JoinValues(record.rank_times) << ',' << JoinValues(record.rank_comm_times) << ','
+     << SummarizeRanks(record.rank_times, record.rank_comm_times).imbalance << ',' << EscapeCsv(host.hostname) << ','
+     << host.hardware_threads << ',' << results.stage_times.validation << ',' << results.stage_times.pre_processing
+     << ',' << results.stage_times.run << ',' << results.stage_times.post_processing << ',' << record.input_bytes
+     << ',' << record.input_saved_bytes << ',' << results.peak_rss_bytes << ',' << JoinValues(record.rank_peak_rss)
+     << ',' << results.alloc_count << ',' << results.alloc_bytes << ',' << record.problem_size << ',' << record.bind
+     << ',' << record.numa << ',' << record.numa_nodes << ',' << EscapeCsv(JoinStrings(record.rank_cpus));
+  // Throughput columns stay empty without a declared workload
+  os << ',';
+  if (!record.workload.IsEmpty()) {
+    os << record.roofline.bytes_per_sec * 1e-9 << ',' << record.roofline.flops_per_sec * 1e-9 << ','
+       << record.roofline.elements_per_sec << ',' << record.roofline.fraction;
+  } else {
+    os << ",,,";
+  }
+  // Events that were not counted are left empty
+  for (const auto &value : results.hw_counters.values) {
+    os << ',';
+    if (value.has_value()) {
+      os << *value;
+    }
+  }
+  os << ',';
+  if (const auto ipc = results.hw_counters.GetIpc(); ipc.has_value()) {
+    os << *ipc;
+  }
+  os << ',' << JoinValues(record.rank_comm_bytes);
+  return os.str();
+}
+
+void AppendPerfRecord(const PerfRecord &record, const std::string &path) {
+  const bool is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::error_code ec;
+  const bool is_empty = !std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0;
+  if (is_csv && !is_empty) {
+    std::ifstream existing(path);
+    std::string header;
+    std::getline(existing, header);
+    if (header != GetPerfRecordCsvHeader()) {
+      throw std::runtime_error("Perf output file " + path +
+                               " has a different CSV header (written by another version); use a new file");
+    }
+  }
+
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open perf output file " + path);
+  }
+  const auto host = GetHostInfo();
+  if (is_csv) {
+    if (is_empty) {
+      file << GetPerfRecordCsvHeader() << '\n';
+    }
+    file << PerfRecordToCsv(record, host) << '\n';
+  } else {
+    file << PerfRecordToJson(record, host) << '\n';
+  }
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,145 @@
+#include "performance/include/roofline.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define PPC_ROOFLINE_X86 1
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+// 64 MiB per array: well beyond the last-level cache of the machines the tests run on
+constexpr std::size_t kStreamElements = std::size_t{1} << 23;
+constexpr int kStreamPasses = 5;
+constexpr double kStreamScalar = 3.0;
+
+// Enough independent chains to hide the multiply-add latency on any vector width
+constexpr std::size_t kFlopChains = 64;
+constexpr int kFlopIterations = 1 << 18;
+constexpr int kFlopPasses = 3;
+
+double MeasureStreamBandwidth(int num_threads) {
+  const auto a = std::make_unique_for_overwrite<double[]>(kStreamElements);
+  const auto b = std::make_unique_for_overwrite<double[]>(kStreamElements);
+  const auto c = std::make_unique_for_overwrite<double[]>(kStreamElements);
+  const auto count = static_cast<std::ptrdiff_t>(kStreamElements);
+  // Every thread touches the pages it streams over later
+#pragma omp parallel for num_threads(num_threads) schedule(static) default(none) shared(a, b, c, count)
+  for (std::ptrdiff_t i = 0; i < count; i++) {
+    a[i] = 0.0;
+    b[i] = 1.0;
+    c[i] = 2.0;
+  }
+  double best = std::numeric_limits<double>::max();
+  for (int pass = 0; pass < kStreamPasses; pass++) {
+    const double start = omp_get_wtime();
+#pragma omp parallel for num_threads(num_threads) schedule(static) default(none) shared(a, b, c, count)
+    for (std::ptrdiff_t i = 0; i < count; i++) {
+      a[i] = b[i] + (kStreamScalar * c[i]);
+    }
+    best = std::min(best, omp_get_wtime() - start);
+  }
+  return 3.0 * static_cast<double>(kStreamElements * sizeof(double)) / best;
+}
+
+/// Runs the multiply-add chains of one thread and returns their sum; inlined into each instruction set variant below.
+/// Fused chains count like the fused multiply-adds of the kernels that run on FMA hardware.
+template <bool kFused>
+[[gnu::always_inline]] inline double RunFlopChains(int thread) {
+  std::array<double, kFlopChains> chains{};
+  for (std::size_t j = 0; j < kFlopChains; j++) {
+    chains[j] = static_cast<double>(j + static_cast<std::size_t>(thread));
+  }
+  for (int iteration = 0; iteration < kFlopIterations; iteration++) {
+#pragma omp simd
+    for (std::size_t j = 0; j < kFlopChains; j++) {
+      if constexpr (kFused) {
+        chains[j] = std::fma(chains[j], 0.999999, 1e-6);
+      } else {
+        chains[j] = (chains[j] * 0.999999) + 1e-6;
+      }
+    }
+  }
+  double sum = 0.0;
+  for (double value : chains) {
+    sum += value;
+  }
+  return sum;
+}
+
+double RunFlopChainsBaseline(int thread) {
+  return RunFlopChains<false>(thread);
+}
+
+#ifdef PPC_ROOFLINE_X86
+__attribute__((target("avx2,fma"))) double RunFlopChainsAvx2(int thread) {
+  return RunFlopChains<true>(thread);
+}
+
+__attribute__((target("avx512f"))) double RunFlopChainsAvx512(int thread) {
+  return RunFlopChains<true>(thread);
+}
+#endif
+
+/// The widest vector instructions the CPU has: kernels such as ppc::util::Gemm() select them at run time, so the
+/// peak must not be limited to the baseline the project is compiled for.
+double (*SelectFlopChains())(int) {
+#ifdef PPC_ROOFLINE_X86
+  if (__builtin_cpu_supports("avx512f")) {
+    return RunFlopChainsAvx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return RunFlopChainsAvx2;
+  }
+#endif
+  return RunFlopChainsBaseline;
+}
+
+double MeasureFlopRate(int num_threads) {
+  auto *const run_chains = SelectFlopChains();
+  double best = std::numeric_limits<double>::max();
+  double sink = 0.0;
+  for (int pass = 0; pass < kFlopPasses; pass++) {
+    const double start = omp_get_wtime();
+#pragma omp parallel num_threads(num_threads) default(none) shared(run_chains) reduction(+ : sink)
+    sink += run_chains(omp_get_thread_num());
+    best = std::min(best, omp_get_wtime() - start);
+  }
+  // The sum keeps the chains alive; it is positive, so the comparison is always true
+  const double flops = 2.0 * kFlopChains * kFlopIterations * static_cast<double>(num_threads);
+  return sink > 0.0 ? flops / best : 0.0;
+}
+
+}  // namespace
+
+MachinePeaks MeasureMachinePeaks(int num_threads) {
+  num_threads = std::max(1, num_threads);
+  return {.bytes_per_sec = MeasureStreamBandwidth(num_threads), .flops_per_sec = MeasureFlopRate(num_threads)};
+}
+
+RooflineResult EvaluateRoofline(const Workload &workload, double time_sec, const MachinePeaks &peaks) {
+  RooflineResult result;
+  if (time_sec <= 0.0) {
+    return result;
+  }
+  result.bytes_per_sec = workload.bytes / time_sec;
+  result.flops_per_sec = workload.flops / time_sec;
+  result.elements_per_sec = workload.elements / time_sec;
+  result.intensity = workload.bytes > 0.0 ? workload.flops / workload.bytes : 0.0;
+  const double memory_time = peaks.bytes_per_sec > 0.0 ? workload.bytes / peaks.bytes_per_sec : 0.0;
+  const double compute_time = peaks.flops_per_sec > 0.0 ? workload.flops / peaks.flops_per_sec : 0.0;
+  result.bound = compute_time > memory_time ? "compute" : "memory";
+  result.fraction = std::max(memory_time, compute_time) / time_sec;
+  return result;
+}
+
+}  // namespace ppc::performance
@@ -1,18 +1,27 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <libenvpp/detail/environment.hpp>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <thread>
 #include <vector>
 
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/memory_usage.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/result_writer.hpp"
+#include "performance/include/roofline.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
@@ -350,6 +359,582 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, ComputeStatisticsReturnsOrderStatistics) {
+  const auto stats = ComputeStatistics({5.0, 1.0, 4.0, 2.0, 3.0});
+  EXPECT_DOUBLE_EQ(stats.min, 1.0);
+  EXPECT_DOUBLE_EQ(stats.median, 3.0);
+  EXPECT_DOUBLE_EQ(stats.p90, 4.6);
+  EXPECT_DOUBLE_EQ(stats.mean, 3.0);
+  EXPECT_NEAR(stats.stddev, 1.5811388301, 1e-9);
+  EXPECT_NEAR(stats.cv, stats.stddev / 3.0, 1e-12);
+}
+
+TEST(PerfTest, ComputeStatisticsHandlesEmptyAndSingleSample) {
+  const auto empty = ComputeStatistics({});
+  EXPECT_DOUBLE_EQ(empty.mean, 0.0);
+  const auto single = ComputeStatistics({2.0});
+  EXPECT_DOUBLE_EQ(single.p99, 2.0);
+  EXPECT_DOUBLE_EQ(single.stddev, 0.0);
+}
+
+TEST(PerfTest, CollectSamplesRecordsEveryIterationAfterWarmup) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 4;
+  attr.num_warmup = 3;
+  attr.collect_samples = true;
+  int timer_calls = 0;
+  attr.current_timer = [&timer_calls]() { return static_cast<double>(timer_calls++); };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_EQ(timer_calls, 8);
+  ASSERT_EQ(res.samples.size(), 4U);
+  EXPECT_DOUBLE_EQ(res.time_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.statistics.stddev, 0.0);
+  EXPECT_TRUE(res.statistics.stable);
+}
+
+TEST(PerfTest, CollectSamplesRerunsUntilStable) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.collect_samples = true;
+  attr.max_cv = 0.01;
+  // The first iteration is an outlier, all others take exactly one second.
+  double now = 0.0;
+  int timer_calls = 0;
+  attr.current_timer = [&]() {
+    if (timer_calls++ % 2 == 1) {
+      now += timer_calls == 2 ? 10.0 : 1.0;
+    }
+    return now;
+  };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_TRUE(res.statistics.stable);
+  EXPECT_EQ(timer_calls, 8);
+  EXPECT_DOUBLE_EQ(res.time_sec, 1.0);
+}
+
+TEST(PerfTest, CollectSamplesReportsUnstableWhenLimitReached) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.collect_samples = true;
+  attr.max_cv = 0.01;
+  attr.max_num_running = 6;
+  double now = 0.0;
+  int timer_calls = 0;
+  attr.current_timer = [&]() {
+    if (timer_calls++ % 2 == 1) {
+      now += (timer_calls % 4 == 0) ? 1.0 : 3.0;
+    }
+    return now;
+  };
+
+  perf.TaskRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_FALSE(res.statistics.stable);
+  EXPECT_EQ(res.samples.size(), 2U);
+  EXPECT_EQ(timer_calls, 12);
+}
+
+TEST(PerfTest, CollectSamplesUsesCombinedCv) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.collect_samples = true;
+  attr.max_cv = 0.01;
+  attr.max_num_running = 5;
+  // The samples of this process are stable, but another one reports a noisy run
+  int timer_calls = 0;
+  attr.current_timer = [&timer_calls]() { return static_cast<double>(timer_calls++); };
+  std::vector<double> local_cvs;
+  attr.combine_cv = [&local_cvs](double cv) {
+    local_cvs.push_back(cv);
+    return 0.5;
+  };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_FALSE(res.statistics.stable);
+  EXPECT_EQ(timer_calls, 10);
+  EXPECT_EQ(local_cvs, std::vector<double>(4, 0.0));
+}
+
+TEST(PerfTest, CombineCvIsNotCalledWithoutStabilityCheck) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.collect_samples = true;
+  attr.current_timer = [] { return 0.0; };
+  attr.combine_cv = [](double) -> double { throw std::runtime_error("combine_cv without max_cv"); };
+  EXPECT_NO_THROW(perf.PipelineRun(attr));
+}
+
+TEST(PerfTest, CommTimerIsAveragedPerIteration) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 4;
+  attr.num_warmup = 2;
+  attr.collect_samples = true;
+  double comm_time = 0.0;
+  attr.current_timer = [&comm_time]() {
+    comm_time += 0.5;
+    return comm_time;
+  };
+  attr.comm_timer = [&comm_time]() { return comm_time; };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  // Every timer call advances the fake communication clock, two calls per measured iteration.
+  EXPECT_DOUBLE_EQ(res.comm_time_sec, 1.0);
+}
+
+TEST(PerfTest, CommBytesAreAveragedPerIteration) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 4;
+  double comm_bytes = 0.0;
+  attr.current_timer = [&comm_bytes]() {
+    comm_bytes += 100.0;
+    return 0.0;
+  };
+  attr.comm_bytes_counter = [&comm_bytes]() { return comm_bytes; };
+
+  perf.TaskRun(attr);
+  // Two timer calls around the four iterations move the fake counter by 200 bytes
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().comm_bytes, 50.0);
+}
+
+TEST(PerfTest, RerunsReportMetricsOfTheKeptWindow) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.collect_samples = true;
+  attr.max_cv = 0.01;
+  // The first iteration is an outlier that is dropped from the window, and all of it counts as communication
+  double now = 0.0;
+  int timer_calls = 0;
+  attr.current_timer = [&]() {
+    if (timer_calls++ % 2 == 1) {
+      now += timer_calls == 2 ? 10.0 : 1.0;
+    }
+    return now;
+  };
+  attr.comm_timer = [&now]() { return now; };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_EQ(timer_calls, 8);
+  EXPECT_DOUBLE_EQ(res.time_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.comm_time_sec, 1.0);
+}
+
+TEST(PerfTest, CommTimeIsZeroWithoutCommTimer) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  perf.TaskRun(PerfAttr{});
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().comm_time_sec, 0.0);
+}
+
+TEST(PerfTest, SummarizeRanksComputesImbalanceAndCommShare) {
+  const auto summary = SummarizeRanks({1.0, 2.0, 3.0}, {0.5, 0.5, 2.0});
+  EXPECT_DOUBLE_EQ(summary.max_time, 3.0);
+  EXPECT_DOUBLE_EQ(summary.min_time, 1.0);
+  EXPECT_DOUBLE_EQ(summary.mean_time, 2.0);
+  EXPECT_DOUBLE_EQ(summary.imbalance, 1.5);
+  EXPECT_DOUBLE_EQ(summary.mean_comm_time, 1.0);
+  EXPECT_DOUBLE_EQ(summary.max_comm_time, 2.0);
+  EXPECT_DOUBLE_EQ(summary.mean_compute_time, 1.0);
+}
+
+TEST(PerfTest, SummarizeRanksHandlesEmptyAndZeroTimes) {
+  const auto empty = SummarizeRanks({}, {});
+  EXPECT_DOUBLE_EQ(empty.imbalance, 1.0);
+  const auto zero = SummarizeRanks({0.0, 0.0}, {});
+  EXPECT_DOUBLE_EQ(zero.imbalance, 1.0);
+  EXPECT_DOUBLE_EQ(zero.mean_comm_time, 0.0);
+}
+
+TEST(PerfTest, SummarizeRanksComputesCommVolume) {
+  const auto summary = SummarizeRanks({1.0, 1.0, 1.0}, {}, {100.0, 200.0, 600.0});
+  EXPECT_DOUBLE_EQ(summary.mean_comm_bytes, 300.0);
+  EXPECT_DOUBLE_EQ(summary.max_comm_bytes, 600.0);
+  EXPECT_DOUBLE_EQ(SummarizeRanks({1.0}, {}).max_comm_bytes, 0.0);
+}
+
+TEST(PerfTest, PrintRankSummaryUsesRanksSuffix) {
+  testing::internal::CaptureStdout();
+  PrintRankSummary("ranks_test", PerfResults::TypeOfRunning::kTaskRun, SummarizeRanks({1.0, 3.0}, {0.0, 1.0}));
+  const std::string output = testing::internal::GetCapturedStdout();
+  EXPECT_EQ(output.rfind("ranks_test:task_run_ranks:max=3.0000000000", 0), 0U);
+  EXPECT_NE(output.find("imbalance=1.5000000000"), std::string::npos);
+  EXPECT_NE(output.find("comm_max=1.0000000000"), std::string::npos);
+  EXPECT_NE(output.find("comm_bytes_mean=0 comm_bytes_max=0"), std::string::npos);
+}
+
+TEST(HwCountersTest, EventNamesAreSnakeCase) {
+  EXPECT_EQ(GetHwEventName(HwEvent::kCycles), "cycles");
+  EXPECT_EQ(GetHwEventName(HwEvent::kCacheMisses), "cache_misses");
+  EXPECT_EQ(GetHwEventName(HwEvent::kLlcLoadMisses), "llc_load_misses");
+}
+
+TEST(HwCountersTest, IpcRequiresCyclesAndInstructions) {
+  HwCounterResults results;
+  EXPECT_FALSE(results.HasValues());
+  EXPECT_FALSE(results.GetIpc().has_value());
+
+  results.values[static_cast<std::size_t>(HwEvent::kInstructions)] = 300.0;
+  EXPECT_TRUE(results.HasValues());
+  EXPECT_FALSE(results.GetIpc().has_value());
+
+  results.values[static_cast<std::size_t>(HwEvent::kCycles)] = 200.0;
+  ASSERT_TRUE(results.GetIpc().has_value());
+  EXPECT_DOUBLE_EQ(*results.GetIpc(), 1.5);
+}
+
+TEST(HwCountersTest, StopReturnsValuesOnlyForAvailableCounters) {
+  HwCounters counters;
+  counters.Start();
+  volatile double sum = 0.0;
+  for (int i = 0; i < 100000; i++) {
+    sum = sum + (static_cast<double>(i) * 0.5);
+  }
+  const auto results = counters.Stop();
+  if (!counters.IsAvailable()) {
+    EXPECT_FALSE(results.HasValues());
+  } else if (const auto instructions = results.Get(HwEvent::kInstructions); instructions.has_value()) {
+    EXPECT_GT(*instructions, 0.0);
+  }
+}
+
+namespace {
+
+std::optional<double> CountInstructionsOfParallelLoop(int num_threads) {
+  HwCounters counters;
+  counters.Start();
+#pragma omp parallel num_threads(num_threads)
+  {
+    volatile double sum = 0.0;
+    for (int i = 0; i < 20000000; i++) {
+      sum = sum + (static_cast<double>(i) * 0.5);
+    }
+  }
+  return counters.Stop().Get(HwEvent::kInstructions);
+}
+
+}  // namespace
+
+TEST(HwCountersTest, CountsWorkersThatExistBeforeTheCounters) {
+  constexpr int kNumThreads = 4;
+  // Create the worker pool first, as the warm-up and earlier tests do before a perf case is measured
+#pragma omp parallel num_threads(kNumThreads)
+  {
+    volatile int touch = 0;
+    touch = touch + 1;
+  }
+  const auto single = CountInstructionsOfParallelLoop(1);
+  if (!single.has_value()) {
+    GTEST_SKIP() << "The instructions event is not available";
+  }
+  const auto parallel = CountInstructionsOfParallelLoop(kNumThreads);
+  ASSERT_TRUE(parallel.has_value());
+  // Every thread runs the whole loop, so the count grows with the number of threads
+  EXPECT_GT(*parallel, 0.75 * kNumThreads * *single);
+}
+
+TEST(PerfTest, CollectHwCountersFallsBackGracefully) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.collect_hw_counters = true;
+  attr.current_timer = [] { return 0.0; };
+  EXPECT_NO_THROW(perf.TaskRun(attr));
+  if (!HwCounters().IsAvailable()) {
+    EXPECT_FALSE(perf.GetPerfResults().hw_counters.HasValues());
+  }
+}
+
+namespace {
+
+class SleepingRunTask : public Task<int, int> {
+ public:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(PerfTest, PipelineRunReportsStageTimesPerIteration) {
+  auto task_ptr = std::make_shared<SleepingRunTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 1;
+  attr.current_timer = [] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  };
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_GE(res.stage_times.run, 0.005);
+  EXPECT_LT(res.stage_times.validation, res.stage_times.run);
+  EXPECT_LE(res.stage_times.Total(), res.time_sec);
+}
+
+TEST(PerfTest, TaskRunReportsOnlyRunStage) {
+  auto task_ptr = std::make_shared<SleepingRunTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  perf.TaskRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_GE(res.stage_times.run, 0.005);
+  EXPECT_DOUBLE_EQ(res.stage_times.validation, 0.0);
+  EXPECT_DOUBLE_EQ(res.stage_times.post_processing, 0.0);
+}
+
+TEST(MemoryUsageTest, PeakRssIsAtLeastCurrentRss) {
+  const auto current = GetCurrentRss();
+  if (current == 0) {
+    GTEST_SKIP() << "RSS is not available on this platform";
+  }
+  EXPECT_GE(GetPeakRss(), current);
+}
+
+TEST(MemoryUsageTest, ResetPeakRssForgetsReleasedMemory) {
+  constexpr std::size_t kBytes = std::size_t{64} << 20U;
+  {
+    std::vector<char> buffer(kBytes, 1);
+    ASSERT_EQ(buffer[kBytes - 1], 1);
+  }
+  const auto peak_before = GetPeakRss();
+  if (!ResetPeakRss()) {
+    GTEST_SKIP() << "Resetting the peak RSS is not supported";
+  }
+  EXPECT_LT(GetPeakRss() + (kBytes / 2), peak_before);
+}
+
+TEST(MemoryUsageTest, AllocationStatsFollowTrackingMode) {
+  const auto begin = GetAllocationStats();
+  auto value = std::make_unique<std::array<char, 1000>>();
+  const auto end = GetAllocationStats();
+  ASSERT_NE(value, nullptr);
+  if (IsAllocationTrackingEnabled()) {
+    EXPECT_GE(end.count - begin.count, 1U);
+    EXPECT_GE(end.bytes - begin.bytes, 1000U);
+  } else {
+    EXPECT_EQ(end.count, 0U);
+    EXPECT_EQ(end.bytes, 0U);
+  }
+}
+
+TEST(PerfTest, CollectMemoryReportsPeakRss) {
+  auto task_ptr = std::make_shared<SleepingRunTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.collect_memory = true;
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  if (GetCurrentRss() != 0) {
+    EXPECT_GT(res.peak_rss_bytes, 0U);
+  }
+  if (!IsAllocationTrackingEnabled()) {
+    EXPECT_DOUBLE_EQ(res.alloc_count, 0.0);
+  }
+}
+
+TEST(PerfTest, MemoryIsNotCollectedByDefault) {
+  auto task_ptr = std::make_shared<SleepingRunTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 1;
+  perf.TaskRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().peak_rss_bytes, 0U);
+}
+
+TEST(PerfTest, PrintRankMemoryListsEveryRank) {
+  EXPECT_DOUBLE_EQ(SummarizeRankMemory({}).total_peak_rss, 0.0);
+  testing::internal::CaptureStdout();
+  PrintRankMemory("memory_test", PerfResults::TypeOfRunning::kPipeline, {1000.0, 3000.0});
+  const std::string output = testing::internal::GetCapturedStdout();
+  EXPECT_EQ(output, "memory_test:pipeline_memory_ranks:max_peak_rss=3000 total_peak_rss=4000 ranks=1000;3000\n");
+}
+
+TEST(PerfTest, PrintPerfStatisticKeepsLegacyLineWithSamples) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.collect_samples = true;
+  perf.PipelineRun(attr);
+
+  testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("stats_test");
+  const std::string output = testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find("stats_test:pipeline:0.0000000000\n"), std::string::npos);
+  EXPECT_NE(output.find("stats_test:pipeline_stats:min="), std::string::npos);
+}
+
+namespace {
+
+PerfRecord MakeSampleRecord() {
+  PerfRecord record;
+  record.test_name = "pipeline_sample_ns_seq_enabled";
+  record.task_namespace = "sample_ns";
+  record.technology = "seq";
+  record.mode = "pipeline";
+  record.num_proc = 2;
+  record.input_size = 128;
+  record.results.time_sec = 0.5;
+  record.results.samples = {0.25, 0.75};
+  record.rank_times = {0.5, 0.6};
+  record.rank_comm_bytes = {1024.0, 4096.0};
+  return record;
+}
+
+std::vector<std::string> ReadLines(const std::string &path) {
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+}  // namespace
+
+TEST(PerfResultWriterTest, AppendsJsonLines) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_writer_test.jsonl").string();
+  std::filesystem::remove(path);
+
+  AppendPerfRecord(MakeSampleRecord(), path);
+  AppendPerfRecord(MakeSampleRecord(), path);
+
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 2U);
+  auto json = ppc::util::InitJSONPtr();
+  *json = nlohmann::json::parse(lines[1]);
+  EXPECT_EQ((*json)["schema_version"].get<int>(), kPerfRecordSchemaVersion);
+  EXPECT_EQ((*json)["task_namespace"].get<std::string>(), "sample_ns");
+  EXPECT_EQ((*json)["num_proc"].get<int>(), 2);
+  EXPECT_EQ((*json)["samples"].size(), 2U);
+  EXPECT_EQ((*json)["rank_times"].size(), 2U);
+  EXPECT_DOUBLE_EQ((*json)["ranks"]["comm_bytes_max"].get<double>(), 4096.0);
+  std::filesystem::remove(path);
+}
+
+TEST(PerfResultWriterTest, WritesCsvHeaderOnce) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_writer_test.csv").string();
+  std::filesystem::remove(path);
+
+  AppendPerfRecord(MakeSampleRecord(), path);
+  AppendPerfRecord(MakeSampleRecord(), path);
+
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_EQ(lines[0], GetPerfRecordCsvHeader());
+  EXPECT_NE(lines[1].find(",sample_ns,seq,pipeline,2,"), std::string::npos);
+  EXPECT_NE(lines[1].find("0.2500000000;0.7500000000"), std::string::npos);
+  std::filesystem::remove(path);
+}
+
+TEST(PerfResultWriterTest, RefusesCsvWithAnotherHeader) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_writer_old.csv").string();
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << "timestamp,test_name,time_sec\n1,old,0.5\n";
+  }
+
+  EXPECT_THROW(AppendPerfRecord(MakeSampleRecord(), path), std::runtime_error);
+  EXPECT_EQ(ReadLines(path).size(), 2U);
+  std::filesystem::remove(path);
+}
+
+TEST(PerfResultWriterTest, CsvRowMatchesHeader) {
+  auto record = MakeSampleRecord();
+  record.results.hw_counters.values[0] = 10.0;
+  const auto header = GetPerfRecordCsvHeader();
+  const auto row = PerfRecordToCsv(record, GetHostInfo());
+  EXPECT_EQ(std::ranges::count(row, ','), std::ranges::count(header, ','));
+  EXPECT_TRUE(header.ends_with(",rank_comm_bytes"));
+  EXPECT_TRUE(row.ends_with(";4096.0000000000"));
+}
+
+TEST(PerfResultWriterTest, WritesThroughputOfDeclaredWorkload) {
+  auto record = MakeSampleRecord();
+  const auto header = GetPerfRecordCsvHeader();
+  EXPECT_EQ(std::ranges::count(PerfRecordToCsv(record, GetHostInfo()), ','), std::ranges::count(header, ','));
+
+  record.workload = {.bytes = 4e9, .elements = 1e9};
+  record.peaks = {.bytes_per_sec = 16e9, .flops_per_sec = 100e9};
+  record.roofline = EvaluateRoofline(record.workload, record.results.time_sec, record.peaks);
+  EXPECT_EQ(std::ranges::count(PerfRecordToCsv(record, GetHostInfo()), ','), std::ranges::count(header, ','));
+  auto json = ppc::util::InitJSONPtr();
+  *json = nlohmann::json::parse(PerfRecordToJson(record, GetHostInfo()));
+  EXPECT_DOUBLE_EQ((*json)["throughput"]["gb_per_sec"].get<double>(), 8.0);
+  EXPECT_EQ((*json)["roofline"]["bound"].get<std::string>(), "memory");
+  EXPECT_DOUBLE_EQ((*json)["roofline"]["fraction"].get<double>(), 0.5);
+}
+
+TEST(RooflineTest, PicksTheLimitingResource) {
+  const MachinePeaks peaks{.bytes_per_sec = 10e9, .flops_per_sec = 100e9};
+
+  // 1 GB in 0.2 s: memory bound, half of the 10 GB/s roofline
+  const auto stream = EvaluateRoofline({.bytes = 1e9, .elements = 1.25e8}, 0.2, peaks);
+  EXPECT_EQ(stream.bound, "memory");
+  EXPECT_DOUBLE_EQ(stream.bytes_per_sec, 5e9);
+  EXPECT_DOUBLE_EQ(stream.elements_per_sec, 6.25e8);
+  EXPECT_DOUBLE_EQ(stream.fraction, 0.5);
+
+  // 100 GFLOP over 1 GB (intensity 100) in 4 s: compute bound at a quarter of the peak
+  const auto gemm = EvaluateRoofline({.bytes = 1e9, .flops = 100e9}, 4.0, peaks);
+  EXPECT_EQ(gemm.bound, "compute");
+  EXPECT_DOUBLE_EQ(gemm.intensity, 100.0);
+  EXPECT_DOUBLE_EQ(gemm.flops_per_sec, 25e9);
+  EXPECT_DOUBLE_EQ(gemm.fraction, 0.25);
+
+  EXPECT_DOUBLE_EQ(EvaluateRoofline({.bytes = 1e9}, 0.0, peaks).fraction, 0.0);
+  EXPECT_TRUE(Workload{}.IsEmpty());
+}
+
+TEST(PerfResultWriterTest, ThrowsIfFileCannotBeOpened) {
+  EXPECT_THROW(AppendPerfRecord(MakeSampleRecord(), "/definitely/missing/dir/out.jsonl"), std::runtime_error);
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
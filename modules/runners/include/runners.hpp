@@ -12,12 +12,24 @@ namespace ppc::runners {
 class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
  public:
   UnreadMessagesDetector() = default;
-  /// @brief Called by GTest after a test ends. Checks for unread messages.
-  void OnTestEnd(const ::testing::TestInfo & /*test_info*/) override;
+  /// @brief Called by GTest before a test starts. Resets the MPI call statistics.
+  void OnTestStart(const ::testing::TestInfo & /*test_info*/) override;
+  /// @brief Called by GTest after a test ends. Prints the MPI call statistics and checks for unread messages.
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
 
  private:
 };
 
+/// @brief GTest event listener that writes the timeline trace of every test (see ppc::trace::Flush).
+/// @note Installed only when tracing is enabled (PPC_TRACE).
+class TraceWriter : public ::testing::EmptyTestEventListener {
+ public:
+  /// @brief Called by GTest before a test starts. Drops spans recorded outside of tests.
+  void OnTestStart(const ::testing::TestInfo &test_info) override;
+  /// @brief Called by GTest after a test ends. Writes the spans of the test, one file per rank.
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
+};
+
 /// @brief GTest event listener that prints additional information on test failures in worker processes.
 /// @details Includes MPI rank info in failure output for debugging.
 class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
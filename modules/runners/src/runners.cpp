@@ -15,12 +15,21 @@
 #include <string>
 #include <string_view>
 
+#include "mpi_profiler/include/mpi_profiler.hpp"
 #include "oneapi/tbb/global_control.h"
+#include "trace/include/trace.hpp"
+#include "util/include/placement.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
 
-void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/) {
+void UnreadMessagesDetector::OnTestStart(const ::testing::TestInfo & /*test_info*/) {
+  ppc::mpi_profiler::ResetCallStats();
+}
+
+void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo &test_info) {
+  ppc::mpi_profiler::PrintCallStatsSummary(std::string(test_info.test_suite_name()) + "." + test_info.name());
+
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
@@ -47,6 +56,14 @@ void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+void TraceWriter::OnTestStart(const ::testing::TestInfo & /*test_info*/) {
+  ppc::trace::Reset();
+}
+
+void TraceWriter::OnTestEnd(const ::testing::TestInfo &test_info) {
+  ppc::trace::Flush(std::string(test_info.test_suite_name()) + "." + test_info.name());
+}
+
 void WorkerTestFailurePrinter::OnTestEnd(const ::testing::TestInfo &test_info) {
   if (test_info.result()->Passed() || test_info.result()->Skipped()) {
     return;
@@ -115,6 +132,27 @@ void SyncGTestFilter() {
   ::testing::GTEST_FLAG(filter) = filter;
 }
 
+// Flushing a trace is collective (the clock offsets are measured by a ping-pong with rank 0), so a rank that traces
+// alone would wait forever: trace only if PPC_TRACE is set on every rank
+void SyncTracing() {
+  int enabled = ppc::trace::IsEnabled() ? 1 : 0;
+  int all_enabled = 0;
+  MPI_Allreduce(&enabled, &all_enabled, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  int any_enabled = 0;
+  MPI_Allreduce(&enabled, &any_enabled, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  if (all_enabled == any_enabled) {
+    return;
+  }
+  ppc::trace::SetOutputDirectory({});
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    std::cerr << "[  WARNING ] PPC_TRACE is not set on every rank (forward it, e.g. mpirun -x PPC_TRACE); tracing "
+                 "is disabled"
+              << '\n';
+  }
+}
+
 bool HasFlag(int argc, char **argv, std::string_view flag) {
   for (int i = 1; i < argc; ++i) {
     if (argv[i] != nullptr && std::string_view(argv[i]) == flag) {
@@ -124,6 +162,26 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+int GetNodeLocalRank() {
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int local_rank = 0;
+  MPI_Comm_rank(node_comm, &local_rank);
+  MPI_Comm_free(&node_comm);
+  return local_rank;
+}
+
+// Pins ranks and workers (PPC_BIND, PPC_NUMA) before the tests create any worker thread
+bool ApplyPlacementSafely(int local_rank) {
+  try {
+    ppc::util::ApplyPlacement(local_rank, ppc::util::GetNumThreads());
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return false;
+  }
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -149,12 +207,17 @@ int Init(int argc, char **argv) {
 
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  if (!ApplyPlacementSafely(GetNodeLocalRank())) {
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
 
   ::testing::InitGoogleTest(&argc, argv);
 
   // Synchronize GoogleTest internals across ranks to avoid divergence
   SyncGTestSeed();
   SyncGTestFilter();
+  SyncTracing();
 
   auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
   int rank = -1;
@@ -165,6 +228,9 @@ int Init(int argc, char **argv) {
     listeners.Append(new WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
   }
   listeners.Append(new UnreadMessagesDetector());
+  if (ppc::trace::IsEnabled()) {
+    listeners.Append(new TraceWriter());
+  }
 
   const int status = RunAllTestsSafely();
 
@@ -180,8 +246,14 @@ int Init(int argc, char **argv) {
 int SimpleInit(int argc, char **argv) {
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  if (!ApplyPlacementSafely(0)) {
+    return EXIT_FAILURE;
+  }
 
   testing::InitGoogleTest(&argc, argv);
+  if (ppc::trace::IsEnabled()) {
+    ::testing::UnitTest::GetInstance()->listeners().Append(new TraceWriter());
+  }
   return RunAllTests();
 }
 
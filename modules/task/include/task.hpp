@@ -13,9 +13,13 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <typeinfo>
 #include <util/include/util.hpp>
 #include <utility>
 
+#include "trace/include/trace.hpp"
+
 namespace ppc::task {
 
 /// @brief Represents the type of task (parallelization technology).
@@ -98,6 +102,19 @@ inline std::string GetStringTaskType(TypeOfTask type_of_task, const std::string
 
 enum class StateOfTesting : uint8_t { kFunc, kPerf };
 
+/// @brief Wall time in seconds spent in the user implementation of each pipeline stage.
+struct StageTimes {
+  double validation = 0.0;
+  double pre_processing = 0.0;
+  double run = 0.0;
+  double post_processing = 0.0;
+
+  /// @brief Returns the sum of all stages.
+  [[nodiscard]] double Total() const {
+    return validation + pre_processing + run + post_processing;
+  }
+};
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
 /// @tparam InType Input data type.
@@ -113,7 +130,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
-    return ValidationImpl();
+    return TimeStage("Validation", stage_times_.validation, [this] { return ValidationImpl(); });
   }
 
   /// @brief Performs preprocessing on the input data.
@@ -128,7 +145,7 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PreProcessingImpl();
+    return TimeStage("PreProcessing", stage_times_.pre_processing, [this] { return PreProcessingImpl(); });
   }
 
   /// @brief Executes the main logic of the task.
@@ -140,7 +157,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
-    return RunImpl();
+    return TimeStage("Run", stage_times_.run, [this] { return RunImpl(); });
   }
 
   /// @brief Performs postprocessing on the output data.
@@ -155,7 +172,7 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PostProcessingImpl();
+    return TimeStage("PostProcessing", stage_times_.post_processing, [this] { return PostProcessingImpl(); });
   }
 
   /// @brief Returns the current testing mode.
@@ -164,6 +181,11 @@ class Task {
     return state_of_testing_;
   }
 
+  /// @brief Returns the time accumulated in each stage over all pipeline runs of the task.
+  [[nodiscard]] const StageTimes &GetStageTimes() const {
+    return stage_times_;
+  }
+
   /// @brief Sets the dynamic task type.
   /// @param type_of_task Task type to set.
   void SetTypeOfTask(TypeOfTask type_of_task) {
@@ -255,12 +277,26 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
+  /// @brief Calls a stage implementation, adds its duration to total and records it as a trace span.
+  template <typename StageImpl>
+  bool TimeStage(std::string_view stage_name, double &total, StageImpl stage_impl) {
+    ppc::trace::ScopedSpan span(stage_name, "stage");
+    if (span.IsActive()) {
+      span.AddArg("task", ppc::util::GetNamespace(typeid(*this)));
+    }
+    const auto begin = std::chrono::steady_clock::now();
+    const bool result = stage_impl();
+    total += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return result;
+  }
+
   InType input_{};
   OutType output_{};
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  StageTimes stage_times_;
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -278,13 +314,15 @@ template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is moved into the task constructor, so tasks taking InType by value
+///          and moving it into GetInput() get the test data without a copy.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_shared<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
@@ -77,6 +77,20 @@ class FakeSlowTask : public TestTask<InType, OutType> {
   }
 };
 
+// Sleeps long enough to stand out from timer noise, short enough for the timing tests to stay fast
+template <typename InType, typename OutType>
+class ShortSleepTask : public TestTask<InType, OutType> {
+ public:
+  static constexpr std::chrono::milliseconds kSleep{20};
+
+  explicit ShortSleepTask(const InType &in) : TestTask<InType, OutType>(in) {}
+
+  bool RunImpl() override {
+    std::this_thread::sleep_for(kSleep);
+    return TestTask<InType, OutType>::RunImpl();
+  }
+};
+
 }  // namespace ppc::test
 
 TEST(TaskTests, CheckInt32t) {
@@ -308,6 +322,78 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+TEST(TaskTest, StageTimesAccumulateOverPipelineRuns) {
+  using SleepTask = ppc::test::ShortSleepTask<std::vector<int32_t>, int32_t>;
+  const double sleep_sec = std::chrono::duration<double>(SleepTask::kSleep).count();
+  SleepTask test_task(std::vector<int32_t>(20, 1));
+  test_task.GetStateOfTesting() = StateOfTesting::kPerf;
+  EXPECT_DOUBLE_EQ(test_task.GetStageTimes().Total(), 0.0);
+
+  std::vector<ppc::task::StageTimes> after_run;
+  for (int i = 0; i < 2; i++) {
+    test_task.Validation();
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    after_run.push_back(test_task.GetStageTimes());
+  }
+  const auto &first = after_run[0];
+  const auto &second = after_run[1];
+  EXPECT_GE(first.run, sleep_sec);
+  EXPECT_GE(second.run, first.run + sleep_sec);
+  EXPECT_GE(second.validation, first.validation);
+  EXPECT_GE(second.pre_processing, first.pre_processing);
+  EXPECT_GE(second.post_processing, first.post_processing);
+  EXPECT_DOUBLE_EQ(second.Total(), second.validation + second.pre_processing + second.run + second.post_processing);
+}
+
+TEST(TaskTest, StageTimesMeasureRunImplementation) {
+  using SleepTask = ppc::test::ShortSleepTask<std::vector<int32_t>, int32_t>;
+  SleepTask test_task(std::vector<int32_t>(20, 1));
+  test_task.GetStateOfTesting() = StateOfTesting::kPerf;
+  test_task.Validation();
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  const auto &stages = test_task.GetStageTimes();
+  EXPECT_GE(stages.run, std::chrono::duration<double>(SleepTask::kSleep).count());
+  EXPECT_LT(stages.pre_processing, stages.run);
+}
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  class MovingTask : public Task<std::vector<int32_t>, int32_t> {
+   public:
+    explicit MovingTask(std::vector<int32_t> in) {
+      GetInput() = std::move(in);
+    }
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+
+  std::vector<int32_t> in(1000, 1);
+  const auto *data = in.data();
+  auto task = ppc::task::TaskGetter<MovingTask, std::vector<int32_t>>(std::move(in));
+  EXPECT_EQ(task->GetInput().data(), data);
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+}
+
 int main(int argc, char **argv) {
+  // Under mpirun the module tests that run collectives (*MpiTest*) get an initialized MPI
+  if (ppc::util::IsUnderMpirun()) {
+    return ppc::runners::Init(argc, argv);
+  }
   return ppc::runners::SimpleInit(argc, argv);
 }
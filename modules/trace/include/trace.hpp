@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace ppc::trace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Named value attached to a span, shown in the details pane of the trace viewer.
+struct SpanArg {
+  std::string key;
+  std::variant<std::int64_t, std::string> value;
+};
+
+/// @brief Returns true if spans are recorded: PPC_TRACE names an output directory or SetOutputDirectory() was called.
+bool IsEnabled();
+
+/// @brief Overrides PPC_TRACE; an empty directory disables tracing.
+void SetOutputDirectory(const std::string &directory);
+
+/// @brief Records a finished span of the calling thread. Does nothing if tracing is disabled.
+/// @param category Category shown by the viewer ("stage" for Task stages, "mpi" for MPI calls, "user" otherwise).
+void RecordSpan(std::string_view name, std::string_view category, Clock::time_point begin, Clock::time_point end,
+                std::vector<SpanArg> args = {});
+
+/// @brief Drops the spans recorded since the last flush.
+void Reset();
+
+/// @brief Writes the spans recorded on this rank as a Chrome trace (JSON) file and drops them.
+/// @details Collective over MPI_COMM_WORLD when MPI is initialized: the ranks measure the offset of their clock to
+/// the clock of rank 0 (ping-pong through the PMPI interface, so the exchange is not traced itself) and store it in
+/// the file; scripts/merge_traces.py applies the offsets and merges the ranks into one timeline.
+/// The file is "<directory>/<label>.rank<rank>.json", with the label sanitized for use in a file name.
+/// @return Path of the written file, empty if tracing is disabled.
+std::string Flush(const std::string &label);
+
+/// @brief Records its own lifetime as a span, e.g. a user-annotated region of RunImpl():
+/// @code
+/// const ppc::trace::ScopedSpan span("exchange halo");
+/// @endcode
+/// @details Costs one flag check when tracing is disabled.
+class ScopedSpan {
+ public:
+  /// @param category Must outlive the span (a string literal).
+  explicit ScopedSpan(std::string_view name, std::string_view category = "user")
+      : active_(IsEnabled()), category_(category) {
+    if (active_) {
+      name_ = name;
+      begin_ = Clock::now();
+    }
+  }
+  ~ScopedSpan() {
+    if (active_) {
+      RecordSpan(name_, category_, begin_, Clock::now(), std::move(args_));
+    }
+  }
+
+  ScopedSpan(const ScopedSpan &) = delete;
+  ScopedSpan &operator=(const ScopedSpan &) = delete;
+  ScopedSpan(ScopedSpan &&) = delete;
+  ScopedSpan &operator=(ScopedSpan &&) = delete;
+
+  /// @brief Returns true if the span will be recorded; check it before computing expensive arguments.
+  [[nodiscard]] bool IsActive() const {
+    return active_;
+  }
+
+  void AddArg(std::string key, std::variant<std::int64_t, std::string> value) {
+    if (active_) {
+      args_.push_back({.key = std::move(key), .value = std::move(value)});
+    }
+  }
+
+ private:
+  bool active_;
+  std::string_view category_;
+  std::string name_;
+  Clock::time_point begin_;
+  std::vector<SpanArg> args_;
+};
+
+}  // namespace ppc::trace
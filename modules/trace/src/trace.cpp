@@ -0,0 +1,226 @@
+#include "trace/include/trace.hpp"
+
+#include <mpi.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::trace {
+
+namespace {
+
+constexpr int kClockSyncTag = 0x7ACE;
+constexpr int kClockSyncRounds = 8;
+
+struct Event {
+  std::string name;
+  std::string_view category;
+  int thread = 0;
+  Clock::time_point begin;
+  Clock::time_point end;
+  std::vector<SpanArg> args;
+};
+
+class Recorder {
+ public:
+  static Recorder &Instance() {
+    static Recorder recorder;
+    return recorder;
+  }
+
+  [[nodiscard]] bool IsEnabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  void SetDirectory(const std::string &directory) {
+    const std::scoped_lock lock(mutex_);
+    directory_ = directory;
+    enabled_.store(!directory_.empty(), std::memory_order_relaxed);
+  }
+
+  std::string Directory() {
+    const std::scoped_lock lock(mutex_);
+    return directory_;
+  }
+
+  void Add(Event event) {
+    const std::scoped_lock lock(mutex_);
+    events_.push_back(std::move(event));
+  }
+
+  std::vector<Event> Take() {
+    const std::scoped_lock lock(mutex_);
+    return std::exchange(events_, {});
+  }
+
+ private:
+  Recorder() : directory_(ppc::util::GetTraceDir()), enabled_(!directory_.empty()) {}
+
+  std::mutex mutex_;
+  std::string directory_;
+  std::atomic<bool> enabled_;
+  std::vector<Event> events_;
+};
+
+// Small sequential thread ids read better in the viewer than native ones
+int ThreadIndex() {
+  static std::atomic<int> next{0};
+  thread_local const int kIndex = next.fetch_add(1);
+  return kIndex;
+}
+
+double ToMicroseconds(Clock::duration duration) {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+bool IsMpiActive() {
+  int initialized = 0;
+  int finalized = 0;
+  MPI_Initialized(&initialized);
+  MPI_Finalized(&finalized);
+  return initialized != 0 && finalized == 0;
+}
+
+/// @brief Offset in microseconds to add to this rank's timestamps to express them in the clock of rank 0.
+/// @details Cristian's algorithm: every rank pings rank 0 a few times and keeps the sample with the shortest round
+/// trip, assuming the reply was taken halfway through it.
+double MeasureClockOffset(int rank, int size) {
+  double best_offset = 0.0;
+  double best_round_trip = std::numeric_limits<double>::max();
+  for (int peer = 1; peer < size; peer++) {
+    for (int round = 0; round < kClockSyncRounds; round++) {
+      if (rank == 0) {
+        char ping = 0;
+        PMPI_Recv(&ping, 1, MPI_CHAR, peer, kClockSyncTag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        const double now = ToMicroseconds(Clock::now().time_since_epoch());
+        PMPI_Send(&now, 1, MPI_DOUBLE, peer, kClockSyncTag, MPI_COMM_WORLD);
+      } else if (rank == peer) {
+        const char ping = 0;
+        double root_time = 0.0;
+        const double sent = ToMicroseconds(Clock::now().time_since_epoch());
+        PMPI_Send(&ping, 1, MPI_CHAR, 0, kClockSyncTag, MPI_COMM_WORLD);
+        PMPI_Recv(&root_time, 1, MPI_DOUBLE, 0, kClockSyncTag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        const double received = ToMicroseconds(Clock::now().time_since_epoch());
+        if (received - sent < best_round_trip) {
+          best_round_trip = received - sent;
+          best_offset = root_time - ((sent + received) / 2.0);
+        }
+      }
+    }
+  }
+  return best_offset;
+}
+
+nlohmann::json MetadataEvent(const std::string &name, int rank, int thread, const std::string &value) {
+  nlohmann::json json;
+  json["name"] = name;
+  json["ph"] = "M";
+  json["pid"] = rank;
+  json["tid"] = thread;
+  json["args"]["name"] = value;
+  return json;
+}
+
+nlohmann::json ToJson(const Event &event, int rank) {
+  nlohmann::json json;
+  json["name"] = event.name;
+  json["cat"] = std::string(event.category);
+  json["ph"] = "X";
+  json["ts"] = ToMicroseconds(event.begin.time_since_epoch());
+  json["dur"] = ToMicroseconds(event.end - event.begin);
+  json["pid"] = rank;
+  json["tid"] = event.thread;
+  for (const auto &arg : event.args) {
+    std::visit([&](const auto &value) { json["args"][arg.key] = value; }, arg.value);
+  }
+  return json;
+}
+
+}  // namespace
+
+bool IsEnabled() {
+  return Recorder::Instance().IsEnabled();
+}
+
+void SetOutputDirectory(const std::string &directory) {
+  Recorder::Instance().SetDirectory(directory);
+}
+
+void RecordSpan(std::string_view name, std::string_view category, Clock::time_point begin, Clock::time_point end,
+                std::vector<SpanArg> args) {
+  if (!IsEnabled()) {
+    return;
+  }
+  Recorder::Instance().Add({.name = std::string(name),
+                            .category = category,
+                            .thread = ThreadIndex(),
+                            .begin = begin,
+                            .end = end,
+                            .args = std::move(args)});
+}
+
+void Reset() {
+  (void)Recorder::Instance().Take();
+}
+
+std::string Flush(const std::string &label) {
+  if (!IsEnabled()) {
+    return {};
+  }
+  const auto events = Recorder::Instance().Take();
+
+  int rank = 0;
+  int size = 1;
+  double clock_offset = 0.0;
+  if (IsMpiActive()) {
+    PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    PMPI_Comm_size(MPI_COMM_WORLD, &size);
+    clock_offset = MeasureClockOffset(rank, size);
+  }
+
+  nlohmann::json trace_events = nlohmann::json::array();
+  trace_events.push_back(MetadataEvent("process_name", rank, 0, "rank " + std::to_string(rank)));
+  std::set<int> threads;
+  for (const auto &event : events) {
+    if (threads.insert(event.thread).second) {
+      const std::string thread_name = "thread " + std::to_string(event.thread);
+      trace_events.push_back(MetadataEvent("thread_name", rank, event.thread, thread_name));
+    }
+    trace_events.push_back(ToJson(event, rank));
+  }
+  nlohmann::json trace;
+  trace["traceEvents"] = std::move(trace_events);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"]["label"] = label;
+  trace["otherData"]["rank"] = rank;
+  trace["otherData"]["size"] = size;
+  trace["otherData"]["clock_offset_us"] = clock_offset;
+
+  const std::filesystem::path directory(Recorder::Instance().Directory());
+  std::filesystem::create_directories(directory);
+  const auto path = directory / (ppc::util::test::SanitizeToken(label) + ".rank" + std::to_string(rank) + ".json");
+  std::ofstream file(path);
+  file << trace.dump() << '\n';
+  if (!file) {
+    throw std::runtime_error("Failed to write trace: " + path.string());
+  }
+  return path.string();
+}
+
+}  // namespace ppc::trace
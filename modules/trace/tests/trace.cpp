@@ -0,0 +1,129 @@
+#include "trace/include/trace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::trace {
+
+namespace {
+
+class SumTask : public ppc::task::Task<std::vector<int>, int> {
+ public:
+  explicit SumTask(const std::vector<int> &in) {
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    GetOutput() = 0;
+    return true;
+  }
+  bool RunImpl() override {
+    const ScopedSpan span("accumulate");
+    for (int value : GetInput()) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+// Enables tracing into a fresh directory for the lifetime of the object
+class ScopedTraceDir {
+ public:
+  ScopedTraceDir() : path_(std::filesystem::temp_directory_path() / "ppc_trace_test") {
+    std::filesystem::remove_all(path_);
+    SetOutputDirectory(path_.string());
+    Reset();
+  }
+  ~ScopedTraceDir() {
+    SetOutputDirectory(ppc::util::GetTraceDir());
+    std::filesystem::remove_all(path_);
+  }
+
+  ScopedTraceDir(const ScopedTraceDir &) = delete;
+  ScopedTraceDir &operator=(const ScopedTraceDir &) = delete;
+  ScopedTraceDir(ScopedTraceDir &&) = delete;
+  ScopedTraceDir &operator=(ScopedTraceDir &&) = delete;
+
+ private:
+  std::filesystem::path path_;
+};
+
+const nlohmann::json *FindEvent(const nlohmann::json &trace, const std::string &name) {
+  const auto &events = trace["traceEvents"];
+  const auto it = std::ranges::find_if(events, [&](const nlohmann::json &event) {
+    return event["ph"] == "X" && event["name"] == name;
+  });
+  return it == events.end() ? nullptr : &*it;
+}
+
+}  // namespace
+
+TEST(TraceTest, DisabledTracingRecordsNothing) {
+  SetOutputDirectory("");
+  EXPECT_FALSE(IsEnabled());
+  const ScopedSpan span("ignored");
+  EXPECT_FALSE(span.IsActive());
+  EXPECT_TRUE(Flush("Disabled.Test").empty());
+  SetOutputDirectory(ppc::util::GetTraceDir());
+}
+
+TEST(TraceTest, FlushWritesStageAndUserSpans) {
+  const ScopedTraceDir trace_dir;
+  SumTask task({1, 2, 3});
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  {
+    ScopedSpan span("custom region", "user");
+    span.AddArg("items", 3);
+  }
+
+  const std::string path = Flush("Trace Suite/Test");
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(std::filesystem::path(path).filename().string(), "Trace_Suite_Test.rank0.json");
+  std::ifstream file(path);
+  const auto trace = nlohmann::json::parse(file);
+
+  EXPECT_EQ(trace["otherData"]["label"], "Trace Suite/Test");
+  EXPECT_EQ(trace["otherData"]["rank"], 0);
+  EXPECT_DOUBLE_EQ(trace["otherData"]["clock_offset_us"].get<double>(), 0.0);
+  for (const std::string stage : {"Validation", "PreProcessing", "Run", "PostProcessing"}) {
+    const auto *event = FindEvent(trace, stage);
+    ASSERT_NE(event, nullptr) << stage;
+    EXPECT_EQ((*event)["cat"], "stage");
+    EXPECT_TRUE((*event)["args"]["task"].get<std::string>().starts_with("ppc::trace"));
+    EXPECT_GE((*event)["dur"].get<double>(), 0.0);
+  }
+
+  // The user span inside RunImpl() nests in the Run stage
+  const auto *run = FindEvent(trace, "Run");
+  const auto *accumulate = FindEvent(trace, "accumulate");
+  ASSERT_NE(accumulate, nullptr);
+  EXPECT_GE((*accumulate)["ts"].get<double>(), (*run)["ts"].get<double>());
+  const auto *custom = FindEvent(trace, "custom region");
+  ASSERT_NE(custom, nullptr);
+  EXPECT_EQ((*custom)["args"]["items"], 3);
+
+  // Flushing drops the spans that were written
+  std::ifstream second(Flush("Trace Suite/Test"));
+  EXPECT_EQ(FindEvent(nlohmann::json::parse(second), "Run"), nullptr);
+}
+
+}  // namespace ppc::trace
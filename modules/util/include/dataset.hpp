@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+/// @brief Element type stored in a binary dataset.
+enum class DataType : uint8_t {
+  kInt8 = 1,
+  kUInt8,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat32,
+  kFloat64,
+};
+
+/// @brief Dataset element type of T.
+template <typename T>
+constexpr DataType GetDataType() {
+  if constexpr (std::is_same_v<T, float>) {
+    return DataType::kFloat32;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return DataType::kFloat64;
+  } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    constexpr bool kSigned = std::is_signed_v<T>;
+    if constexpr (sizeof(T) == 1) {
+      return kSigned ? DataType::kInt8 : DataType::kUInt8;
+    } else if constexpr (sizeof(T) == 4) {
+      return kSigned ? DataType::kInt32 : DataType::kUInt32;
+    } else {
+      static_assert(sizeof(T) == 8, "unsupported integer size");
+      return kSigned ? DataType::kInt64 : DataType::kUInt64;
+    }
+  } else {
+    static_assert(sizeof(T) == 0, "unsupported dataset element type");
+  }
+}
+
+/// @brief Size in bytes of one element of `type`.
+/// @throws std::runtime_error If `type` is not a known element type.
+std::size_t GetDataTypeSize(DataType type);
+
+/// @brief Metadata stored in the header of a binary dataset.
+struct DatasetHeader {
+  DataType type = DataType::kUInt8;
+  /// Dimensions, outermost first (1 to 4 of them); the first one is split between ranks.
+  std::vector<uint64_t> shape;
+  /// CRC-32 of the payload.
+  uint32_t checksum = 0;
+
+  [[nodiscard]] uint64_t Elements() const;
+  /// @brief Elements per index of the first dimension.
+  [[nodiscard]] uint64_t RowElements() const;
+};
+
+/// @brief CRC-32 (the zlib polynomial) of `data`, continuing from `crc`.
+uint32_t Crc32(std::span<const std::byte> data, uint32_t crc = 0);
+
+/// @brief Reads and validates the header of a binary dataset.
+/// @throws std::runtime_error If the file cannot be read or is not a complete dataset.
+DatasetHeader ReadDatasetHeader(const std::string &path);
+
+/// @brief Writes `payload` as a dataset of `type` elements with the given shape.
+/// @throws std::runtime_error If the shape does not match the payload or the file cannot be written.
+void WriteDataset(const std::string &path, DataType type, std::span<const std::byte> payload,
+                  std::span<const uint64_t> shape);
+
+/// @brief Writes `data` as a dataset; an empty shape means one dimension of data.size() elements.
+template <typename T>
+void WriteDataset(const std::string &path, std::span<const T> data, std::vector<uint64_t> shape = {}) {
+  if (shape.empty()) {
+    shape.push_back(data.size());
+  }
+  WriteDataset(path, GetDataType<T>(), std::as_bytes(data), shape);
+}
+
+/// @brief Whether MappedDataset::Open recomputes the payload checksum.
+enum class ChecksumCheck : uint8_t {
+  kVerify,
+  kSkip,
+};
+
+/// @brief Read-only memory mapping of a binary dataset (or of a block of its rows).
+/// @details Layout: a 64-byte little-endian header (magic "PPCDATA", version, element type, up to four dimensions,
+/// CRC-32 and size of the payload) followed by the row-major payload. Mapping pages straight from the file replaces
+/// text parsing, and OpenSlice() maps only the rows of one rank, so no rank touches the whole file.
+/// Datasets are produced with WriteDataset() or converted from text files by scripts/convert_dataset.py.
+class MappedDataset {
+ public:
+  MappedDataset() = default;
+  ~MappedDataset();
+
+  MappedDataset(const MappedDataset &) = delete;
+  MappedDataset &operator=(const MappedDataset &) = delete;
+  MappedDataset(MappedDataset &&other) noexcept;
+  MappedDataset &operator=(MappedDataset &&other) noexcept;
+
+  /// @brief Maps the whole payload.
+  /// @throws std::runtime_error If the file is not a valid dataset or, with kVerify, the checksum does not match.
+  static MappedDataset Open(const std::string &path, ChecksumCheck check = ChecksumCheck::kVerify);
+  /// @brief Maps rows [rows.begin, rows.end) of the first dimension. The checksum covers the whole payload and is
+  /// not verified here.
+  /// @throws std::runtime_error If the file is not a valid dataset or the rows are out of range.
+  static MappedDataset OpenRows(const std::string &path, PartitionRange rows);
+  /// @brief Maps the block of rows that an even BlockPartition over `parts` assigns to `part`, e.g. OpenSlice(path,
+  /// rank, world_size).
+  static MappedDataset OpenSlice(const std::string &path, int part, int parts);
+
+  [[nodiscard]] const DatasetHeader &Header() const {
+    return header_;
+  }
+  /// @brief Rows of the first dimension that are mapped.
+  [[nodiscard]] PartitionRange Rows() const {
+    return rows_;
+  }
+
+  /// @brief Mapped elements.
+  /// @throws std::runtime_error If T is not the element type of the dataset.
+  template <typename T>
+  [[nodiscard]] std::span<const T> View() const {
+    if (GetDataType<T>() != header_.type) {
+      throw std::runtime_error("MappedDataset: requested element type does not match the dataset");
+    }
+    return {reinterpret_cast<const T *>(data_), size_ / sizeof(T)};  // NOLINT(*-reinterpret-cast)
+  }
+
+ private:
+  void Release();
+
+  DatasetHeader header_;
+  PartitionRange rows_;
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  void *mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::vector<std::byte> copy_;
+};
+
+}  // namespace ppc::util
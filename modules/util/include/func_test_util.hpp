@@ -13,6 +13,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "performance/include/memory_usage.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
@@ -98,15 +99,31 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
   }
 
   /// @brief Executes the full task pipeline with validation.
+  /// @details The memory used by the pipeline is attached to the test as the peak_rss (and, with
+  ///          USE_ALLOC_TRACKING, allocs/alloc_bytes) properties of the gtest XML/JSON report.
   // NOLINTNEXTLINE(readability-function-cognitive-complexity)
   void ExecuteTaskPipeline() {
+    ppc::performance::ResetPeakRss();
+    const auto allocs_begin = ppc::performance::GetAllocationStats();
     EXPECT_TRUE(task_->Validation());
     EXPECT_TRUE(task_->PreProcessing());
     EXPECT_TRUE(task_->Run());
     EXPECT_TRUE(task_->PostProcessing());
+    RecordMemoryUsage(allocs_begin);
     EXPECT_TRUE(CheckTestOutputData(task_->GetOutput()));
   }
 
+  static void RecordMemoryUsage(const ppc::performance::AllocationStats &allocs_begin) {
+    if (const auto peak_rss = ppc::performance::GetPeakRss(); peak_rss != 0) {
+      ::testing::Test::RecordProperty("peak_rss", std::to_string(peak_rss));
+    }
+    if (ppc::performance::IsAllocationTrackingEnabled()) {
+      const auto allocs_end = ppc::performance::GetAllocationStats();
+      ::testing::Test::RecordProperty("allocs", std::to_string(allocs_end.count - allocs_begin.count));
+      ::testing::Test::RecordProperty("alloc_bytes", std::to_string(allocs_end.bytes - allocs_begin.bytes));
+    }
+  }
+
  private:
   ppc::task::TaskPtr<InType, OutType> task_;
 };
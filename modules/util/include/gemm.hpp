@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace ppc::util {
+
+/// @brief Implementation of Gemm().
+enum class GemmKernel : uint8_t {
+  /// Untiled triple loop, for checking results and measuring what blocking gains.
+  kReference,
+  /// Cache-blocked with packed panels and a portable 4 x 8 register tile.
+  kScalar,
+  /// Cache-blocked with a 6 x 8 AVX2/FMA register tile.
+  kAvx2,
+  /// Cache-blocked with an 8 x 16 AVX-512 register tile.
+  kAvx512,
+};
+
+/// @brief Whether the CPU (and the compiler) can run `kernel`; kReference and kScalar always run.
+bool IsGemmKernelSupported(GemmKernel kernel);
+
+/// @brief Kernel Gemm() uses by default: PPC_GEMM_KERNEL ("reference", "scalar", "avx2" or "avx512") if it is set,
+/// the fastest supported one otherwise.
+/// @throws std::runtime_error If PPC_GEMM_KERNEL names an unknown kernel or one the CPU cannot run.
+GemmKernel GetGemmKernel();
+
+std::string_view ToString(GemmKernel kernel);
+
+/// @brief C = A * B for row-major double matrices: A is m x k, B is k x n, C is m x n; C is overwritten.
+/// @details Element (i, j) of A is a[i * lda + j], and likewise for B and C, so blocks of larger matrices can be
+/// multiplied in place. The blocked kernels pack a k-panel of B and a block of rows of A into contiguous buffers
+/// sized for the L2 and L1 caches and run a register-tiled micro-kernel over them; the result matches the reference
+/// up to rounding, since the additions are reordered.
+/// @throws std::runtime_error If `kernel` is not supported on this CPU.
+void Gemm(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+          std::size_t ldb, double *c, std::size_t ldc, GemmKernel kernel);
+
+/// @brief Gemm() with the kernel GetGemmKernel() returns on the first call; PPC_GEMM_KERNEL is read only once.
+void Gemm(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+          std::size_t ldb, double *c, std::size_t ldc);
+
+/// @brief C += A * B with the layout of Gemm(), e.g. to sum the products of the k-panels of a distributed matrix.
+/// @throws std::runtime_error If `kernel` is not supported on this CPU.
+void GemmAccumulate(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                    std::size_t ldb, double *c, std::size_t ldc, GemmKernel kernel);
+
+/// @brief GemmAccumulate() with the same default kernel as Gemm().
+void GemmAccumulate(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                    std::size_t ldb, double *c, std::size_t ldc);
+
+/// @brief Gemm() of contiguous matrices (lda = k, ldb = ldc = n).
+/// @throws std::runtime_error If a span is smaller than its matrix.
+void Gemm(std::size_t m, std::size_t n, std::size_t k, std::span<const double> a, std::span<const double> b,
+          std::span<double> c);
+
+}  // namespace ppc::util
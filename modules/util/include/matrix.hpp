@@ -0,0 +1,211 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+/// @brief Allocator that aligns every allocation to `Alignment` bytes (a cache line by default).
+template <typename T, std::size_t Alignment = kCacheLineSize>
+struct AlignedAllocator {
+  using value_type = T;
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  template <typename U>
+  struct rebind {  // NOLINT(readability-identifier-naming)
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  T *allocate(std::size_t n) {  // NOLINT(readability-identifier-naming)
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+  void deallocate(T *ptr, std::size_t /*n*/) noexcept {  // NOLINT(readability-identifier-naming)
+    ::operator delete(ptr, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> & /*other*/) const noexcept {
+    return true;
+  }
+};
+
+/// @brief Whether rows of a Matrix are padded to whole cache lines.
+enum class RowPadding : uint8_t {
+  /// Rows follow each other without gaps (stride == cols).
+  kNone,
+  /// Every row starts on a cache line; avoids false sharing between threads writing neighbouring rows.
+  kCacheLine,
+};
+
+/// @brief View of elements spaced `stride` apart, e.g. a matrix column.
+template <typename T>
+class StridedView {
+ public:
+  StridedView(T *data, std::size_t size, std::size_t stride) : data_(data), size_(size), stride_(stride) {}
+
+  [[nodiscard]] T &operator[](std::size_t index) const {
+    return data_[index * stride_];
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+  [[nodiscard]] std::size_t Stride() const {
+    return stride_;
+  }
+
+ private:
+  T *data_;
+  std::size_t size_;
+  std::size_t stride_;
+};
+
+/// @brief Dense row-major matrix in one cache-line aligned allocation.
+/// @details Element (i, j) is at Data()[i * Stride() + j]. Without padding the storage is exactly Rows() * Cols()
+/// elements, so whole matrices and row blocks can be passed to MPI as plain buffers; padded rows are described by
+/// RowType().
+template <typename T>
+class Matrix {
+ public:
+  Matrix() = default;
+  Matrix(std::size_t rows, std::size_t cols, const T &value = T{}, RowPadding padding = RowPadding::kNone)
+      : rows_(rows), cols_(cols), stride_(GetStride(cols, padding)), data_(rows * stride_, value) {}
+
+  /// @brief Copies a vector-of-rows matrix.
+  /// @throws std::runtime_error If the rows have different lengths.
+  static Matrix FromRows(const std::vector<std::vector<T>> &rows, RowPadding padding = RowPadding::kNone) {
+    const std::size_t cols = rows.empty() ? 0 : rows.front().size();
+    Matrix matrix(rows.size(), cols, T{}, padding);
+    for (std::size_t i = 0; i < rows.size(); i++) {
+      if (rows[i].size() != cols) {
+        throw std::runtime_error("Matrix::FromRows: rows have different lengths");
+      }
+      std::ranges::copy(rows[i], matrix.Row(i).begin());
+    }
+    return matrix;
+  }
+
+  /// @brief Copies the matrix into a vector of rows.
+  [[nodiscard]] std::vector<std::vector<T>> ToRows() const {
+    std::vector<std::vector<T>> rows(rows_);
+    for (std::size_t i = 0; i < rows_; i++) {
+      const auto row = Row(i);
+      rows[i].assign(row.begin(), row.end());
+    }
+    return rows;
+  }
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+  /// @brief Distance in elements between the starts of consecutive rows (>= Cols()).
+  [[nodiscard]] std::size_t Stride() const {
+    return stride_;
+  }
+  [[nodiscard]] bool Empty() const {
+    return rows_ == 0 || cols_ == 0;
+  }
+  [[nodiscard]] bool IsPadded() const {
+    return stride_ != cols_;
+  }
+
+  [[nodiscard]] T *Data() {
+    return data_.data();
+  }
+  [[nodiscard]] const T *Data() const {
+    return data_.data();
+  }
+
+  [[nodiscard]] T &operator()(std::size_t row, std::size_t col) {
+    return data_[(row * stride_) + col];
+  }
+  [[nodiscard]] const T &operator()(std::size_t row, std::size_t col) const {
+    return data_[(row * stride_) + col];
+  }
+
+  [[nodiscard]] std::span<T> Row(std::size_t row) {
+    return {data_.data() + (row * stride_), cols_};
+  }
+  [[nodiscard]] std::span<const T> Row(std::size_t row) const {
+    return {data_.data() + (row * stride_), cols_};
+  }
+  [[nodiscard]] StridedView<T> Col(std::size_t col) {
+    return {data_.data() + col, rows_, stride_};
+  }
+  [[nodiscard]] StridedView<const T> Col(std::size_t col) const {
+    return {data_.data() + col, rows_, stride_};
+  }
+
+  /// @brief MPI datatype of one row whose extent is the stride, so `n` rows starting at &m(i, 0) are n * RowType().
+  [[nodiscard]] MpiDatatype RowType() const {
+    MPI_Datatype row = MPI_DATATYPE_NULL;
+    MPI_Type_contiguous(static_cast<int>(cols_), GetElementType(), &row);
+    return Resized(row, stride_);
+  }
+  /// @brief MPI datatype of one column whose extent is one element, so `n` neighbouring columns starting at
+  /// &m(0, j) are n * ColumnType().
+  [[nodiscard]] MpiDatatype ColumnType() const {
+    MPI_Datatype col = MPI_DATATYPE_NULL;
+    MPI_Type_vector(static_cast<int>(rows_), 1, static_cast<int>(stride_), GetElementType(), &col);
+    return Resized(col, 1);
+  }
+
+  /// @brief Compares dimensions and elements; padding is ignored.
+  friend bool operator==(const Matrix &lhs, const Matrix &rhs) {
+    if (lhs.rows_ != rhs.rows_ || lhs.cols_ != rhs.cols_) {
+      return false;
+    }
+    for (std::size_t i = 0; i < lhs.rows_; i++) {
+      if (!std::ranges::equal(lhs.Row(i), rhs.Row(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static std::size_t GetStride(std::size_t cols, RowPadding padding) {
+    if (padding == RowPadding::kNone) {
+      return cols;
+    }
+    const std::size_t granule = CacheLineGranule<T>();
+    return (cols + granule - 1) / granule * granule;
+  }
+
+  static MPI_Datatype GetElementType() {
+    const MPI_Datatype type = GetMpiType<T>();
+    if (type == MPI_DATATYPE_NULL) {
+      throw std::runtime_error("Matrix: element type has no MPI datatype");
+    }
+    return type;
+  }
+
+  static MpiDatatype Resized(MPI_Datatype type, std::size_t extent_elements) {
+    MPI_Datatype resized = MPI_DATATYPE_NULL;
+    MPI_Type_create_resized(type, 0, static_cast<MPI_Aint>(extent_elements * sizeof(T)), &resized);
+    MPI_Type_free(&type);
+    return MpiDatatype(resized);
+  }
+
+  std::size_t rows_ = 0;
+  std::size_t cols_ = 0;
+  std::size_t stride_ = 0;
+  std::vector<T, AlignedAllocator<T>> data_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace ppc::util {
+
+/// @brief MPI datatype of an arithmetic type, MPI_DATATYPE_NULL for anything else.
+template <typename T>
+MPI_Datatype GetMpiType() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return MPI_C_BOOL;
+  } else if constexpr (std::is_same_v<T, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<T, long double>) {
+    return MPI_LONG_DOUBLE;
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    switch (sizeof(T)) {
+      case 1:
+        return MPI_INT8_T;
+      case 2:
+        return MPI_INT16_T;
+      case 4:
+        return MPI_INT32_T;
+      default:
+        return MPI_INT64_T;
+    }
+  } else if constexpr (std::is_integral_v<T>) {
+    switch (sizeof(T)) {
+      case 1:
+        return MPI_UINT8_T;
+      case 2:
+        return MPI_UINT16_T;
+      case 4:
+        return MPI_UINT32_T;
+      default:
+        return MPI_UINT64_T;
+    }
+  } else {
+    return MPI_DATATYPE_NULL;
+  }
+}
+
+/// @brief Owning handle of a derived MPI datatype: commits it on construction and frees it on destruction.
+class MpiDatatype {
+ public:
+  MpiDatatype() = default;
+  explicit MpiDatatype(MPI_Datatype type) : type_(type) {
+    MPI_Type_commit(&type_);
+  }
+  ~MpiDatatype() {
+    // Handles that outlive MPI_Finalize (e.g. static ones) are released with the library
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (type_ != MPI_DATATYPE_NULL && finalized == 0) {
+      MPI_Type_free(&type_);
+    }
+  }
+
+  MpiDatatype(const MpiDatatype &) = delete;
+  MpiDatatype &operator=(const MpiDatatype &) = delete;
+  MpiDatatype(MpiDatatype &&other) noexcept : type_(std::exchange(other.type_, MPI_DATATYPE_NULL)) {}
+  MpiDatatype &operator=(MpiDatatype &&other) noexcept {
+    std::swap(type_, other.type_);
+    return *this;
+  }
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+};
+
+}  // namespace ppc::util
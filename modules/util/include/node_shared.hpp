@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief How NodeSharedBuffer hands the root's data to the other ranks.
+enum class InputDistribution : uint8_t {
+  /// Every rank receives a private copy with MPI_Bcast.
+  kBroadcast,
+  /// One copy per node in an MPI_Win_allocate_shared window, mapped read-only by all ranks of the node.
+  kNodeShared,
+};
+
+/// @brief Distribution selected by PPC_SHARED_INPUT: kNodeShared when it is set to a non-zero value.
+inline InputDistribution GetInputDistribution() {
+  return IsNodeSharedInputEnabled() ? InputDistribution::kNodeShared : InputDistribution::kBroadcast;
+}
+
+/// @brief Read-only copy of a buffer of the root rank, available on every rank of a communicator.
+/// @details In kNodeShared mode the ranks of each node (MPI_Comm_split_type with MPI_COMM_TYPE_SHARED) share one
+/// window: only the node leaders receive the data, so memory per node does not grow with the number of ranks and
+/// intra-node ranks copy nothing. In kBroadcast mode the root views its own data without copying it, so the root's
+/// buffer must outlive the NodeSharedBuffer.
+/// Construction and destruction are collective over the communicator.
+class NodeSharedBuffer {
+ public:
+  NodeSharedBuffer() = default;
+  /// @param root_data Bytes to share, significant on the root only.
+  NodeSharedBuffer(std::span<const std::byte> root_data, int root, MPI_Comm comm, InputDistribution distribution);
+  ~NodeSharedBuffer();
+
+  NodeSharedBuffer(const NodeSharedBuffer &) = delete;
+  NodeSharedBuffer &operator=(const NodeSharedBuffer &) = delete;
+  NodeSharedBuffer(NodeSharedBuffer &&other) noexcept;
+  NodeSharedBuffer &operator=(NodeSharedBuffer &&other) noexcept;
+
+  /// @brief Shares the elements of the root's `data` with every rank of `comm`.
+  template <typename T>
+  static NodeSharedBuffer FromRoot(std::span<const T> data, int root = 0, MPI_Comm comm = MPI_COMM_WORLD,
+                                   InputDistribution distribution = GetInputDistribution()) {
+    static_assert(std::is_trivially_copyable_v<T>, "shared data is copied as raw bytes");
+    return {std::as_bytes(data), root, comm, distribution};
+  }
+  template <typename T>
+  static NodeSharedBuffer FromRoot(const std::vector<T> &data, int root = 0, MPI_Comm comm = MPI_COMM_WORLD,
+                                   InputDistribution distribution = GetInputDistribution()) {
+    return FromRoot(std::span<const T>(data), root, comm, distribution);
+  }
+
+  /// @brief Shared data as elements of type T.
+  template <typename T>
+  [[nodiscard]] std::span<const T> View() const {
+    return {reinterpret_cast<const T *>(data_), size_ / sizeof(T)};  // NOLINT(*-reinterpret-cast)
+  }
+  [[nodiscard]] std::size_t SizeBytes() const {
+    return size_;
+  }
+  [[nodiscard]] bool IsNodeShared() const {
+    return window_ != MPI_WIN_NULL;
+  }
+
+ private:
+  void Release();
+
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::vector<std::byte> copy_;
+  MPI_Win window_ = MPI_WIN_NULL;
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Cache line size assumed when aligning block boundaries.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/// @brief Number of T elements in a cache line.
+/// @details Used as the granule of a BlockPartition, it keeps the blocks of different ranks or threads on different
+/// cache lines (provided the buffer itself is cache-line aligned).
+template <typename T>
+constexpr std::size_t CacheLineGranule() {
+  return std::max<std::size_t>(1, kCacheLineSize / sizeof(T));
+}
+
+/// @brief Half-open range [begin, end) of elements assigned to one part.
+struct PartitionRange {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+
+  [[nodiscard]] std::size_t Size() const {
+    return end - begin;
+  }
+  [[nodiscard]] bool Contains(std::size_t index) const {
+    return index >= begin && index < end;
+  }
+};
+
+/// @brief Split of `total` elements into contiguous blocks, one per part (rank or thread).
+/// @details Blocks follow each other in part order. Every block boundary except the end of the data is a multiple
+/// of the granule, so with a granule of CacheLineGranule<T>() no two parts share a cache line.
+class BlockPartition {
+ public:
+  /// @brief Even partition: block sizes differ by at most one granule, the first parts get the larger blocks.
+  /// @throws std::runtime_error If `parts` or `granule` is not positive.
+  BlockPartition(std::size_t total, int parts, std::size_t granule = 1);
+
+  /// @brief Partition with block sizes proportional to `weights` (e.g. relative speeds of the ranks).
+  /// @throws std::runtime_error If the weights are empty, negative, non-finite or all zero, or `granule` is zero.
+  static BlockPartition Weighted(std::size_t total, std::span<const double> weights, std::size_t granule = 1);
+
+  /// @brief Partition of rows with uneven costs, e.g. the vertices of a graph balanced by their edges.
+  /// @param cost_prefix Prefix sums of the row costs: rows + 1 non-decreasing values starting at 0, such as the row
+  /// offsets of a CRS matrix. Part p ends at the first row boundary whose cost reaches (p + 1) / parts of the total.
+  /// @throws std::runtime_error If `parts` is not positive or the prefix sums are empty, do not start at 0 or decrease.
+  static BlockPartition Balanced(std::span<const std::int64_t> cost_prefix, int parts);
+
+  /// @brief Partition with the given block boundaries, e.g. received from the rank that computed a Balanced one.
+  /// @param boundaries parts + 1 non-decreasing values starting at 0; the last one is the total.
+  /// @throws std::runtime_error If there are fewer than two boundaries, the first is not 0 or they decrease.
+  static BlockPartition FromBoundaries(std::vector<std::size_t> boundaries);
+
+  [[nodiscard]] int Parts() const {
+    return static_cast<int>(offsets_.size()) - 1;
+  }
+  [[nodiscard]] std::size_t Total() const {
+    return offsets_.back();
+  }
+  [[nodiscard]] std::size_t Begin(int part) const {
+    return offsets_[static_cast<std::size_t>(part)];
+  }
+  [[nodiscard]] std::size_t End(int part) const {
+    return offsets_[static_cast<std::size_t>(part) + 1];
+  }
+  [[nodiscard]] std::size_t Count(int part) const {
+    return End(part) - Begin(part);
+  }
+  [[nodiscard]] PartitionRange Range(int part) const {
+    return {.begin = Begin(part), .end = End(part)};
+  }
+
+  /// @brief Part that owns element `index` (< Total()).
+  /// @details O(1) for even partitions, a binary search over the parts for weighted ones.
+  [[nodiscard]] int Owner(std::size_t index) const;
+
+  /// @brief MPI counts of all parts, each block size multiplied by `scale` (e.g. the row length for row blocks).
+  /// @throws std::runtime_error If a value does not fit into int.
+  [[nodiscard]] std::vector<int> Counts(std::size_t scale = 1) const;
+  /// @brief MPI displacements of all parts, multiplied by `scale` like Counts.
+  /// @throws std::runtime_error If a value does not fit into int.
+  [[nodiscard]] std::vector<int> Displs(std::size_t scale = 1) const;
+
+ private:
+  BlockPartition() = default;
+
+  std::vector<std::size_t> offsets_;
+  std::size_t granule_ = 1;
+  // Even partitions only: the first `remainder_units_` parts hold `base_units_ + 1` granules, the rest `base_units_`
+  bool even_ = false;
+  std::size_t base_units_ = 0;
+  std::size_t remainder_units_ = 0;
+};
+
+}  // namespace ppc::util
@@ -7,25 +7,120 @@
 #include <csignal>
 #include <cstddef>
 #include <functional>
+#include <iostream>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
+#include "mpi_profiler/include/mpi_profiler.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/result_writer.hpp"
+#include "performance/include/roofline.hpp"
 #include "task/include/task.hpp"
+#include "util/include/placement.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
 
 double GetTimeMPI();
 int GetMPIRank();
+int GetMPISize();
+/// @brief Gathers one value from every rank on rank 0.
+/// @return Values indexed by rank on rank 0, an empty vector on other ranks.
+std::vector<double> GatherRankValues(double value);
+/// @brief Maximum of the value over the ranks of MPI_COMM_WORLD, on every rank.
+double MaxOverRanks(double value);
+/// @brief Gathers one string from every rank on rank 0.
+/// @return Strings indexed by rank on rank 0, an empty vector on other ranks.
+std::vector<std::string> GatherRankStrings(const std::string &value);
+/// @brief Peaks of the resources of a perf run: num_threads threads per rank, summed over the ranks of
+/// MPI_COMM_WORLD if sum_over_ranks is set, of this rank otherwise.
+/// @details Collective: all ranks measure at the same time, so they share the memory bandwidth as the task does.
+/// Measured once per process for each combination and cached.
+ppc::performance::MachinePeaks GetMachinePeaks(int num_threads, bool sum_over_ranks);
 
+/// @brief Returns the number of elements of a sized-range input, 0 for other input types.
+template <typename InType>
+std::size_t GetInputSize(const InType &input) {
+  if constexpr (std::ranges::sized_range<InType>) {
+    return static_cast<std::size_t>(std::ranges::size(input));
+  } else {
+    return 0;
+  }
+}
+
+/// @brief Returns the number of bytes held by the input, following nested ranges and tuple-like members.
+template <typename T>
+std::size_t GetInputBytes(const T &input) {
+  if constexpr (std::ranges::range<T>) {
+    using ValueType = std::ranges::range_value_t<T>;
+    if constexpr (std::ranges::contiguous_range<T> && std::is_trivially_copyable_v<ValueType>) {
+      return static_cast<std::size_t>(std::ranges::size(input)) * sizeof(ValueType);
+    } else {
+      std::size_t bytes = 0;
+      for (const auto &element : input) {
+        bytes += GetInputBytes(element);
+      }
+      return bytes;
+    }
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    return std::apply([](const auto &...elements) { return (std::size_t{0} + ... + GetInputBytes(elements)); }, input);
+  } else {
+    return sizeof(T);
+  }
+}
+
+/// @brief Collects the data pointers of the contiguous buffers of the input (top level and tuple-like members).
+/// @details Comparing the pointers before and after the task is created tells whether the buffers were moved.
+template <typename T>
+void CollectInputBuffers(const T &input, std::vector<const void *> &buffers) {
+  if constexpr (std::ranges::contiguous_range<T>) {
+    if (!std::ranges::empty(input)) {
+      buffers.push_back(std::ranges::data(input));
+    }
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    std::apply([&buffers](const auto &...elements) { (CollectInputBuffers(elements, buffers), ...); }, input);
+  }
+}
+
+/// @brief Collects the bytes of the contiguous, trivially copyable buffers of the input (top level and tuple-like
+/// members), e.g. to place their pages on NUMA nodes.
+template <typename T>
+void CollectInputRegions(const T &input, std::vector<std::span<const std::byte>> &regions) {
+  if constexpr (std::ranges::contiguous_range<T>) {
+    if constexpr (std::is_trivially_copyable_v<std::ranges::range_value_t<T>>) {
+      if (!std::ranges::empty(input)) {
+        regions.push_back(std::as_bytes(std::span(std::ranges::data(input), std::ranges::size(input))));
+      }
+    }
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    std::apply([&regions](const auto &...elements) { (CollectInputRegions(elements, regions), ...); }, input);
+  }
+}
+
+/// @brief Size of the test input and the memory saved by moving it into the task.
+struct InputFootprint {
+  /// @brief Number of elements of a sized-range input, 0 for other input types.
+  std::size_t size = 0;
+  std::size_t bytes = 0;
+  /// @brief Bytes handed over to the task without a copy (0 if the task copied the input).
+  std::size_t saved_bytes = 0;
+};
+
+/// @brief Parameter of one perf case: task getter, name, type of running and problem size (0 if unsized).
 template <typename InType, typename OutType>
 using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
-                                 ppc::performance::PerfResults::TypeOfRunning>;
+                                 ppc::performance::PerfResults::TypeOfRunning, std::size_t>;
+
+/// @brief Problem sizes a perf test declares; one perf case is generated per size.
+using PerfSizes = std::vector<std::size_t>;
 
 template <typename InType, typename OutType>
 /// @brief Base class for performance testing of parallel tasks.
@@ -43,13 +138,36 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
  protected:
   virtual bool CheckTestOutputData(OutType &output_data) = 0;
   /// @brief Supplies input data for performance testing.
+  /// @details Size-parameterized tests generate the input for GetProblemSize().
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Problem size of the current perf case, 0 for tests created without sizes.
+  [[nodiscard]] std::size_t GetProblemSize() const {
+    return std::get<static_cast<std::size_t>(GTestParamIndex::kProblemSize)>(this->GetParam());
+  }
+
+  /// @brief Work done by one run of the task on the input, for throughput and roofline reporting.
+  /// @details Override to declare bytes moved, floating-point operations and elements processed; the default
+  /// declares nothing and no throughput is reported.
+  virtual ppc::performance::Workload GetWorkload(const InType & /*input*/) {
+    return {};
+  }
+
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
+    perf_attrs.collect_samples = true;
+    perf_attrs.collect_hw_counters = true;
+    perf_attrs.collect_memory = true;
+    perf_attrs.comm_timer = ppc::mpi_profiler::GetCommTime;
+    ppc::mpi_profiler::SetCommBytesEnabled(true);
+    perf_attrs.comm_bytes_counter = [] { return static_cast<double>(ppc::mpi_profiler::GetCommBytes()); };
+    perf_attrs.num_warmup = GetPerfWarmup();
+    perf_attrs.max_cv = GetPerfMaxCv();
     if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
         task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
       const double t0 = GetTimeMPI();
       perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
+      // All ranks re-run until the noisiest one is stable, so their collectives stay matched
+      perf_attrs.combine_cv = MaxOverRanks;
     } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
       const double t0 = omp_get_wtime();
       perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
@@ -79,7 +197,23 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
-    task_ = task_getter(GetTestInputData());
+    auto input_data = GetTestInputData();
+    const auto workload = GetWorkload(input_data);
+    InputFootprint input{.size = GetInputSize(input_data), .bytes = GetInputBytes(input_data)};
+    std::vector<const void *> input_buffers;
+    CollectInputBuffers(input_data, input_buffers);
+    task_ = task_getter(std::move(input_data));
+    std::vector<const void *> task_buffers;
+    CollectInputBuffers(task_->GetInput(), task_buffers);
+    if (!input_buffers.empty() && task_buffers == input_buffers) {
+      input.saved_bytes = input.bytes;
+    }
+    // Move the input pages where PPC_NUMA wants them before they are measured
+    std::vector<std::span<const std::byte>> input_regions;
+    CollectInputRegions(task_->GetInput(), input_regions);
+    for (const auto region : input_regions) {
+      PlaceBuffer(region);
+    }
     ppc::performance::Perf perf(task_);
     ppc::performance::PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
@@ -94,8 +228,34 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
       throw std::runtime_error(err_msg.str().c_str());
     }
 
+    const auto perf_results = perf.GetPerfResults();
+    const auto rank_times = GatherRankValues(perf_results.time_sec);
+    const auto rank_comm_times = GatherRankValues(perf_results.comm_time_sec);
+    const auto rank_comm_bytes = GatherRankValues(perf_results.comm_bytes);
+    const auto rank_peak_rss = GatherRankValues(static_cast<double>(perf_results.peak_rss_bytes));
+    const auto rank_cpus = GatherRankStrings(FormatCpuList(GetPlacement().cpus));
+    ppc::performance::MachinePeaks peaks;
+    if (!workload.IsEmpty()) {
+      peaks = GetTaskPeaks();
+    }
     if (GetMPIRank() == 0) {
+      WritePerfRecord(test_name, perf_results, rank_times, rank_comm_times, rank_comm_bytes, rank_peak_rss, rank_cpus,
+                      input, workload, peaks);
       perf.PrintPerfStatistic(test_name);
+      std::cout << test_name << ":" << ppc::performance::GetStringParamName(mode) << "_input:bytes=" << input.bytes
+                << " saved_bytes=" << input.saved_bytes << '\n';
+      if (rank_times.size() > 1) {
+        ppc::performance::PrintRankSummary(
+            test_name, mode, ppc::performance::SummarizeRanks(rank_times, rank_comm_times, rank_comm_bytes));
+        if (perf_results.peak_rss_bytes != 0) {
+          ppc::performance::PrintRankMemory(test_name, mode, rank_peak_rss);
+        }
+      }
+      if (!workload.IsEmpty()) {
+        ppc::performance::PrintRoofline(test_name, mode,
+                                        ppc::performance::EvaluateRoofline(workload, perf_results.time_sec, peaks),
+                                        peaks);
+      }
     }
 
     OutType output_data = task_->GetOutput();
@@ -103,18 +263,74 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   }
 
  private:
+  /// @brief Peaks of what the task may use: one thread for SEQ and MPI tasks, PPC_NUM_THREADS for the others; the
+  /// ranks of MPI and ALL tasks work on one problem, so their peaks add up.
+  ppc::performance::MachinePeaks GetTaskPeaks() {
+    const auto type = task_->GetDynamicTypeOfTask();
+    const bool multithreaded = type != ppc::task::TypeOfTask::kSEQ && type != ppc::task::TypeOfTask::kMPI;
+    const bool distributed = type == ppc::task::TypeOfTask::kMPI || type == ppc::task::TypeOfTask::kALL;
+    return GetMachinePeaks(multithreaded ? GetNumThreads() : 1, distributed);
+  }
+
+  /// @brief Appends the measurement to the file from PPC_PERF_OUTPUT, if it is set.
+  void WritePerfRecord(const std::string &test_name, const ppc::performance::PerfResults &perf_results,
+                       const std::vector<double> &rank_times, const std::vector<double> &rank_comm_times,
+                       const std::vector<double> &rank_comm_bytes, const std::vector<double> &rank_peak_rss,
+                       const std::vector<std::string> &rank_cpus,
+                       const InputFootprint &input, const ppc::performance::Workload &workload,
+                       const ppc::performance::MachinePeaks &peaks) {
+    const auto output_path = GetPerfOutputPath();
+    if (output_path.empty()) {
+      return;
+    }
+    const auto &task_ref = *task_;
+    ppc::performance::PerfRecord record;
+    record.test_name = test_name;
+    record.task_namespace = GetNamespace(typeid(task_ref));
+    record.technology = ppc::task::TypeOfTaskToString(task_->GetDynamicTypeOfTask());
+    record.mode = ppc::performance::GetStringParamName(perf_results.type_of_running);
+    record.num_proc = GetMPISize();
+    record.num_threads = GetNumThreads();
+    record.input_size = input.size;
+    record.problem_size = GetProblemSize();
+    record.input_bytes = input.bytes;
+    record.input_saved_bytes = input.saved_bytes;
+    record.results = perf_results;
+    record.rank_times = rank_times;
+    record.rank_comm_times = rank_comm_times;
+    record.rank_comm_bytes = rank_comm_bytes;
+    record.rank_peak_rss = rank_peak_rss;
+    const auto &placement = GetPlacement();
+    record.bind = ToString(placement.bind);
+    record.numa = ToString(placement.numa);
+    record.numa_nodes = placement.numa_nodes;
+    record.rank_cpus = rank_cpus;
+    record.workload = workload;
+    record.peaks = peaks;
+    record.roofline = ppc::performance::EvaluateRoofline(workload, perf_results.time_sec, peaks);
+    ppc::performance::AppendPerfRecord(record, output_path);
+  }
+
   ppc::task::TaskPtr<InType, OutType> task_;
 };
 
+/// @brief Creates the pipeline and task_run cases of a task; a non-empty variant is appended to the name as
+/// "_<variant>", then a non-zero size as "_size<N>".
 template <typename TaskType, typename InputType>
-auto MakePerfTaskTuples(const std::string &settings_path) {
-  const auto name = std::string(GetNamespace<TaskType>()) + "_" +
-                    ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
+auto MakePerfTaskTuples(const std::string &settings_path, std::size_t size = 0, const std::string &variant = {}) {
+  auto name = std::string(GetNamespace<TaskType>()) + "_" +
+              ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
+  if (!variant.empty()) {
+    name += "_" + variant;
+  }
+  if (size != 0) {
+    name += "_size" + std::to_string(size);
+  }
 
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline),
+                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline, size),
                          std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
+                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun, size));
 }
 
 template <typename Tuple, std::size_t... I>
@@ -128,9 +344,31 @@ auto TupleToGTestValues(Tuple &&tup) {
   return TupleToGTestValuesImpl(std::forward<Tuple>(tup), std::make_index_sequence<kSize>{});
 }
 
+/// @brief Converts the cases of a size-parameterized test into gtest values.
+template <typename Param>
+auto TupleToGTestValues(const std::vector<Param> &params) {
+  return ::testing::ValuesIn(params);
+}
+
 template <typename InputType, typename... TaskTypes>
 auto MakeAllPerfTasks(const std::string &settings_path) {
   return std::tuple_cat(MakePerfTaskTuples<TaskTypes, InputType>(settings_path)...);
 }
 
+/// @brief Creates the perf cases of all tasks for every problem size.
+/// @param sizes Sizes declared by the test; PPC_PERF_SIZES replaces them when it is set.
+/// @param variant Input family of a task with several perf tests (e.g. "road"), to keep their case names apart.
+template <typename InputType, typename... TaskTypes>
+auto MakeAllPerfTasks(const std::string &settings_path, const PerfSizes &sizes, const std::string &variant = {}) {
+  using FirstTask = std::tuple_element_t<0, std::tuple<TaskTypes...>>;
+  using OutputType = std::remove_cvref_t<decltype(std::declval<FirstTask &>().GetOutput())>;
+  const auto env_sizes = GetPerfSizes();
+  std::vector<PerfTestParam<InputType, OutputType>> params;
+  for (std::size_t size : env_sizes.empty() ? sizes : env_sizes) {
+    std::apply([&params](const auto &...param) { (params.emplace_back(param), ...); },
+               std::tuple_cat(MakePerfTaskTuples<TaskTypes, InputType>(settings_path, size, variant)...));
+  }
+  return params;
+}
+
 }  // namespace ppc::util
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief How the runners pin MPI ranks and their worker threads to CPUs (PPC_BIND).
+enum class BindPolicy : uint8_t {
+  /// Placement is left to the OS (and to mpirun).
+  kNone,
+  /// The ranks of a node take consecutive blocks of PPC_NUM_THREADS CPUs, filling one NUMA node after another.
+  kCompact,
+  /// The ranks of a node are dealt round-robin over the NUMA nodes, each taking a block of CPUs of its node.
+  kSpread,
+};
+
+/// @brief Where the pages of large input buffers are placed (PPC_NUMA).
+enum class NumaPolicy : uint8_t {
+  /// Pages stay where they were first touched.
+  kNone,
+  /// Pages are migrated to the NUMA node of the rank after the input was written (mbind MPOL_PREFERRED with
+  /// MPOL_MF_MOVE). This is not first-touch placement: the test writes the input on the main thread, and the pages
+  /// are moved afterwards, before the measurements.
+  kMigrate,
+  /// Pages are interleaved over all NUMA nodes; the whole process allocates interleaved as well.
+  kInterleave,
+};
+
+/// @brief Parses PPC_BIND ("none", "compact" or "spread"; unset means none).
+/// @throws std::runtime_error On any other value.
+BindPolicy GetBindPolicy();
+/// @brief Parses PPC_NUMA ("none", "migrate" or "interleave"; unset means none).
+/// @throws std::runtime_error On any other value.
+NumaPolicy GetNumaPolicy();
+
+std::string_view ToString(BindPolicy policy);
+std::string_view ToString(NumaPolicy policy);
+
+/// @brief CPUs of every NUMA node of the machine.
+struct CpuTopology {
+  /// @brief NUMA node id of every entry of node_cpus.
+  std::vector<int> node_ids;
+  std::vector<std::vector<int>> node_cpus;
+
+  [[nodiscard]] std::size_t NumCpus() const;
+};
+
+/// @brief Reads the NUMA nodes from /sys/devices/system/node; a machine without that information (or not running
+/// Linux) is one node holding CPUs 0..hardware_concurrency-1.
+CpuTopology GetCpuTopology();
+
+/// @brief Parses a Linux CPU list such as "0-3,8,10-11".
+/// @throws std::runtime_error If the list is malformed.
+std::vector<int> ParseCpuList(std::string_view list);
+/// @brief Formats CPU ids as a Linux CPU list, collapsing runs into ranges ("0-3,8").
+std::string FormatCpuList(std::span<const int> cpus);
+
+/// @brief CPUs of one rank under a bind policy: thread i of the rank runs on the i-th returned CPU.
+/// @param local_rank Rank among the ranks of the same node.
+/// @param num_threads Worker threads per rank.
+/// @return Empty for kNone. Ranks wrap around when the node has fewer CPUs than ranks * num_threads.
+std::vector<int> AssignCpus(const CpuTopology &topology, BindPolicy policy, int local_rank, int num_threads);
+
+/// @brief Placement chosen by ApplyPlacement().
+struct Placement {
+  BindPolicy bind = BindPolicy::kNone;
+  NumaPolicy numa = NumaPolicy::kNone;
+  int numa_nodes = 1;
+  /// @brief CPUs of this rank (empty when not bound).
+  std::vector<int> cpus;
+};
+
+/// @brief Pins this process and its OpenMP and TBB workers and sets the memory policy, following PPC_BIND and
+/// PPC_NUMA. Called by the runners once, before the tests run.
+/// @details The calling (main) thread is restricted to all CPUs of the rank, so threads created later (std::thread)
+/// inherit that set; OpenMP workers are pinned one per CPU when the pool is created here and TBB workers when they
+/// join the arena. Does nothing on platforms without sched_setaffinity.
+void ApplyPlacement(int local_rank, int num_threads);
+
+/// @brief Placement of this process; the default (unbound) one until ApplyPlacement() is called.
+const Placement &GetPlacement();
+
+/// @brief Pins the calling thread to the index-th CPU of the rank (modulo their number), e.g. a std::thread worker.
+/// Does nothing when the rank is not bound.
+void PinCurrentThread(int index);
+
+/// @brief Applies the NUMA policy to the pages of a buffer (mbind with page migration); pages shared with
+/// neighbouring data are moved as well.
+/// @return False if the kernel refused; true otherwise, including kNone, single-node machines and platforms without
+/// mbind, where nothing is done.
+bool PlaceBuffer(std::span<const std::byte> buffer);
+
+}  // namespace ppc::util
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ppc::util {
+
+/// @brief Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+/// @details A stateless bijection of a 128-bit counter under a 64-bit key: the n-th random block is simply
+/// Generate({n, ...}, key), so any element can be produced without generating the ones before it.
+class Philox4x32 {
+ public:
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  static constexpr Counter Generate(Counter counter, Key key) {
+    for (int round = 0; round < kRounds; round++) {
+      if (round != 0) {
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+      }
+      const uint64_t product0 = uint64_t{kMultiplier0} * counter[0];
+      const uint64_t product1 = uint64_t{kMultiplier1} * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32U) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32U) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+    }
+    return counter;
+  }
+
+ private:
+  static constexpr int kRounds = 10;
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53U;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57U;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9U;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85U;
+};
+
+/// @brief Random values addressed by index: value `index` of a (seed, stream) pair is the same on every rank and
+/// thread, whatever the order or partition in which values are requested.
+/// @details Use the element's global position (e.g. i * n + j for a matrix) as the index; use different streams for
+/// independent quantities drawn for the same positions.
+class CounterRng {
+ public:
+  explicit constexpr CounterRng(uint64_t seed, uint64_t stream = 0) : seed_(seed), stream_(stream) {}
+
+  /// @brief Generator with the same seed and another stream.
+  [[nodiscard]] constexpr CounterRng Stream(uint64_t stream) const {
+    return CounterRng(seed_, stream);
+  }
+
+  /// @brief Four random 32-bit words for `index`.
+  [[nodiscard]] constexpr Philox4x32::Counter Bits(uint64_t index) const {
+    return Philox4x32::Generate({Low(index), High(index), Low(stream_), High(stream_)}, {Low(seed_), High(seed_)});
+  }
+
+  [[nodiscard]] constexpr uint64_t Uint64(uint64_t index) const {
+    const auto bits = Bits(index);
+    return (uint64_t{bits[1]} << 32U) | bits[0];
+  }
+
+  /// @brief Uniform double in [0, 1) with 53 random bits.
+  [[nodiscard]] constexpr double Uniform(uint64_t index) const {
+    constexpr double kScale = 1.0 / static_cast<double>(uint64_t{1} << 53U);
+    return static_cast<double>(Uint64(index) >> 11U) * kScale;
+  }
+
+  /// @brief Uniform double in [low, high).
+  [[nodiscard]] constexpr double Uniform(uint64_t index, double low, double high) const {
+    return low + ((high - low) * Uniform(index));
+  }
+
+  /// @brief Uniform integer in [low, high] (both inclusive).
+  template <std::integral T>
+  [[nodiscard]] constexpr T UniformInt(uint64_t index, T low, T high) const {
+    const uint64_t range = static_cast<uint64_t>(high) - static_cast<uint64_t>(low) + 1;
+    uint64_t offset = 0;
+    if (range == 0) {
+      // [low, high] covers all 2^64 values
+      offset = Uint64(index);
+    } else if (range <= (uint64_t{1} << 32U)) {
+      // Multiply-shift instead of modulo: no division, bias below range / 2^32
+      offset = (uint64_t{Bits(index)[0]} * range) >> 32U;
+    } else {
+      offset = Uint64(index) % range;
+    }
+    return static_cast<T>(static_cast<uint64_t>(low) + offset);
+  }
+
+ private:
+  static constexpr uint32_t Low(uint64_t value) {
+    return static_cast<uint32_t>(value);
+  }
+  static constexpr uint32_t High(uint64_t value) {
+    return static_cast<uint32_t>(value >> 32U);
+  }
+
+  uint64_t seed_;
+  uint64_t stream_;
+};
+
+/// @brief Fills `out` with the uniform values `first_index`, `first_index` + 1, ... of `rng`, in [low, high] for
+/// integers and [low, high) for floating point types.
+/// @details Elements are independent, so the loop runs on all OpenMP threads and a rank can fill just its own block by
+/// passing the block's global offset as `first_index`; the result is bit-identical for any split.
+template <typename T>
+void FillUniform(const CounterRng &rng, std::span<T> out, uint64_t first_index, T low, T high) {
+  const auto size = static_cast<std::int64_t>(out.size());
+#pragma omp parallel for default(none) shared(rng, out, first_index, low, high, size)
+  for (std::int64_t i = 0; i < size; i++) {
+    const auto index = first_index + static_cast<uint64_t>(i);
+    if constexpr (std::integral<T>) {
+      out[static_cast<std::size_t>(i)] = rng.UniformInt(index, low, high);
+    } else {
+      out[static_cast<std::size_t>(i)] = static_cast<T>(rng.Uniform(index, low, high));
+    }
+  }
+}
+
+}  // namespace ppc::util
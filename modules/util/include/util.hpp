@@ -4,6 +4,7 @@
 #include <array>
 #include <atomic>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -13,6 +14,7 @@
 #include <string_view>
 #include <system_error>
 #include <typeinfo>
+#include <vector>
 #ifdef __GNUG__
 #  include <cxxabi.h>
 #endif
@@ -64,17 +66,32 @@ class DestructorFailureFlag {
   inline static std::atomic<bool> failure_flag{false};
 };
 
-enum class GTestParamIndex : uint8_t { kTaskGetter, kNameTest, kTestParams };
+/// @brief Positions in the gtest parameter tuples; kProblemSize exists in perf test parameters only.
+enum class GTestParamIndex : uint8_t { kTaskGetter, kNameTest, kTestParams, kProblemSize };
 
 std::string GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path);
 int GetNumThreads();
 int GetNumProc();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
-
-template <typename T>
-std::string GetNamespace() {
-  std::string name = typeid(T).name();
+/// @brief Returns the number of untimed perf iterations from PPC_PERF_WARMUP, 0 if it is not set.
+uint64_t GetPerfWarmup();
+/// @brief Returns the coefficient of variation perf samples have to reach from PPC_PERF_MAX_CV, 0 (no check) if it
+/// is not set.
+double GetPerfMaxCv();
+std::string GetPerfOutputPath();
+/// @brief Returns the problem sizes listed in PPC_PERF_SIZES (comma-separated), empty if it is not set.
+/// @throws std::runtime_error If the list contains anything but positive integers.
+std::vector<std::size_t> GetPerfSizes();
+/// @brief Returns true when PPC_SHARED_INPUT is set to a non-zero value (see NodeSharedBuffer).
+bool IsNodeSharedInputEnabled();
+/// @brief Returns the directory named by PPC_TRACE that timeline traces are written to, empty if it is not set.
+std::string GetTraceDir();
+
+/// @brief Returns the namespace part of a demangled type name.
+/// @param type_info Type information, e.g. typeid of a polymorphic object for its dynamic type.
+inline std::string GetNamespace(const std::type_info &type_info) {
+  std::string name = type_info.name();
 #ifdef __GNUC__
   int status = 0;
   std::unique_ptr<char, void (*)(void *)> demangled{abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status),
@@ -95,6 +112,11 @@ std::string GetNamespace() {
   return (pos != std::string::npos) ? name.substr(0, pos) : std::string{};
 }
 
+template <typename T>
+std::string GetNamespace() {
+  return GetNamespace(typeid(T));
+}
+
 inline std::shared_ptr<nlohmann::json> InitJSONPtr() {
   return std::make_shared<nlohmann::json>();
 }
@@ -0,0 +1,260 @@
+#include "util/include/dataset.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/include/partition.hpp"
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+static_assert(std::endian::native == std::endian::little, "datasets are stored little-endian");
+
+constexpr std::array<char, 8> kMagic = {'P', 'P', 'C', 'D', 'A', 'T', 'A', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr std::size_t kMaxDims = 4;
+
+// On-disk header; the payload starts right after it, 64 bytes into the file
+struct RawHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint8_t type;
+  uint8_t dims;
+  uint16_t reserved;
+  std::array<uint64_t, kMaxDims> shape;
+  uint32_t checksum;
+  uint32_t reserved2;
+  uint64_t payload_size;
+};
+static_assert(sizeof(RawHeader) == 64);
+
+std::array<uint32_t, 256> MakeCrcTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1U) != 0 ? (crc >> 1U) ^ 0xEDB88320U : crc >> 1U;
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+uint64_t Product(std::span<const uint64_t> values) {
+  return std::accumulate(values.begin(), values.end(), uint64_t{1}, std::multiplies<>());
+}
+
+ppc::util::DatasetHeader ParseHeader(const RawHeader &raw, const std::string &path, uint64_t file_size) {
+  if (raw.magic != kMagic) {
+    throw std::runtime_error("Not a dataset file: " + path);
+  }
+  if (raw.version != kVersion) {
+    throw std::runtime_error("Unsupported dataset version in " + path);
+  }
+  if (raw.dims == 0 || raw.dims > kMaxDims) {
+    throw std::runtime_error("Invalid number of dimensions in " + path);
+  }
+  ppc::util::DatasetHeader header;
+  header.type = static_cast<ppc::util::DataType>(raw.type);
+  header.shape.assign(raw.shape.begin(), raw.shape.begin() + raw.dims);
+  header.checksum = raw.checksum;
+  if (header.Elements() * ppc::util::GetDataTypeSize(header.type) != raw.payload_size ||
+      file_size != sizeof(RawHeader) + raw.payload_size) {
+    throw std::runtime_error("Truncated or inconsistent dataset: " + path);
+  }
+  return header;
+}
+
+}  // namespace
+
+std::size_t ppc::util::GetDataTypeSize(DataType type) {
+  switch (type) {
+    case DataType::kInt8:
+    case DataType::kUInt8:
+      return 1;
+    case DataType::kInt32:
+    case DataType::kUInt32:
+    case DataType::kFloat32:
+      return 4;
+    case DataType::kInt64:
+    case DataType::kUInt64:
+    case DataType::kFloat64:
+      return 8;
+  }
+  throw std::runtime_error("Unknown dataset element type");
+}
+
+uint64_t ppc::util::DatasetHeader::Elements() const {
+  return Product(shape);
+}
+
+uint64_t ppc::util::DatasetHeader::RowElements() const {
+  return shape.empty() ? 0 : Product(std::span(shape).subspan(1));
+}
+
+uint32_t ppc::util::Crc32(std::span<const std::byte> data, uint32_t crc) {
+  static const auto kTable = MakeCrcTable();
+  crc = ~crc;
+  for (const std::byte byte : data) {
+    crc = kTable[(crc ^ std::to_integer<uint32_t>(byte)) & 0xFFU] ^ (crc >> 8U);
+  }
+  return ~crc;
+}
+
+ppc::util::DatasetHeader ppc::util::ReadDatasetHeader(const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  const auto file_size = static_cast<uint64_t>(file.tellg());
+  RawHeader raw{};
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(&raw), sizeof(raw))) {  // NOLINT(*-reinterpret-cast)
+    throw std::runtime_error("Truncated or inconsistent dataset: " + path);
+  }
+  return ParseHeader(raw, path, file_size);
+}
+
+void ppc::util::WriteDataset(const std::string &path, DataType type, std::span<const std::byte> payload,
+                             std::span<const uint64_t> shape) {
+  if (shape.empty() || shape.size() > kMaxDims) {
+    throw std::runtime_error("WriteDataset: a dataset has 1 to 4 dimensions");
+  }
+  if (Product(shape) * GetDataTypeSize(type) != payload.size()) {
+    throw std::runtime_error("WriteDataset: shape does not match the payload size");
+  }
+  RawHeader raw{};
+  raw.magic = kMagic;
+  raw.version = kVersion;
+  raw.type = static_cast<uint8_t>(type);
+  raw.dims = static_cast<uint8_t>(shape.size());
+  std::ranges::copy(shape, raw.shape.begin());
+  raw.checksum = Crc32(payload);
+  raw.payload_size = payload.size();
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&raw), sizeof(raw));  // NOLINT(*-reinterpret-cast)
+  file.write(reinterpret_cast<const char *>(payload.data()),     // NOLINT(*-reinterpret-cast)
+             static_cast<std::streamsize>(payload.size()));
+  if (!file) {
+    throw std::runtime_error("Failed to write dataset: " + path);
+  }
+}
+
+ppc::util::MappedDataset::~MappedDataset() {
+  Release();
+}
+
+ppc::util::MappedDataset::MappedDataset(MappedDataset &&other) noexcept
+    : header_(std::move(other.header_)),
+      rows_(other.rows_),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      copy_(std::move(other.copy_)) {}
+
+ppc::util::MappedDataset &ppc::util::MappedDataset::operator=(MappedDataset &&other) noexcept {
+  if (this != &other) {
+    Release();
+    header_ = std::move(other.header_);
+    rows_ = other.rows_;
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    copy_ = std::move(other.copy_);
+  }
+  return *this;
+}
+
+void ppc::util::MappedDataset::Release() {
+#ifndef _WIN32
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+#endif
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  copy_.clear();
+  data_ = nullptr;
+  size_ = 0;
+}
+
+ppc::util::MappedDataset ppc::util::MappedDataset::Open(const std::string &path, ChecksumCheck check) {
+  const auto header = ReadDatasetHeader(path);
+  auto dataset = OpenRows(path, {.begin = 0, .end = header.shape.front()});
+  if (check == ChecksumCheck::kVerify && Crc32({dataset.data_, dataset.size_}) != header.checksum) {
+    throw std::runtime_error("Dataset checksum mismatch: " + path);
+  }
+  return dataset;
+}
+
+ppc::util::MappedDataset ppc::util::MappedDataset::OpenRows(const std::string &path, PartitionRange rows) {
+  MappedDataset dataset;
+  dataset.header_ = ReadDatasetHeader(path);
+  if (rows.begin > rows.end || rows.end > dataset.header_.shape.front()) {
+    throw std::runtime_error("MappedDataset: rows out of range in " + path);
+  }
+  dataset.rows_ = rows;
+  const uint64_t row_bytes = dataset.header_.RowElements() * GetDataTypeSize(dataset.header_.type);
+  const uint64_t offset = sizeof(RawHeader) + (rows.begin * row_bytes);
+  dataset.size_ = rows.Size() * row_bytes;
+  if (dataset.size_ == 0) {
+    return dataset;
+  }
+
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary);
+  dataset.copy_.resize(dataset.size_);
+  file.seekg(static_cast<std::streamoff>(offset));
+  if (!file.read(reinterpret_cast<char *>(dataset.copy_.data()),  // NOLINT(*-reinterpret-cast)
+                 static_cast<std::streamsize>(dataset.size_))) {
+    throw std::runtime_error("Failed to read dataset: " + path);
+  }
+  dataset.data_ = dataset.copy_.data();
+#else
+  const int fd = open(path.c_str(), O_RDONLY);  // NOLINT(*-vararg)
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  // mmap offsets must be page aligned: map from the page that holds the first requested byte
+  const auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t map_offset = offset / page * page;
+  dataset.mapping_size_ = dataset.size_ + (offset - map_offset);
+  void *mapping =
+      mmap(nullptr, dataset.mapping_size_, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(map_offset));
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    dataset.mapping_size_ = 0;
+    throw std::runtime_error("Failed to map dataset: " + path);
+  }
+  dataset.mapping_ = mapping;
+  dataset.data_ = static_cast<const std::byte *>(mapping) + (offset - map_offset);
+#endif
+  return dataset;
+}
+
+ppc::util::MappedDataset ppc::util::MappedDataset::OpenSlice(const std::string &path, int part, int parts) {
+  const BlockPartition partition(ReadDatasetHeader(path).shape.front(), parts);
+  if (part < 0 || part >= parts) {
+    throw std::runtime_error("MappedDataset: part out of range");
+  }
+  return OpenRows(path, partition.Range(part));
+}
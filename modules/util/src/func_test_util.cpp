@@ -1,5 +1,13 @@
 #include <mpi.h>
 
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "performance/include/roofline.hpp"
 #include "util/include/perf_test_util.hpp"
 
 double ppc::util::GetTimeMPI() {
@@ -11,3 +19,60 @@ int ppc::util::GetMPIRank() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+int ppc::util::GetMPISize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+std::vector<double> ppc::util::GatherRankValues(double value) {
+  const int rank = GetMPIRank();
+  std::vector<double> values(rank == 0 ? static_cast<std::size_t>(GetMPISize()) : 0U);
+  MPI_Gather(&value, 1, MPI_DOUBLE, values.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  return values;
+}
+
+double ppc::util::MaxOverRanks(double value) {
+  double max_value = value;
+  MPI_Allreduce(&value, &max_value, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  return max_value;
+}
+
+std::vector<std::string> ppc::util::GatherRankStrings(const std::string &value) {
+  const int rank = GetMPIRank();
+  const int size = rank == 0 ? GetMPISize() : 0;
+  const int length = static_cast<int>(value.size());
+  std::vector<int> lengths(static_cast<std::size_t>(size));
+  MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  std::vector<int> displs(static_cast<std::size_t>(size));
+  for (std::size_t i = 1; i < displs.size(); i++) {
+    displs[i] = displs[i - 1] + lengths[i - 1];
+  }
+  std::string joined(size == 0 ? 0U : static_cast<std::size_t>(displs.back() + lengths.back()), '\0');
+  MPI_Gatherv(value.data(), length, MPI_CHAR, joined.data(), lengths.data(), displs.data(), MPI_CHAR, 0,
+              MPI_COMM_WORLD);
+  std::vector<std::string> values;
+  values.reserve(lengths.size());
+  for (std::size_t i = 0; i < lengths.size(); i++) {
+    values.push_back(joined.substr(static_cast<std::size_t>(displs[i]), static_cast<std::size_t>(lengths[i])));
+  }
+  return values;
+}
+
+ppc::performance::MachinePeaks ppc::util::GetMachinePeaks(int num_threads, bool sum_over_ranks) {
+  static std::map<std::pair<int, bool>, ppc::performance::MachinePeaks> cache;
+  const auto key = std::make_pair(num_threads, sum_over_ranks);
+  if (const auto it = cache.find(key); it != cache.end()) {
+    return it->second;
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto peaks = ppc::performance::MeasureMachinePeaks(num_threads);
+  if (sum_over_ranks) {
+    std::array<double, 2> values = {peaks.bytes_per_sec, peaks.flops_per_sec};
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    peaks = {.bytes_per_sec = values[0], .flops_per_sec = values[1]};
+  }
+  cache.emplace(key, peaks);
+  return peaks;
+}
@@ -0,0 +1,331 @@
+#include "util/include/gemm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/include/matrix.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define PPC_GEMM_X86 1
+#  include <immintrin.h>
+#endif
+
+namespace ppc::util {
+
+namespace {
+
+// A kKc x kNc panel of B (4 MiB) stays in the last-level cache, a kMc x kKc block of A (192 KiB) in L2 and a
+// kKc x NR sliver of B in L1 while the micro-kernel sweeps over the slivers of A
+constexpr std::size_t kKc = 256;
+constexpr std::size_t kMc = 96;
+constexpr std::size_t kNc = 2048;
+
+using PackedBuffer = std::vector<double, AlignedAllocator<double>>;
+
+template <std::size_t MR, std::size_t NR>
+using MicroKernel = void (*)(std::size_t kc, const double *a, const double *b, std::array<double, MR * NR> &tile);
+
+constexpr std::size_t RoundUp(std::size_t value, std::size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+// Packing buffers only grow, so repeated products on a thread (e.g. the panels of a pipelined multiply) reuse them
+double *GrowBuffer(PackedBuffer &buffer, std::size_t size) {
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+  return buffer.data();
+}
+
+// Slivers of NR columns, each stored k-major: element (p, j) of the sliver at p * NR + j; the last one is zero-padded
+template <std::size_t NR>
+void PackB(std::size_t kc, std::size_t nc, const double *b, std::size_t ldb, double *packed) {
+  for (std::size_t j0 = 0; j0 < nc; j0 += NR) {
+    const std::size_t cols = std::min(NR, nc - j0);
+    for (std::size_t p = 0; p < kc; p++) {
+      const double *src = b + (p * ldb) + j0;
+      std::copy(src, src + cols, packed);
+      std::fill(packed + cols, packed + NR, 0.0);
+      packed += NR;
+    }
+  }
+}
+
+// Slivers of MR rows, each stored k-major: element (i, p) of the sliver at p * MR + i; the last one is zero-padded
+template <std::size_t MR>
+void PackA(std::size_t mc, std::size_t kc, const double *a, std::size_t lda, double *packed) {
+  for (std::size_t i0 = 0; i0 < mc; i0 += MR) {
+    const std::size_t rows = std::min(MR, mc - i0);
+    for (std::size_t p = 0; p < kc; p++) {
+      for (std::size_t i = 0; i < rows; i++) {
+        packed[i] = a[((i0 + i) * lda) + p];
+      }
+      std::fill(packed + rows, packed + MR, 0.0);
+      packed += MR;
+    }
+  }
+}
+
+template <std::size_t MR, std::size_t NR>
+void KernelScalar(std::size_t kc, const double *a, const double *b, std::array<double, MR * NR> &tile) {
+  std::array<double, MR * NR> acc{};
+  for (std::size_t p = 0; p < kc; p++) {
+    for (std::size_t i = 0; i < MR; i++) {
+      const double a_value = a[i];
+      for (std::size_t j = 0; j < NR; j++) {
+        acc[(i * NR) + j] += a_value * b[j];
+      }
+    }
+    a += MR;
+    b += NR;
+  }
+  tile = acc;
+}
+
+#ifdef PPC_GEMM_X86
+// 6 x 8 tile: 12 accumulators, two vectors of B and a broadcast of A use 15 of the 16 ymm registers
+__attribute__((target("avx2,fma"))) void KernelAvx2(std::size_t kc, const double *a, const double *b,
+                                                    std::array<double, 6 * 8> &tile) {
+  // A plain array: std::array of vector types would be instantiated outside of the target attribute
+  __m256d acc[12];  // NOLINT(*-avoid-c-arrays)
+#  pragma GCC unroll 12
+  for (std::size_t r = 0; r < 12; r++) {
+    acc[r] = _mm256_setzero_pd();
+  }
+  for (std::size_t p = 0; p < kc; p++) {
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+#  pragma GCC unroll 6
+    for (std::size_t i = 0; i < 6; i++) {
+      const __m256d a_value = _mm256_broadcast_sd(a + i);
+      acc[2 * i] = _mm256_fmadd_pd(a_value, b0, acc[2 * i]);
+      acc[(2 * i) + 1] = _mm256_fmadd_pd(a_value, b1, acc[(2 * i) + 1]);
+    }
+    a += 6;
+    b += 8;
+  }
+#  pragma GCC unroll 12
+  for (std::size_t r = 0; r < 12; r++) {
+    _mm256_storeu_pd(tile.data() + (r * 4), acc[r]);
+  }
+}
+
+// 8 x 16 tile: 16 accumulators of the 32 zmm registers, leaving room for B and the broadcasts
+__attribute__((target("avx512f"))) void KernelAvx512(std::size_t kc, const double *a, const double *b,
+                                                     std::array<double, 8 * 16> &tile) {
+  __m512d acc[16];  // NOLINT(*-avoid-c-arrays)
+#  pragma GCC unroll 16
+  for (std::size_t r = 0; r < 16; r++) {
+    acc[r] = _mm512_setzero_pd();
+  }
+  for (std::size_t p = 0; p < kc; p++) {
+    const __m512d b0 = _mm512_loadu_pd(b);
+    const __m512d b1 = _mm512_loadu_pd(b + 8);
+#  pragma GCC unroll 8
+    for (std::size_t i = 0; i < 8; i++) {
+      const __m512d a_value = _mm512_set1_pd(a[i]);
+      acc[2 * i] = _mm512_fmadd_pd(a_value, b0, acc[2 * i]);
+      acc[(2 * i) + 1] = _mm512_fmadd_pd(a_value, b1, acc[(2 * i) + 1]);
+    }
+    a += 8;
+    b += 16;
+  }
+#  pragma GCC unroll 16
+  for (std::size_t r = 0; r < 16; r++) {
+    _mm512_storeu_pd(tile.data() + (r * 8), acc[r]);
+  }
+}
+#endif
+
+template <std::size_t MR, std::size_t NR>
+void GemmBlocked(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                 std::size_t ldb, double *c, std::size_t ldc, bool accumulate, MicroKernel<MR, NR> kernel) {
+  static_assert(kMc % MR == 0 && kNc % NR == 0, "cache blocks must hold whole register tiles");
+  // One pair per thread and register tile, at most kKc x kNc + kMc x kKc doubles (about 4.2 MiB)
+  thread_local PackedBuffer packed_b_buffer;
+  thread_local PackedBuffer packed_a_buffer;
+  double *packed_b = GrowBuffer(packed_b_buffer, std::min(k, kKc) * RoundUp(std::min(n, kNc), NR));
+  double *packed_a = GrowBuffer(packed_a_buffer, RoundUp(std::min(m, kMc), MR) * std::min(k, kKc));
+  alignas(kCacheLineSize) std::array<double, MR * NR> tile{};
+
+  for (std::size_t jc = 0; jc < n; jc += kNc) {
+    const std::size_t nc = std::min(kNc, n - jc);
+    for (std::size_t pc = 0; pc < k; pc += kKc) {
+      const std::size_t kc = std::min(kKc, k - pc);
+      const bool first = pc == 0 && !accumulate;
+      PackB<NR>(kc, nc, b + (pc * ldb) + jc, ldb, packed_b);
+      for (std::size_t ic = 0; ic < m; ic += kMc) {
+        const std::size_t mc = std::min(kMc, m - ic);
+        PackA<MR>(mc, kc, a + (ic * lda) + pc, lda, packed_a);
+        for (std::size_t jr = 0; jr < nc; jr += NR) {
+          for (std::size_t ir = 0; ir < mc; ir += MR) {
+            kernel(kc, packed_a + (ir * kc), packed_b + (jr * kc), tile);
+            // Edge tiles were computed on zero padding; only their valid part is written
+            const std::size_t rows = std::min(MR, mc - ir);
+            const std::size_t cols = std::min(NR, nc - jr);
+            double *c_tile = c + ((ic + ir) * ldc) + jc + jr;
+            for (std::size_t i = 0; i < rows; i++) {
+              for (std::size_t j = 0; j < cols; j++) {
+                c_tile[(i * ldc) + j] = (first ? 0.0 : c_tile[(i * ldc) + j]) + tile[(i * NR) + j];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void GemmReference(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                   std::size_t ldb, double *c, std::size_t ldc, bool accumulate) {
+  for (std::size_t i = 0; i < m; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      double sum = 0.0;
+      for (std::size_t p = 0; p < k; p++) {
+        sum += a[(i * lda) + p] * b[(p * ldb) + j];
+      }
+      c[(i * ldc) + j] = (accumulate ? c[(i * ldc) + j] : 0.0) + sum;
+    }
+  }
+}
+
+}  // namespace
+
+bool IsGemmKernelSupported(GemmKernel kernel) {
+  switch (kernel) {
+    case GemmKernel::kAvx2:
+#ifdef PPC_GEMM_X86
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+      return false;
+#endif
+    case GemmKernel::kAvx512:
+#ifdef PPC_GEMM_X86
+      return __builtin_cpu_supports("avx512f");
+#else
+      return false;
+#endif
+    case GemmKernel::kReference:
+    case GemmKernel::kScalar:
+    default:
+      return true;
+  }
+}
+
+GemmKernel GetGemmKernel() {
+  const auto val = env::get<std::string>("PPC_GEMM_KERNEL");
+  if (!val.has_value() || val.value().empty()) {
+    for (auto kernel : {GemmKernel::kAvx512, GemmKernel::kAvx2}) {
+      if (IsGemmKernelSupported(kernel)) {
+        return kernel;
+      }
+    }
+    return GemmKernel::kScalar;
+  }
+  for (auto kernel : {GemmKernel::kReference, GemmKernel::kScalar, GemmKernel::kAvx2, GemmKernel::kAvx512}) {
+    if (val.value() == ToString(kernel)) {
+      if (!IsGemmKernelSupported(kernel)) {
+        throw std::runtime_error("PPC_GEMM_KERNEL: " + val.value() + " is not supported on this CPU");
+      }
+      return kernel;
+    }
+  }
+  throw std::runtime_error("PPC_GEMM_KERNEL must be reference, scalar, avx2 or avx512, got: " + val.value());
+}
+
+std::string_view ToString(GemmKernel kernel) {
+  switch (kernel) {
+    case GemmKernel::kReference:
+      return "reference";
+    case GemmKernel::kAvx2:
+      return "avx2";
+    case GemmKernel::kAvx512:
+      return "avx512";
+    case GemmKernel::kScalar:
+    default:
+      return "scalar";
+  }
+}
+
+namespace {
+
+// PPC_GEMM_KERNEL is read once per process: the overloads without a kernel are called inside timed loops
+GemmKernel DefaultGemmKernel() {
+  static const GemmKernel kKernel = GetGemmKernel();
+  return kKernel;
+}
+
+void GemmDispatch(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                  std::size_t ldb, double *c, std::size_t ldc, GemmKernel kernel, bool accumulate) {
+  if (!IsGemmKernelSupported(kernel)) {
+    throw std::runtime_error("Gemm: kernel " + std::string(ToString(kernel)) + " is not supported on this CPU");
+  }
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0) {
+    for (std::size_t i = 0; i < m && !accumulate; i++) {
+      std::fill(c + (i * ldc), c + (i * ldc) + n, 0.0);
+    }
+    return;
+  }
+  switch (kernel) {
+    case GemmKernel::kReference:
+      GemmReference(m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+      break;
+#ifdef PPC_GEMM_X86
+    case GemmKernel::kAvx2:
+      GemmBlocked<6, 8>(m, n, k, a, lda, b, ldb, c, ldc, accumulate, KernelAvx2);
+      break;
+    case GemmKernel::kAvx512:
+      GemmBlocked<8, 16>(m, n, k, a, lda, b, ldb, c, ldc, accumulate, KernelAvx512);
+      break;
+#else
+    case GemmKernel::kAvx2:
+    case GemmKernel::kAvx512:
+#endif
+    case GemmKernel::kScalar:
+    default:
+      GemmBlocked<4, 8>(m, n, k, a, lda, b, ldb, c, ldc, accumulate, KernelScalar<4, 8>);
+      break;
+  }
+}
+
+}  // namespace
+
+void Gemm(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+          std::size_t ldb, double *c, std::size_t ldc, GemmKernel kernel) {
+  GemmDispatch(m, n, k, a, lda, b, ldb, c, ldc, kernel, false);
+}
+
+void Gemm(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+          std::size_t ldb, double *c, std::size_t ldc) {
+  Gemm(m, n, k, a, lda, b, ldb, c, ldc, DefaultGemmKernel());
+}
+
+void Gemm(std::size_t m, std::size_t n, std::size_t k, std::span<const double> a, std::span<const double> b,
+          std::span<double> c) {
+  if (a.size() < m * k || b.size() < k * n || c.size() < m * n) {
+    throw std::runtime_error("Gemm: matrix spans are smaller than their dimensions");
+  }
+  Gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+}
+
+void GemmAccumulate(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                    std::size_t ldb, double *c, std::size_t ldc, GemmKernel kernel) {
+  GemmDispatch(m, n, k, a, lda, b, ldb, c, ldc, kernel, true);
+}
+
+void GemmAccumulate(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                    std::size_t ldb, double *c, std::size_t ldc) {
+  GemmAccumulate(m, n, k, a, lda, b, ldb, c, ldc, DefaultGemmKernel());
+}
+
+}  // namespace ppc::util
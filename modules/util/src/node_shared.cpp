@@ -0,0 +1,113 @@
+#include "util/include/node_shared.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+
+namespace {
+
+// MPI counts are int, large buffers are broadcast in pieces
+constexpr std::size_t kBcastChunkBytes = std::size_t{1} << 30;
+
+void BcastBytes(std::byte *data, std::size_t size, int root, MPI_Comm comm) {
+  for (std::size_t offset = 0; offset < size; offset += kBcastChunkBytes) {
+    const std::size_t count = std::min(kBcastChunkBytes, size - offset);
+    MPI_Bcast(data + offset, static_cast<int>(count), MPI_BYTE, root, comm);
+  }
+}
+
+}  // namespace
+
+ppc::util::NodeSharedBuffer::NodeSharedBuffer(std::span<const std::byte> root_data, int root, MPI_Comm comm,
+                                              InputDistribution distribution) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  const bool is_root = rank == root;
+  uint64_t size = is_root ? root_data.size() : 0;
+  MPI_Bcast(&size, 1, MPI_UINT64_T, root, comm);
+  size_ = size;
+
+  if (distribution == InputDistribution::kBroadcast) {
+    if (is_root) {
+      data_ = root_data.data();
+      // The root only sends, MPI_Bcast does not write to its buffer
+      BcastBytes(const_cast<std::byte *>(root_data.data()), size_, root, comm);  // NOLINT(*-const-cast)
+    } else {
+      copy_.resize(size_);
+      data_ = copy_.data();
+      BcastBytes(copy_.data(), size_, root, comm);
+    }
+    return;
+  }
+
+  // Key 0 for the root makes it rank 0 of its node and of the leaders communicator; other ranks keep their order
+  const int key = is_root ? 0 : 1;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &node_comm_);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm_, &node_rank);
+  const bool is_leader = node_rank == 0;
+
+  void *base = nullptr;
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(is_leader ? size_ : 0), 1, MPI_INFO_NULL, node_comm_, &base, &window_);
+  MPI_Aint window_size = 0;
+  int disp_unit = 0;
+  MPI_Win_shared_query(window_, 0, &window_size, &disp_unit, &base);
+  data_ = static_cast<const std::byte *>(base);
+
+  MPI_Comm leaders = MPI_COMM_NULL;
+  MPI_Comm_split(comm, is_leader ? 0 : MPI_UNDEFINED, key, &leaders);
+  MPI_Win_fence(0, window_);
+  if (is_leader) {
+    auto *window_data = static_cast<std::byte *>(base);
+    if (is_root && size_ != 0) {
+      std::memcpy(window_data, root_data.data(), size_);
+    }
+    BcastBytes(window_data, size_, 0, leaders);
+    MPI_Comm_free(&leaders);
+  }
+  MPI_Win_fence(0, window_);
+}
+
+ppc::util::NodeSharedBuffer::~NodeSharedBuffer() {
+  Release();
+}
+
+ppc::util::NodeSharedBuffer::NodeSharedBuffer(NodeSharedBuffer &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      copy_(std::move(other.copy_)),
+      window_(std::exchange(other.window_, MPI_WIN_NULL)),
+      node_comm_(std::exchange(other.node_comm_, MPI_COMM_NULL)) {}
+
+ppc::util::NodeSharedBuffer &ppc::util::NodeSharedBuffer::operator=(NodeSharedBuffer &&other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    copy_ = std::move(other.copy_);
+    window_ = std::exchange(other.window_, MPI_WIN_NULL);
+    node_comm_ = std::exchange(other.node_comm_, MPI_COMM_NULL);
+  }
+  return *this;
+}
+
+void ppc::util::NodeSharedBuffer::Release() {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (window_ != MPI_WIN_NULL && finalized == 0) {
+    MPI_Win_free(&window_);
+  }
+  if (node_comm_ != MPI_COMM_NULL && finalized == 0) {
+    MPI_Comm_free(&node_comm_);
+  }
+  window_ = MPI_WIN_NULL;
+  node_comm_ = MPI_COMM_NULL;
+  copy_.clear();
+  data_ = nullptr;
+  size_ = 0;
+}
@@ -0,0 +1,151 @@
+#include "util/include/partition.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<int> ScaleToInt(std::span<const std::size_t> values, std::size_t scale) {
+  std::vector<int> result(values.size());
+  for (std::size_t i = 0; i < values.size(); i++) {
+    if (scale != 0 && values[i] > static_cast<std::size_t>(INT_MAX) / scale) {
+      throw std::runtime_error("BlockPartition: value does not fit into int");
+    }
+    result[i] = static_cast<int>(values[i] * scale);
+  }
+  return result;
+}
+
+}  // namespace
+
+ppc::util::BlockPartition::BlockPartition(std::size_t total, int parts, std::size_t granule) {
+  if (parts <= 0 || granule == 0) {
+    throw std::runtime_error("BlockPartition: parts and granule must be positive");
+  }
+  const auto count = static_cast<std::size_t>(parts);
+  const std::size_t units = (total + granule - 1) / granule;
+  granule_ = granule;
+  even_ = true;
+  base_units_ = units / count;
+  remainder_units_ = units % count;
+
+  offsets_.resize(count + 1);
+  for (std::size_t i = 0; i <= count; i++) {
+    const std::size_t begin_unit = (i * base_units_) + std::min(i, remainder_units_);
+    offsets_[i] = std::min(total, begin_unit * granule);
+  }
+}
+
+ppc::util::BlockPartition ppc::util::BlockPartition::Weighted(std::size_t total, std::span<const double> weights,
+                                                               std::size_t granule) {
+  if (weights.empty() || granule == 0) {
+    throw std::runtime_error("BlockPartition: weights must not be empty and granule must be positive");
+  }
+  if (std::ranges::any_of(weights, [](double w) { return !std::isfinite(w) || w < 0.0; })) {
+    throw std::runtime_error("BlockPartition: weights must be finite and non-negative");
+  }
+  const double weight_sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  if (weight_sum <= 0.0) {
+    throw std::runtime_error("BlockPartition: at least one weight must be positive");
+  }
+
+  // Largest remainder method: floor of every quota, the leftover granules go to the largest fractional parts
+  const std::size_t units = (total + granule - 1) / granule;
+  std::vector<std::size_t> part_units(weights.size());
+  std::vector<double> fractions(weights.size());
+  std::size_t assigned = 0;
+  for (std::size_t i = 0; i < weights.size(); i++) {
+    const double quota = static_cast<double>(units) * (weights[i] / weight_sum);
+    part_units[i] = std::min(units - assigned, static_cast<std::size_t>(quota));
+    fractions[i] = quota - static_cast<double>(part_units[i]);
+    assigned += part_units[i];
+  }
+  std::vector<std::size_t> order(weights.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, [&](std::size_t a, std::size_t b) { return fractions[a] > fractions[b]; });
+  for (std::size_t i = 0; assigned < units; i = (i + 1) % order.size()) {
+    if (weights[order[i]] > 0.0) {
+      part_units[order[i]]++;
+      assigned++;
+    }
+  }
+
+  BlockPartition partition;
+  partition.granule_ = granule;
+  partition.offsets_.resize(weights.size() + 1);
+  std::size_t begin_unit = 0;
+  for (std::size_t i = 0; i < weights.size(); i++) {
+    partition.offsets_[i] = std::min(total, begin_unit * granule);
+    begin_unit += part_units[i];
+  }
+  partition.offsets_.back() = total;
+  return partition;
+}
+
+ppc::util::BlockPartition ppc::util::BlockPartition::Balanced(std::span<const std::int64_t> cost_prefix, int parts) {
+  if (parts <= 0) {
+    throw std::runtime_error("BlockPartition: parts must be positive");
+  }
+  if (cost_prefix.empty() || cost_prefix.front() != 0 || !std::ranges::is_sorted(cost_prefix)) {
+    throw std::runtime_error("BlockPartition: cost prefix sums must start at 0 and must not decrease");
+  }
+  const auto count = static_cast<std::size_t>(parts);
+  const std::int64_t total_cost = cost_prefix.back();
+
+  BlockPartition partition;
+  partition.offsets_.resize(count + 1);
+  for (std::size_t i = 1; i < count; i++) {
+    // total_cost * i / count without the overflow of the product
+    const auto parts_before = static_cast<std::int64_t>(i);
+    const auto parts_total = static_cast<std::int64_t>(count);
+    const std::int64_t target = ((total_cost / parts_total) * parts_before) +
+                                ((total_cost % parts_total) * parts_before / parts_total);
+    const auto it = std::ranges::lower_bound(cost_prefix, target);
+    partition.offsets_[i] = std::max(partition.offsets_[i - 1], static_cast<std::size_t>(it - cost_prefix.begin()));
+  }
+  partition.offsets_.back() = cost_prefix.size() - 1;
+  return partition;
+}
+
+ppc::util::BlockPartition ppc::util::BlockPartition::FromBoundaries(std::vector<std::size_t> boundaries) {
+  if (boundaries.size() < 2 || boundaries.front() != 0 || !std::ranges::is_sorted(boundaries)) {
+    throw std::runtime_error("BlockPartition: boundaries must start at 0 and must not decrease");
+  }
+  BlockPartition partition;
+  partition.offsets_ = std::move(boundaries);
+  return partition;
+}
+
+int ppc::util::BlockPartition::Owner(std::size_t index) const {
+  if (even_) {
+    const std::size_t unit = index / granule_;
+    const std::size_t large_units = remainder_units_ * (base_units_ + 1);
+    if (unit < large_units) {
+      return static_cast<int>(unit / (base_units_ + 1));
+    }
+    return static_cast<int>(remainder_units_ + ((unit - large_units) / base_units_));
+  }
+  // Last part whose block starts at or before the index; empty blocks share their begin with the next one
+  const auto it = std::upper_bound(offsets_.begin(), offsets_.end() - 1, index);
+  return static_cast<int>(it - offsets_.begin()) - 1;
+}
+
+std::vector<int> ppc::util::BlockPartition::Counts(std::size_t scale) const {
+  std::vector<std::size_t> counts(offsets_.size() - 1);
+  for (std::size_t i = 0; i < counts.size(); i++) {
+    counts[i] = offsets_[i + 1] - offsets_[i];
+  }
+  return ScaleToInt(counts, scale);
+}
+
+std::vector<int> ppc::util::BlockPartition::Displs(std::size_t scale) const {
+  return ScaleToInt(std::span<const std::size_t>(offsets_).first(offsets_.size() - 1), scale);
+}
@@ -0,0 +1,357 @@
+#include "util/include/placement.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/task_scheduler_observer.h"
+
+#ifdef __linux__
+#  include <sched.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace ppc::util {
+
+namespace {
+
+#ifdef __linux__
+// From <linux/mempolicy.h>, which needs kernel headers
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolInterleave = 3;
+constexpr unsigned kMpolMfMove = 1U << 1U;
+constexpr std::size_t kMaxNumaNodes = 1024;
+constexpr std::size_t kBitsPerMaskWord = 8 * sizeof(unsigned long);  // NOLINT(google-runtime-int)
+#endif
+
+struct PlacementState {
+  Placement placement;
+  CpuTopology topology;
+};
+
+PlacementState &State() {
+  static PlacementState state;
+  return state;
+}
+
+// TBB workers are pinned when they join an arena; the external (main) thread keeps all CPUs of the rank
+class PinningObserver : public tbb::task_scheduler_observer {
+ public:
+  PinningObserver() {
+    observe(true);
+  }
+  ~PinningObserver() override {
+    observe(false);
+  }
+
+  PinningObserver(const PinningObserver &) = delete;
+  PinningObserver &operator=(const PinningObserver &) = delete;
+  PinningObserver(PinningObserver &&) = delete;
+  PinningObserver &operator=(PinningObserver &&) = delete;
+
+  void on_scheduler_entry(bool is_worker) override {
+    if (is_worker) {
+      PinCurrentThread(tbb::this_task_arena::current_thread_index());
+    }
+  }
+};
+
+std::string ReadFirstLine(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+#ifdef __linux__
+bool SetThreadAffinity(std::span<const int> cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+int NodeIndexOfCpu(const CpuTopology &topology, int cpu) {
+  for (std::size_t node = 0; node < topology.node_cpus.size(); node++) {
+    if (std::ranges::find(topology.node_cpus[node], cpu) != topology.node_cpus[node].end()) {
+      return static_cast<int>(node);
+    }
+  }
+  return 0;
+}
+
+using NodeMask = std::vector<unsigned long>;  // NOLINT(google-runtime-int)
+
+NodeMask MakeNodeMask(std::span<const int> node_ids) {
+  NodeMask mask(kMaxNumaNodes / kBitsPerMaskWord, 0);
+  for (int id : node_ids) {
+    const auto bit = static_cast<std::size_t>(id);
+    mask[bit / kBitsPerMaskWord] |= 1UL << (bit % kBitsPerMaskWord);
+  }
+  return mask;
+}
+#endif
+
+}  // namespace
+
+BindPolicy GetBindPolicy() {
+  const auto val = env::get<std::string>("PPC_BIND");
+  if (!val.has_value() || val.value().empty() || val.value() == "none") {
+    return BindPolicy::kNone;
+  }
+  if (val.value() == "compact") {
+    return BindPolicy::kCompact;
+  }
+  if (val.value() == "spread") {
+    return BindPolicy::kSpread;
+  }
+  throw std::runtime_error("PPC_BIND must be none, compact or spread, got: " + val.value());
+}
+
+NumaPolicy GetNumaPolicy() {
+  const auto val = env::get<std::string>("PPC_NUMA");
+  if (!val.has_value() || val.value().empty() || val.value() == "none") {
+    return NumaPolicy::kNone;
+  }
+  if (val.value() == "migrate") {
+    return NumaPolicy::kMigrate;
+  }
+  if (val.value() == "interleave") {
+    return NumaPolicy::kInterleave;
+  }
+  throw std::runtime_error("PPC_NUMA must be none, migrate or interleave, got: " + val.value());
+}
+
+std::string_view ToString(BindPolicy policy) {
+  switch (policy) {
+    case BindPolicy::kCompact:
+      return "compact";
+    case BindPolicy::kSpread:
+      return "spread";
+    case BindPolicy::kNone:
+    default:
+      return "none";
+  }
+}
+
+std::string_view ToString(NumaPolicy policy) {
+  switch (policy) {
+    case NumaPolicy::kMigrate:
+      return "migrate";
+    case NumaPolicy::kInterleave:
+      return "interleave";
+    case NumaPolicy::kNone:
+    default:
+      return "none";
+  }
+}
+
+std::size_t CpuTopology::NumCpus() const {
+  return std::accumulate(node_cpus.begin(), node_cpus.end(), std::size_t{0},
+                         [](std::size_t sum, const std::vector<int> &cpus) { return sum + cpus.size(); });
+}
+
+CpuTopology GetCpuTopology() {
+  CpuTopology topology;
+#ifdef __linux__
+  std::error_code ec;
+  std::vector<std::pair<int, std::vector<int>>> nodes;
+  for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const auto name = entry.path().filename().string();
+    int id = 0;
+    if (!name.starts_with("node") ||
+        std::from_chars(name.data() + 4, name.data() + name.size(), id).ec != std::errc{}) {
+      continue;
+    }
+    auto cpus = ParseCpuList(ReadFirstLine(entry.path() / "cpulist"));
+    if (!cpus.empty()) {
+      nodes.emplace_back(id, std::move(cpus));
+    }
+  }
+  std::ranges::sort(nodes);
+  for (auto &[id, cpus] : nodes) {
+    topology.node_ids.push_back(id);
+    topology.node_cpus.push_back(std::move(cpus));
+  }
+#endif
+  if (topology.node_cpus.empty()) {
+    std::vector<int> cpus(std::max(1U, std::thread::hardware_concurrency()));
+    std::iota(cpus.begin(), cpus.end(), 0);
+    topology.node_ids = {0};
+    topology.node_cpus = {std::move(cpus)};
+  }
+  return topology;
+}
+
+std::vector<int> ParseCpuList(std::string_view list) {
+  std::vector<int> cpus;
+  auto parse_number = [list](std::string_view token) {
+    int value = 0;
+    const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc{} || end != token.data() + token.size() || value < 0) {
+      throw std::runtime_error("Malformed CPU list: " + std::string(list));
+    }
+    return value;
+  };
+  while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+    list.remove_suffix(1);
+  }
+  std::string_view rest = list;
+  while (!rest.empty()) {
+    const auto comma = rest.find(',');
+    const auto token = rest.substr(0, comma);
+    const auto dash = token.find('-');
+    const int first = parse_number(token.substr(0, dash));
+    const int last = dash == std::string_view::npos ? first : parse_number(token.substr(dash + 1));
+    if (last < first) {
+      throw std::runtime_error("Malformed CPU list: " + std::string(list));
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+    rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+  }
+  return cpus;
+}
+
+std::string FormatCpuList(std::span<const int> cpus) {
+  std::string list;
+  for (std::size_t i = 0; i < cpus.size();) {
+    std::size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+      j++;
+    }
+    if (!list.empty()) {
+      list += ',';
+    }
+    list += std::to_string(cpus[i]);
+    if (j > i) {
+      list += '-' + std::to_string(cpus[j]);
+    }
+    i = j + 1;
+  }
+  return list;
+}
+
+std::vector<int> AssignCpus(const CpuTopology &topology, BindPolicy policy, int local_rank, int num_threads) {
+  if (policy == BindPolicy::kNone || topology.node_cpus.empty()) {
+    return {};
+  }
+  const auto threads = static_cast<std::size_t>(std::max(1, num_threads));
+  const auto rank = static_cast<std::size_t>(std::max(0, local_rank));
+  std::vector<int> cpus;
+  cpus.reserve(threads);
+  if (policy == BindPolicy::kCompact) {
+    std::vector<int> all;
+    for (const auto &node : topology.node_cpus) {
+      all.insert(all.end(), node.begin(), node.end());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+      cpus.push_back(all[((rank * threads) + i) % all.size()]);
+    }
+  } else {
+    const auto &node = topology.node_cpus[rank % topology.node_cpus.size()];
+    const std::size_t slot = rank / topology.node_cpus.size();
+    for (std::size_t i = 0; i < threads; i++) {
+      cpus.push_back(node[((slot * threads) + i) % node.size()]);
+    }
+  }
+  return cpus;
+}
+
+void ApplyPlacement(int local_rank, int num_threads) {
+  auto &state = State();
+  state.topology = GetCpuTopology();
+  state.placement.bind = GetBindPolicy();
+  state.placement.numa = GetNumaPolicy();
+  state.placement.numa_nodes = static_cast<int>(state.topology.node_cpus.size());
+#ifdef __linux__
+  if (state.placement.numa == NumaPolicy::kInterleave && state.placement.numa_nodes > 1) {
+    const auto mask = MakeNodeMask(state.topology.node_ids);
+    syscall(SYS_set_mempolicy, kMpolInterleave, mask.data(), kMaxNumaNodes);
+  }
+  auto cpus = AssignCpus(state.topology, state.placement.bind, local_rank, num_threads);
+  if (cpus.empty() || !SetThreadAffinity(cpus)) {
+    return;
+  }
+  state.placement.cpus = std::move(cpus);
+
+  // Create the OpenMP pool now so that its workers are pinned for the rest of the run
+#  pragma omp parallel num_threads(num_threads)
+  {
+    if (omp_get_thread_num() != 0) {
+      PinCurrentThread(omp_get_thread_num());
+    }
+  }
+  static const auto kTbbObserver = std::make_unique<PinningObserver>();
+#else
+  (void)local_rank;
+  (void)num_threads;
+#endif
+}
+
+const Placement &GetPlacement() {
+  return State().placement;
+}
+
+void PinCurrentThread(int index) {
+#ifdef __linux__
+  const auto &cpus = State().placement.cpus;
+  if (!cpus.empty()) {
+    const auto cpu = cpus[static_cast<std::size_t>(std::max(0, index)) % cpus.size()];
+    SetThreadAffinity(std::span<const int>(&cpu, 1));
+  }
+#else
+  (void)index;
+#endif
+}
+
+bool PlaceBuffer(std::span<const std::byte> buffer) {
+#ifdef __linux__
+  const auto &state = State();
+  if (state.placement.numa == NumaPolicy::kNone || state.placement.numa_nodes < 2 || buffer.empty()) {
+    return true;
+  }
+  const auto page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = reinterpret_cast<std::uintptr_t>(buffer.data()) & ~(page - 1);  // NOLINT(*-reinterpret-cast)
+  const auto end = (reinterpret_cast<std::uintptr_t>(buffer.data() + buffer.size()) + page - 1) &  // NOLINT
+                   ~(page - 1);
+  int mode = kMpolInterleave;
+  NodeMask mask;
+  if (state.placement.numa == NumaPolicy::kInterleave) {
+    mask = MakeNodeMask(state.topology.node_ids);
+  } else {
+    // The node of the rank: of its first bound CPU, or of the CPU it runs on now if it is not bound
+    const int cpu = state.placement.cpus.empty() ? sched_getcpu() : state.placement.cpus.front();
+    const auto node = static_cast<std::size_t>(NodeIndexOfCpu(state.topology, cpu));
+    mode = kMpolPreferred;
+    mask = MakeNodeMask(std::span<const int>(&state.topology.node_ids[node], 1));
+  }
+  return syscall(SYS_mbind, begin, end - begin, mode, mask.data(), kMaxNumaNodes, kMpolMfMove) == 0;
+#else
+  (void)buffer;
+  return true;
+#endif
+}
+
+}  // namespace ppc::util
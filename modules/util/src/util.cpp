@@ -2,9 +2,15 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
+#include <cstddef>
 #include <filesystem>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 namespace {
 
@@ -52,6 +58,64 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+uint64_t ppc::util::GetPerfWarmup() {
+  const auto val = env::get<uint64_t>("PPC_PERF_WARMUP");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0;
+}
+
+double ppc::util::GetPerfMaxCv() {
+  const auto val = env::get<double>("PPC_PERF_MAX_CV");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0.0;
+}
+
+std::string ppc::util::GetPerfOutputPath() {
+  const auto val = env::get<std::string>("PPC_PERF_OUTPUT");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
+std::vector<std::size_t> ppc::util::GetPerfSizes() {
+  const auto val = env::get<std::string>("PPC_PERF_SIZES");
+  if (!val.has_value()) {
+    return {};
+  }
+  std::vector<std::size_t> sizes;
+  std::string_view list = val.value();
+  while (!list.empty()) {
+    const auto comma = list.find(',');
+    const auto item = list.substr(0, comma);
+    std::size_t size = 0;
+    const auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), size);
+    if (ec != std::errc() || end != item.data() + item.size() || size == 0) {
+      throw std::runtime_error("PPC_PERF_SIZES must be a comma-separated list of positive integers: " + val.value());
+    }
+    sizes.push_back(size);
+    list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+  }
+  return sizes;
+}
+
+bool ppc::util::IsNodeSharedInputEnabled() {
+  const auto val = env::get<int>("PPC_SHARED_INPUT");
+  return val.has_value() && val.value() != 0;
+}
+
+std::string ppc::util::GetTraceDir() {
+  const auto val = env::get<std::string>("PPC_TRACE");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
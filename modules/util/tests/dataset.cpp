@@ -0,0 +1,100 @@
+#include "util/include/dataset.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+namespace {
+
+std::string TempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / ("ppc_dataset_" + name + ".bin")).string();
+}
+
+}  // namespace
+
+TEST(DatasetTest, Crc32MatchesReferenceValue) {
+  constexpr std::string_view kCheck = "123456789";
+  EXPECT_EQ(Crc32(std::as_bytes(std::span(kCheck))), 0xCBF43926U);
+}
+
+TEST(DatasetTest, WriteAndOpenRoundTrip) {
+  const std::string path = TempPath("round_trip");
+  const std::vector<double> data = {1.5, -2.0, 3.25, 4.0, 0.0, -6.5};
+  WriteDataset(path, std::span<const double>(data), {2, 3});
+
+  const auto dataset = MappedDataset::Open(path);
+  EXPECT_EQ(dataset.Header().type, DataType::kFloat64);
+  EXPECT_EQ(dataset.Header().shape, (std::vector<uint64_t>{2, 3}));
+  EXPECT_EQ(dataset.Header().RowElements(), 3U);
+  const auto view = dataset.View<double>();
+  EXPECT_EQ(std::vector<double>(view.begin(), view.end()), data);
+  EXPECT_THROW((void)dataset.View<float>(), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(DatasetTest, SlicesCoverAllRowsAcrossPages) {
+  const std::string path = TempPath("slices");
+  // Rows of 3 ints, enough of them for slices to start inside pages
+  std::vector<int32_t> data(3 * 5000);
+  for (std::size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<int32_t>(i * 7);
+  }
+  WriteDataset(path, std::span<const int32_t>(data), {5000, 3});
+
+  constexpr int kParts = 3;
+  std::vector<int32_t> joined;
+  for (int part = 0; part < kParts; part++) {
+    const auto slice = MappedDataset::OpenSlice(path, part, kParts);
+    const auto rows = BlockPartition(5000, kParts).Range(part);
+    EXPECT_EQ(slice.Rows().begin, rows.begin);
+    EXPECT_EQ(slice.Rows().end, rows.end);
+    const auto view = slice.View<int32_t>();
+    ASSERT_EQ(view.size(), rows.Size() * 3);
+    joined.insert(joined.end(), view.begin(), view.end());
+  }
+  EXPECT_EQ(joined, data);
+  EXPECT_THROW((void)MappedDataset::OpenRows(path, {.begin = 10, .end = 5001}), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(DatasetTest, EmptyDatasetHasNoElements) {
+  const std::string path = TempPath("empty");
+  WriteDataset(path, std::span<const int64_t>{});
+  const auto dataset = MappedDataset::Open(path);
+  EXPECT_EQ(dataset.Header().Elements(), 0U);
+  EXPECT_TRUE(dataset.View<int64_t>().empty());
+  std::filesystem::remove(path);
+}
+
+TEST(DatasetTest, CorruptedFilesAreRejected) {
+  const std::string path = TempPath("corrupted");
+  const std::vector<uint8_t> data(100, 1);
+  WriteDataset(path, std::span<const uint8_t>(data));
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(64 + 10);
+    file.put('\x02');
+  }
+  EXPECT_THROW((void)MappedDataset::Open(path), std::runtime_error);
+  EXPECT_NO_THROW((void)MappedDataset::Open(path, ChecksumCheck::kSkip));
+
+  std::filesystem::resize_file(path, 64 + 50);
+  EXPECT_THROW((void)ReadDatasetHeader(path), std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW((void)ReadDatasetHeader(path), std::runtime_error);
+  EXPECT_THROW(WriteDataset(path, std::span<const uint8_t>(data), {3, 3}), std::runtime_error);
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,107 @@
+#include "util/include/gemm.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "util/include/random.hpp"
+
+namespace ppc::util {
+
+namespace {
+
+std::vector<double> RandomMatrix(std::size_t rows, std::size_t cols, uint64_t stream) {
+  std::vector<double> matrix(rows * cols);
+  FillUniform(CounterRng(7, stream), std::span<double>(matrix), 0, -1.0, 1.0);
+  return matrix;
+}
+
+}  // namespace
+
+TEST(GemmTest, BlockedKernelsMatchReference) {
+  // Shapes around the register tiles and the cache blocks, including ragged edges on every level
+  const std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> shapes = {
+      {1, 1, 1}, {5, 7, 3}, {6, 8, 256}, {13, 17, 257}, {97, 33, 300}, {20, 2050, 9}};
+  for (const auto &[m, n, k] : shapes) {
+    const auto a = RandomMatrix(m, k, 0);
+    const auto b = RandomMatrix(k, n, 1);
+    std::vector<double> expected(m * n);
+    Gemm(m, n, k, a.data(), k, b.data(), n, expected.data(), n, GemmKernel::kReference);
+    for (auto kernel : {GemmKernel::kScalar, GemmKernel::kAvx2, GemmKernel::kAvx512}) {
+      if (!IsGemmKernelSupported(kernel)) {
+        continue;
+      }
+      std::vector<double> c(m * n, 42.0);
+      Gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n, kernel);
+      for (std::size_t i = 0; i < c.size(); i++) {
+        ASSERT_NEAR(c[i], expected[i], 1e-12 * static_cast<double>(k)) << ToString(kernel) << " " << m << "x" << n
+                                                                        << "x" << k << " at " << i;
+      }
+    }
+  }
+}
+
+TEST(GemmTest, MultipliesBlocksOfLargerMatrices) {
+  // The top-right 3 x 2 block of a 4 x 5 matrix times a 2 x 2 matrix, written from (1, 1) of a 5 x 4 one
+  const std::vector<double> a = {0, 0, 0, 1, 2, 0, 0, 0, 3, 4, 0, 0, 0, 5, 6, 0, 0, 0, 0, 0};
+  const std::vector<double> b = {1, 2, 3, 4};
+  std::vector<double> c(20, -1.0);
+  Gemm(3, 2, 2, a.data() + 3, 5, b.data(), 2, c.data() + 5, 4, GemmKernel::kScalar);
+  EXPECT_EQ(c, (std::vector<double>{-1, -1, -1, -1, -1, 7, 10, -1, -1, 15, 22, -1, -1, 23, 34, -1, -1, -1, -1, -1}));
+
+  // An empty inner dimension gives zeros
+  std::vector<double> zeros(4, 1.0);
+  Gemm(2, 2, 0, std::span<const double>{}, std::span<const double>{}, zeros);
+  EXPECT_EQ(zeros, std::vector<double>(4, 0.0));
+  EXPECT_THROW(Gemm(2, 2, 3, std::span<const double>(b), std::span<const double>(b), zeros), std::runtime_error);
+}
+
+TEST(GemmTest, AccumulateAddsToResult) {
+  const auto a = RandomMatrix(19, 300, 2);
+  const auto b = RandomMatrix(300, 21, 3);
+  std::vector<double> expected(19 * 21);
+  Gemm(19, 21, 300, a.data(), 300, b.data(), 21, expected.data(), 21, GemmKernel::kReference);
+  for (auto kernel : {GemmKernel::kReference, GemmKernel::kScalar, GemmKernel::kAvx2, GemmKernel::kAvx512}) {
+    if (!IsGemmKernelSupported(kernel)) {
+      continue;
+    }
+    // Two k-panels summed into C that starts at 1
+    std::vector<double> c(expected.size(), 1.0);
+    GemmAccumulate(19, 21, 120, a.data(), 300, b.data(), 21, c.data(), 21, kernel);
+    GemmAccumulate(19, 21, 180, a.data() + 120, 300, b.data() + (120 * 21), 21, c.data(), 21, kernel);
+    GemmAccumulate(19, 21, 0, a.data(), 300, b.data(), 21, c.data(), 21, kernel);
+    for (std::size_t i = 0; i < c.size(); i++) {
+      ASSERT_NEAR(c[i], expected[i] + 1.0, 1e-10) << ToString(kernel) << " at " << i;
+    }
+  }
+}
+
+TEST(GemmTest, KernelCanBeChosenFromEnvironment) {
+  {
+    const env::detail::set_scoped_environment_variable kernel("PPC_GEMM_KERNEL", "reference");
+    EXPECT_EQ(GetGemmKernel(), GemmKernel::kReference);
+  }
+  EXPECT_TRUE(IsGemmKernelSupported(GetGemmKernel()));
+  const env::detail::set_scoped_environment_variable kernel("PPC_GEMM_KERNEL", "neon");
+  EXPECT_THROW(GetGemmKernel(), std::runtime_error);
+}
+
+TEST(GemmTest, DefaultKernelIsChosenOnce) {
+  const std::vector<double> a = {1, 2, 3, 4};
+  const std::vector<double> b = {1, 0, 0, 1};
+  std::vector<double> c(4);
+  Gemm(2, 2, 2, a, b, c);
+
+  // Later changes of the variable do not reach the overloads without a kernel
+  const env::detail::set_scoped_environment_variable kernel("PPC_GEMM_KERNEL", "neon");
+  EXPECT_NO_THROW(Gemm(2, 2, 2, a, b, c));
+  EXPECT_EQ(c, a);
+}
+
+}  // namespace ppc::util
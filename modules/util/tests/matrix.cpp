@@ -0,0 +1,64 @@
+#include "util/include/matrix.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace ppc::util {
+
+TEST(MatrixTest, StorageIsCacheLineAligned) {
+  const Matrix<double> matrix(3, 5, 1.5);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.Data()) % kCacheLineSize, 0U);
+  EXPECT_EQ(matrix.Stride(), 5U);
+  EXPECT_FALSE(matrix.IsPadded());
+  EXPECT_DOUBLE_EQ(matrix(2, 4), 1.5);
+}
+
+TEST(MatrixTest, PaddedRowsStartOnCacheLines) {
+  Matrix<double> matrix(4, 5, 0.0, RowPadding::kCacheLine);
+  EXPECT_EQ(matrix.Stride(), 8U);
+  EXPECT_TRUE(matrix.IsPadded());
+  for (std::size_t i = 0; i < matrix.Rows(); i++) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.Row(i).data()) % kCacheLineSize, 0U);
+    EXPECT_EQ(matrix.Row(i).size(), 5U);
+  }
+  matrix(1, 2) = 7.0;
+  EXPECT_DOUBLE_EQ(matrix.Data()[10], 7.0);
+}
+
+TEST(MatrixTest, RowAndColumnViewsAliasStorage) {
+  Matrix<int> matrix(3, 4, 0, RowPadding::kCacheLine);
+  for (std::size_t i = 0; i < 3; i++) {
+    for (std::size_t j = 0; j < 4; j++) {
+      matrix(i, j) = static_cast<int>((i * 10) + j);
+    }
+  }
+  const auto col = matrix.Col(2);
+  ASSERT_EQ(col.Size(), 3U);
+  EXPECT_EQ(col[0], 2);
+  EXPECT_EQ(col[2], 22);
+  matrix.Row(1)[3] = -1;
+  EXPECT_EQ(matrix(1, 3), -1);
+  matrix.Col(0)[2] = -2;
+  EXPECT_EQ(matrix(2, 0), -2);
+}
+
+TEST(MatrixTest, ConvertsFromAndToRows) {
+  const std::vector<std::vector<double>> rows = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+  const auto matrix = Matrix<double>::FromRows(rows);
+  EXPECT_EQ(matrix.Rows(), 2U);
+  EXPECT_EQ(matrix.Cols(), 3U);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 4.0);
+  EXPECT_EQ(matrix.ToRows(), rows);
+  EXPECT_EQ(Matrix<double>::FromRows(rows, RowPadding::kCacheLine), matrix);
+  EXPECT_TRUE(Matrix<double>::FromRows({}).Empty());
+}
+
+TEST(MatrixTest, FromRowsRejectsRaggedRows) {
+  EXPECT_THROW((void)Matrix<int>::FromRows({{1, 2}, {3}}), std::runtime_error);
+}
+
+}  // namespace ppc::util
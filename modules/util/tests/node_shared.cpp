@@ -0,0 +1,66 @@
+#include "util/include/node_shared.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+// Both distributions on the real communicator: every rank has to see the root's data, whichever rank is the root.
+// Runs when core_func_tests is started under mpirun (see run_tests.py), skipped otherwise
+TEST(NodeSharedBufferMpiTest, BothDistributionsMatchTheRootData) {
+  if (!IsUnderMpirun()) {
+    GTEST_SKIP();
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  for (std::size_t count : {0U, 1U, 1000U}) {
+    std::vector<int> expected(count);
+    for (std::size_t i = 0; i < count; i++) {
+      expected[i] = static_cast<int>((i * 31) % 1009) - 500;
+    }
+    for (int root : {0, size - 1}) {
+      const std::vector<int> root_data = rank == root ? expected : std::vector<int>();
+      const auto broadcast = NodeSharedBuffer::FromRoot(root_data, root, MPI_COMM_WORLD, InputDistribution::kBroadcast);
+      const auto shared = NodeSharedBuffer::FromRoot(root_data, root, MPI_COMM_WORLD, InputDistribution::kNodeShared);
+      SCOPED_TRACE("count " + std::to_string(count) + ", root " + std::to_string(root));
+
+      EXPECT_FALSE(broadcast.IsNodeShared());
+      EXPECT_TRUE(shared.IsNodeShared());
+      ASSERT_EQ(broadcast.SizeBytes(), count * sizeof(int));
+      ASSERT_EQ(shared.SizeBytes(), count * sizeof(int));
+      const auto broadcast_view = broadcast.View<int>();
+      const auto shared_view = shared.View<int>();
+      EXPECT_EQ(std::vector<int>(broadcast_view.begin(), broadcast_view.end()), expected);
+      EXPECT_EQ(std::vector<int>(shared_view.begin(), shared_view.end()), expected);
+      if (rank == root) {
+        // The root broadcasts from its own buffer instead of copying it
+        EXPECT_EQ(broadcast_view.data(), root_data.data());
+      }
+    }
+  }
+}
+
+TEST(NodeSharedBufferMpiTest, MovedBufferKeepsTheWindow) {
+  if (!IsUnderMpirun()) {
+    GTEST_SKIP();
+  }
+  const std::vector<double> data = {1.0, 2.0, 3.0};
+  auto buffer = NodeSharedBuffer::FromRoot(data, 0, MPI_COMM_WORLD, InputDistribution::kNodeShared);
+  NodeSharedBuffer moved(std::move(buffer));
+  EXPECT_TRUE(moved.IsNodeShared());
+  EXPECT_FALSE(buffer.IsNodeShared());  // NOLINT(bugprone-use-after-move)
+  const auto view = moved.View<double>();
+  EXPECT_EQ(std::vector<double>(view.begin(), view.end()), data);
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,124 @@
+#include "util/include/partition.hpp"
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace ppc::util {
+
+namespace {
+
+// Reference owner lookup: linear scan over the blocks
+int ScanOwner(const BlockPartition &partition, std::size_t index) {
+  for (int part = 0; part < partition.Parts(); part++) {
+    if (partition.Range(part).Contains(index)) {
+      return part;
+    }
+  }
+  return -1;
+}
+
+void ExpectConsistent(const BlockPartition &partition, std::size_t total) {
+  EXPECT_EQ(partition.Total(), total);
+  EXPECT_EQ(partition.Begin(0), 0U);
+  EXPECT_EQ(partition.End(partition.Parts() - 1), total);
+  for (int part = 1; part < partition.Parts(); part++) {
+    EXPECT_EQ(partition.Begin(part), partition.End(part - 1));
+  }
+  for (std::size_t index = 0; index < total; index++) {
+    ASSERT_EQ(partition.Owner(index), ScanOwner(partition, index)) << "index " << index;
+  }
+}
+
+}  // namespace
+
+TEST(PartitionTest, EvenPartitionBalancesBlocks) {
+  const BlockPartition partition(10, 3);
+  EXPECT_EQ(partition.Parts(), 3);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{4, 3, 3}));
+  EXPECT_EQ(partition.Displs(), (std::vector<int>{0, 4, 7}));
+  EXPECT_EQ(partition.Range(1).begin, 4U);
+  EXPECT_EQ(partition.Range(1).end, 7U);
+}
+
+TEST(PartitionTest, OwnerMatchesBlocksForManyShapes) {
+  for (std::size_t total : {0UL, 1UL, 5UL, 64UL, 1001UL}) {
+    for (int parts : {1, 2, 3, 7, 16}) {
+      for (std::size_t granule : {1UL, 4UL, 16UL}) {
+        ExpectConsistent(BlockPartition(total, parts, granule), total);
+      }
+    }
+  }
+}
+
+TEST(PartitionTest, MorePartsThanElementsLeavesEmptyBlocks) {
+  const BlockPartition partition(2, 4);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{1, 1, 0, 0}));
+  EXPECT_EQ(partition.Owner(1), 1);
+}
+
+TEST(PartitionTest, GranuleAlignsInnerBoundaries) {
+  const std::size_t granule = CacheLineGranule<double>();
+  EXPECT_EQ(granule, 8U);
+  const BlockPartition partition(100, 3, granule);
+  for (int part = 0; part < partition.Parts() - 1; part++) {
+    EXPECT_EQ(partition.End(part) % granule, 0U);
+  }
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{40, 32, 28}));
+}
+
+TEST(PartitionTest, ScaledCountsDescribeRowBlocks) {
+  const BlockPartition rows(5, 2);
+  EXPECT_EQ(rows.Counts(10), (std::vector<int>{30, 20}));
+  EXPECT_EQ(rows.Displs(10), (std::vector<int>{0, 30}));
+  EXPECT_THROW((void)BlockPartition(INT_MAX, 1).Counts(2), std::runtime_error);
+}
+
+TEST(PartitionTest, WeightedPartitionFollowsWeights) {
+  const std::vector<double> weights = {1.0, 3.0, 0.0, 4.0};
+  const auto partition = BlockPartition::Weighted(80, weights);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{10, 30, 0, 40}));
+  ExpectConsistent(partition, 80);
+}
+
+TEST(PartitionTest, WeightedPartitionDistributesRemainder) {
+  const std::vector<double> weights = {1.0, 1.0, 1.0};
+  const auto partition = BlockPartition::Weighted(100, weights, 4);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{36, 32, 32}));
+  ExpectConsistent(partition, 100);
+}
+
+TEST(PartitionTest, BalancedPartitionSplitsByCost) {
+  // Row 0 carries half of the cost: it gets a part of its own, the other rows share the rest
+  const std::vector<std::int64_t> prefix = {0, 12, 14, 16, 18, 20, 22, 24};
+  const auto partition = BlockPartition::Balanced(prefix, 2);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{1, 6}));
+  ExpectConsistent(partition, 7);
+
+  const std::vector<std::int64_t> uniform = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+  EXPECT_EQ(BlockPartition::Balanced(uniform, 4).Counts(), (std::vector<int>{2, 2, 2, 2}));
+  EXPECT_EQ(BlockPartition::Balanced(std::vector<std::int64_t>{0}, 3).Counts(), (std::vector<int>{0, 0, 0}));
+
+  // Ranks that did not see the costs rebuild the partition from its boundaries
+  const auto copy = BlockPartition::FromBoundaries({0, 1, 7});
+  EXPECT_EQ(copy.Counts(), partition.Counts());
+  ExpectConsistent(copy, 7);
+}
+
+TEST(PartitionTest, InvalidArgumentsThrow) {
+  EXPECT_THROW(BlockPartition(10, 0), std::runtime_error);
+  EXPECT_THROW(BlockPartition(10, 2, 0), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::Weighted(10, std::vector<double>{}), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::Weighted(10, std::vector<double>{0.0, 0.0}), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::Weighted(10, std::vector<double>{1.0, -1.0}), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::Balanced(std::vector<std::int64_t>{0, 2, 1}, 2), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::Balanced(std::vector<std::int64_t>{}, 2), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::FromBoundaries({0}), std::runtime_error);
+  EXPECT_THROW((void)BlockPartition::FromBoundaries({1, 4}), std::runtime_error);
+}
+
+}  // namespace ppc::util
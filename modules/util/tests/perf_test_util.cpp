@@ -0,0 +1,127 @@
+#include "util/include/perf_test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/environment.hpp>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace sized_perf_test_task {
+
+class SizedSeqTask : public ppc::task::Task<std::vector<int>, int> {
+ public:
+  explicit SizedSeqTask(std::vector<int> in) {
+    GetInput() = std::move(in);
+  }
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+}  // namespace sized_perf_test_task
+
+namespace {
+
+class SizedPerfTasksTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto json = ppc::util::InitJSONPtr();
+    (*json)["tasks"]["seq"] = "enabled";
+    std::ofstream(settings_path_) << json->dump();
+  }
+  void TearDown() override {
+    std::filesystem::remove(settings_path_);
+  }
+
+  std::string settings_path_ = (std::filesystem::temp_directory_path() / "sized_perf_settings.json").string();
+};
+
+constexpr auto kSizeIndex = static_cast<std::size_t>(ppc::util::GTestParamIndex::kProblemSize);
+constexpr auto kNameIndex = static_cast<std::size_t>(ppc::util::GTestParamIndex::kNameTest);
+
+}  // namespace
+
+TEST_F(SizedPerfTasksTest, CreatesBothModesForEverySize) {
+  const auto params =
+      ppc::util::MakeAllPerfTasks<std::vector<int>, sized_perf_test_task::SizedSeqTask>(settings_path_, {10, 200});
+  ASSERT_EQ(params.size(), 4U);
+  EXPECT_EQ(std::get<kNameIndex>(params[0]), "sized_perf_test_task_seq_enabled_size10");
+  EXPECT_EQ(std::get<kSizeIndex>(params[0]), 10U);
+  EXPECT_EQ(std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(params[1]),
+            ppc::performance::PerfResults::TypeOfRunning::kTaskRun);
+  EXPECT_EQ(std::get<kNameIndex>(params[3]), "sized_perf_test_task_seq_enabled_size200");
+  EXPECT_EQ(std::get<kSizeIndex>(params[3]), 200U);
+}
+
+TEST_F(SizedPerfTasksTest, UnsizedCasesKeepTheirNames) {
+  const auto params = ppc::util::MakeAllPerfTasks<std::vector<int>, sized_perf_test_task::SizedSeqTask>(settings_path_);
+  EXPECT_EQ(std::get<kNameIndex>(std::get<0>(params)), "sized_perf_test_task_seq_enabled");
+  EXPECT_EQ(std::get<kSizeIndex>(std::get<0>(params)), 0U);
+}
+
+TEST_F(SizedPerfTasksTest, EnvironmentReplacesDeclaredSizes) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_SIZES", "7,9");
+  const auto params =
+      ppc::util::MakeAllPerfTasks<std::vector<int>, sized_perf_test_task::SizedSeqTask>(settings_path_, {10});
+  ASSERT_EQ(params.size(), 4U);
+  EXPECT_EQ(std::get<kSizeIndex>(params[0]), 7U);
+  EXPECT_EQ(std::get<kSizeIndex>(params[2]), 9U);
+}
+
+TEST(PerfTestUtilTests, GetInputBytesCountsContiguousBuffers) {
+  EXPECT_EQ(ppc::util::GetInputBytes(std::vector<int32_t>(10)), 40U);
+  EXPECT_EQ(ppc::util::GetInputBytes(std::string("abc")), 3U);
+  EXPECT_EQ(ppc::util::GetInputBytes(7), sizeof(int));
+}
+
+TEST(PerfTestUtilTests, GetInputBytesFollowsNestedRangesAndTuples) {
+  const std::vector<std::vector<double>> matrix(3, std::vector<double>(4));
+  EXPECT_EQ(ppc::util::GetInputBytes(matrix), 3U * 4U * sizeof(double));
+
+  const auto strings = std::make_pair(std::string("ab"), std::string("cde"));
+  EXPECT_EQ(ppc::util::GetInputBytes(strings), 5U);
+
+  const std::tuple<int, std::vector<int64_t>> mixed{1, std::vector<int64_t>(2)};
+  EXPECT_EQ(ppc::util::GetInputBytes(mixed), sizeof(int) + (2U * sizeof(int64_t)));
+}
+
+TEST(PerfTestUtilTests, CollectInputBuffersDetectsMoveAndCopy) {
+  std::tuple<int, std::vector<int>, std::vector<double>> input{1, std::vector<int>(5), std::vector<double>(3)};
+  std::vector<const void *> before;
+  ppc::util::CollectInputBuffers(input, before);
+  ASSERT_EQ(before.size(), 2U);
+
+  const auto copied = input;
+  std::vector<const void *> copied_buffers;
+  ppc::util::CollectInputBuffers(copied, copied_buffers);
+  EXPECT_NE(copied_buffers, before);
+
+  const auto moved = std::move(input);
+  std::vector<const void *> moved_buffers;
+  ppc::util::CollectInputBuffers(moved, moved_buffers);
+  EXPECT_EQ(moved_buffers, before);
+}
@@ -0,0 +1,70 @@
+#include "util/include/placement.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ppc::util {
+
+TEST(PlacementTest, ParsesAndFormatsCpuLists) {
+  EXPECT_EQ(ParseCpuList("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_TRUE(ParseCpuList("").empty());
+  EXPECT_EQ(FormatCpuList(std::vector<int>{0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+  EXPECT_EQ(FormatCpuList(std::vector<int>{5}), "5");
+  EXPECT_EQ(FormatCpuList(std::vector<int>{}), "");
+  EXPECT_THROW(ParseCpuList("0-a"), std::runtime_error);
+  EXPECT_THROW(ParseCpuList("3-1"), std::runtime_error);
+}
+
+TEST(PlacementTest, AssignsCpusOfDualSocketNode) {
+  const CpuTopology topology{.node_ids = {0, 1}, .node_cpus = {{0, 1, 2, 3}, {4, 5, 6, 7}}};
+  EXPECT_EQ(topology.NumCpus(), 8U);
+  EXPECT_TRUE(AssignCpus(topology, BindPolicy::kNone, 0, 2).empty());
+
+  // Compact fills socket 0 first
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kCompact, 0, 2), (std::vector<int>{0, 1}));
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kCompact, 1, 2), (std::vector<int>{2, 3}));
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kCompact, 2, 2), (std::vector<int>{4, 5}));
+
+  // Spread alternates the sockets
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kSpread, 0, 2), (std::vector<int>{0, 1}));
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kSpread, 1, 2), (std::vector<int>{4, 5}));
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kSpread, 2, 2), (std::vector<int>{2, 3}));
+
+  // Oversubscription wraps around
+  EXPECT_EQ(AssignCpus(topology, BindPolicy::kCompact, 3, 3), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(PlacementTest, ReadsPoliciesFromEnvironment) {
+  {
+    const env::detail::set_scoped_environment_variable bind("PPC_BIND", "spread");
+    const env::detail::set_scoped_environment_variable numa("PPC_NUMA", "interleave");
+    EXPECT_EQ(GetBindPolicy(), BindPolicy::kSpread);
+    EXPECT_EQ(GetNumaPolicy(), NumaPolicy::kInterleave);
+    EXPECT_EQ(ToString(GetNumaPolicy()), "interleave");
+  }
+  {
+    const env::detail::set_scoped_environment_variable numa("PPC_NUMA", "migrate");
+    EXPECT_EQ(GetNumaPolicy(), NumaPolicy::kMigrate);
+    EXPECT_EQ(ToString(GetNumaPolicy()), "migrate");
+  }
+  const env::detail::set_scoped_environment_variable bind("PPC_BIND", "sockets");
+  EXPECT_THROW(GetBindPolicy(), std::runtime_error);
+  const env::detail::set_scoped_environment_variable numa("PPC_NUMA", "nearest");
+  EXPECT_THROW(GetNumaPolicy(), std::runtime_error);
+}
+
+TEST(PlacementTest, TopologyCoversTheMachine) {
+  const auto topology = GetCpuTopology();
+  ASSERT_FALSE(topology.node_cpus.empty());
+  EXPECT_EQ(topology.node_ids.size(), topology.node_cpus.size());
+  EXPECT_GE(topology.NumCpus(), std::size_t{1});
+  // Unbound processes and single-node machines leave buffers alone
+  const std::vector<std::byte> buffer(4096);
+  EXPECT_TRUE(PlaceBuffer(buffer));
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,61 @@
+#include "util/include/random.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ppc::util {
+
+TEST(RandomTest, PhiloxMatchesKnownAnswerVectors) {
+  EXPECT_EQ(Philox4x32::Generate({0, 0, 0, 0}, {0, 0}),
+            (Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(Philox4x32::Generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+            (Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(Philox4x32::Generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+            (Philox4x32::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(RandomTest, ValuesDependOnlyOnSeedStreamAndIndex) {
+  const CounterRng rng(42);
+  EXPECT_EQ(rng.Uint64(7), CounterRng(42).Uint64(7));
+  EXPECT_NE(rng.Uint64(7), rng.Uint64(8));
+  EXPECT_NE(rng.Uint64(7), CounterRng(43).Uint64(7));
+  EXPECT_NE(rng.Uint64(7), rng.Stream(1).Uint64(7));
+}
+
+TEST(RandomTest, UniformValuesStayInRange) {
+  const CounterRng rng(1);
+  for (uint64_t index = 0; index < 10000; index++) {
+    const double real = rng.Uniform(index, -2.0, 3.0);
+    ASSERT_GE(real, -2.0);
+    ASSERT_LT(real, 3.0);
+    const int value = rng.UniformInt(index, -5, 5);
+    ASSERT_GE(value, -5);
+    ASSERT_LE(value, 5);
+  }
+  EXPECT_EQ(rng.UniformInt(3, 9, 9), 9);
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+  const auto full = rng.UniformInt(3, kMin, std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(static_cast<uint64_t>(full) - static_cast<uint64_t>(kMin), rng.Uint64(3));
+}
+
+TEST(RandomTest, FillUniformIsIndependentOfSplit) {
+  const CounterRng rng(2024);
+  std::vector<int> whole(1000);
+  FillUniform(rng, std::span(whole), 0, -100, 100);
+
+  // Blocks filled separately, as different ranks would, with their global offsets
+  std::vector<int> joined(whole.size());
+  const std::span<int> out(joined);
+  FillUniform(rng, out.first(333), 0, -100, 100);
+  FillUniform(rng, out.subspan(333), 333, -100, 100);
+  EXPECT_EQ(joined, whole);
+  EXPECT_TRUE(std::ranges::any_of(whole, [&whole](int value) { return value != whole.front(); }));
+}
+
+}  // namespace ppc::util
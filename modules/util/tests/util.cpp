@@ -2,9 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "omp.h"
 
@@ -109,6 +112,16 @@ TEST(GetPerfMaxTime, ReadsFromEnvironment) {
   EXPECT_DOUBLE_EQ(ppc::util::GetPerfMaxTime(), 12.5);
 }
 
+TEST(GetPerfWarmup, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_WARMUP", "3");
+  EXPECT_EQ(ppc::util::GetPerfWarmup(), 3U);
+}
+
+TEST(GetPerfMaxCv, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_MAX_CV", "0.05");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfMaxCv(), 0.05);
+}
+
 TEST(GetNumProc, ReturnsDefaultWhenUnset) {
   const auto old = env::get<int>("PPC_NUM_PROC");
   if (old.has_value()) {
@@ -124,3 +137,49 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(GetPerfOutputPath, ReturnsEmptyWhenUnset) {
+  const auto old = env::get<std::string>("PPC_PERF_OUTPUT");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_OUTPUT");
+  }
+  EXPECT_TRUE(ppc::util::GetPerfOutputPath().empty());
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_OUTPUT", *old);
+  }
+}
+
+TEST(GetPerfOutputPath, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_OUTPUT", "/tmp/perf.jsonl");
+  EXPECT_EQ(ppc::util::GetPerfOutputPath(), "/tmp/perf.jsonl");
+}
+
+TEST(GetPerfSizes, ReturnsEmptyWhenUnset) {
+  const auto old = env::get<std::string>("PPC_PERF_SIZES");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_SIZES");
+  }
+  EXPECT_TRUE(ppc::util::GetPerfSizes().empty());
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_SIZES", *old);
+  }
+}
+
+TEST(GetPerfSizes, ParsesCommaSeparatedList) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_SIZES", "1000,250000");
+  EXPECT_EQ(ppc::util::GetPerfSizes(), (std::vector<std::size_t>{1000, 250000}));
+}
+
+TEST(GetPerfSizes, ThrowsOnInvalidList) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_SIZES", "1000,abc");
+  EXPECT_THROW(ppc::util::GetPerfSizes(), std::runtime_error);
+}
+
+TEST(IsNodeSharedInputEnabled, FollowsEnvironment) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_SHARED_INPUT", "1");
+    EXPECT_TRUE(ppc::util::IsNodeSharedInputEnabled());
+  }
+  env::detail::set_scoped_environment_variable scoped("PPC_SHARED_INPUT", "0");
+  EXPECT_FALSE(ppc::util::IsNodeSharedInputEnabled());
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Convert whitespace-separated text data files into binary datasets.
+
+The output is read by ppc::util::MappedDataset (modules/util/include/dataset.hpp):
+a 64-byte little-endian header followed by the row-major payload.  Example:
+
+    scripts/convert_dataset.py --dtype float64 tasks/<task>/data/<file>.txt
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+from array import array
+from pathlib import Path
+
+MAGIC = b"PPCDATA\0"
+VERSION = 1
+MAX_DIMS = 4
+# name -> (DataType value in dataset.hpp, array typecode, parser)
+DTYPES = {
+    "int8": (1, "b", int),
+    "uint8": (2, "B", int),
+    "int32": (3, "i", int),
+    "uint32": (4, "I", int),
+    "int64": (5, "q", int),
+    "uint64": (6, "Q", int),
+    "float32": (7, "f", float),
+    "float64": (8, "d", float),
+}
+
+
+def init_cmd_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", type=Path, help="Text files to convert")
+    parser.add_argument("--dtype", choices=DTYPES.keys(), required=True, help="Element type of the dataset")
+    parser.add_argument(
+        "--shape",
+        nargs="+",
+        type=int,
+        default=None,
+        help="Dimensions, outermost first (default: one dimension with all values)",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        type=Path,
+        default=None,
+        help="Output file (single input only; default: the input path with a .bin suffix)",
+    )
+    return parser.parse_args()
+
+
+def read_values(path, dtype):
+    _, typecode, parse = DTYPES[dtype]
+    values = array(typecode)
+    with open(path, encoding="utf-8") as file:
+        for line in file:
+            values.extend(parse(token) for token in line.split())
+    if sys.byteorder != "little":
+        values.byteswap()
+    return values
+
+
+def write_dataset(path, dtype, values, shape):
+    if not 1 <= len(shape) <= MAX_DIMS:
+        raise ValueError(f"a dataset has 1 to {MAX_DIMS} dimensions")
+    elements = 1
+    for dim in shape:
+        elements *= dim
+    if elements != len(values):
+        raise ValueError(f"shape {shape} does not match {len(values)} values")
+    payload = values.tobytes()
+    header = struct.pack(
+        "<8sIBBH4QIIQ",
+        MAGIC,
+        VERSION,
+        DTYPES[dtype][0],
+        len(shape),
+        0,
+        *(list(shape) + [0] * (MAX_DIMS - len(shape))),
+        zlib.crc32(payload),
+        0,
+        len(payload),
+    )
+    with open(path, "wb") as file:
+        file.write(header)
+        file.write(payload)
+
+
+def main():
+    args = init_cmd_args()
+    if args.output is not None and len(args.inputs) != 1:
+        sys.exit("--output needs exactly one input file")
+    for source in args.inputs:
+        values = read_values(source, args.dtype)
+        shape = args.shape if args.shape is not None else [len(values)]
+        target = args.output if args.output is not None else source.with_suffix(".bin")
+        write_dataset(target, args.dtype, values, shape)
+        print(f"{source} -> {target}: {args.dtype} {shape}")
+
+
+if __name__ == "__main__":
+    main()
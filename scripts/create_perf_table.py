@@ -1,6 +1,7 @@
 import argparse
 import os
 import re
+import json
 import xlsxwriter
 import csv
 
@@ -19,10 +20,12 @@ NEW_PATTERN = re.compile(
 # Example formats:
 #   example_threads_omp_enabled:task_run:0.4749
 #   example_processes_2_mpi_enabled:pipeline:0.0507
-# Accept optional suffix after `_enabled` (e.g., `_enabled_size1000000`) before the colon
+# Accept optional suffix after `_enabled` (e.g., `_enabled_size1000000`) before the colon; it tells apart the
+# sizes and input variants of one task, so it is kept in the row name
 SIMPLE_PATTERN = re.compile(
-    r"(.+?)_(omp|seq|tbb|stl|all|mpi)_enabled[^:]*:(task_run|pipeline):(-*\d*\.\d*)"
+    r"(.+?)_(omp|seq|tbb|stl|all|mpi)_enabled([^:]*):(task_run|pipeline):(-*\d*\.\d*)"
 )
+CASE_SUFFIX_PATTERN = re.compile(r"_enabled(.*)$")
 
 
 def _ensure_task_tables(result_tables: dict, perf_type: str, task_name: str) -> None:
@@ -42,6 +45,35 @@ def _columns_for_category(category: str) -> list[str]:
     )
 
 
+def _case_suffix(test_name: str) -> str:
+    """Part of a perf case name after `_enabled` (`_<variant>`, `_size<N>`), empty for unsized cases."""
+    match = CASE_SUFFIX_PATTERN.search(test_name)
+    return match.group(1) if match else ""
+
+
+def _read_json_records(path: str):
+    """Yield (task_name, task_type, perf_type, time) from a PPC_PERF_OUTPUT JSON lines file.
+
+    Like scripts/perf_gate.py, a case is identified by its test name as well: the sizes and variants of one task
+    become separate rows (`<namespace>_size<N>`).
+    """
+    with open(path, "r") as records_file:
+        for line in records_file:
+            line = line.strip()
+            if not line:
+                continue
+            record = json.loads(line)
+            suffix = _case_suffix(record.get("test_name", ""))
+            if not suffix and record.get("problem_size"):
+                suffix = f"_size{record['problem_size']}"
+            yield (
+                record["task_namespace"] + suffix,
+                record["technology"],
+                record["mode"],
+                float(record["time_sec"]),
+            )
+
+
 def _write_excel_sheet(
     workbook,
     worksheet,
@@ -130,7 +162,10 @@ def _write_csv(path: str, header: list[str], tasks_list: list[str], table: dict)
 
 parser = argparse.ArgumentParser()
 parser.add_argument(
-    "-i", "--input", help="Input file path (logs of perf tests, .txt)", required=True
+    "-i",
+    "--input",
+    help="Input file path (logs of perf tests, .txt, or PPC_PERF_OUTPUT records, .jsonl)",
+    required=True,
 )
 parser.add_argument(
     "-o", "--output", help="Output file path (path to .xlsx table)", required=True
@@ -146,8 +181,17 @@ task_categories = {}
 # Track tasks per category to split output
 tasks_by_category = {"threads": set(), "processes": set()}
 
-with open(logs_path, "r") as logs_file:
-    logs_lines = logs_file.readlines()
+if os.path.splitext(logs_path)[1] == ".jsonl":
+    logs_lines = []
+    for task_name, task_type, perf_type, perf_time in _read_json_records(logs_path):
+        _ensure_task_tables(result_tables, perf_type, task_name)
+        result_tables[perf_type][task_name][task_type] = perf_time
+        task_category = _infer_category(task_name)
+        task_categories[task_name] = task_category
+        tasks_by_category[task_category].add(task_name)
+else:
+    with open(logs_path, "r") as logs_file:
+        logs_lines = logs_file.readlines()
 for line in logs_lines:
     # Handle both old format: tasks/task_type/task_name:perf_type:time
     # and new format: namespace_task_type_enabled:perf_type:time
@@ -177,10 +221,10 @@ for line in logs_lines:
         tasks_by_category[task_category].add(task_name)
     elif len(simple_result):
         # Extract task name in the current format (prefix already includes category suffix)
-        task_name = simple_result[0][0]
+        task_name = simple_result[0][0] + simple_result[0][2]
         # Infer category by substring
         task_category = "threads" if "threads" in task_name else "processes"
-        perf_type = simple_result[0][2]
+        perf_type = simple_result[0][3]
 
         # no set tracking needed; category mapping below
 
@@ -227,12 +271,12 @@ for line in logs_lines:
         tasks_by_category[task_category].add(task_name)
     elif len(simple_result):
         # Extract details from the simplified pattern (current logs)
-        task_name = simple_result[0][0]
+        task_name = simple_result[0][0] + simple_result[0][2]
         # Infer category by substring present in task_name
         task_category = "threads" if "threads" in task_name else "processes"
         task_type = simple_result[0][1]
-        perf_type = simple_result[0][2]
-        perf_time = float(simple_result[0][3])
+        perf_type = simple_result[0][3]
+        perf_time = float(simple_result[0][4])
 
         if perf_type not in result_tables:
             result_tables[perf_type] = {}
@@ -2,5 +2,17 @@
 set -euo pipefail
 
 mkdir -p build/perf_stat_dir
+export PPC_PERF_OUTPUT="$(pwd)/build/perf_stat_dir/perf_results.jsonl"
+rm -f "${PPC_PERF_OUTPUT}"
 scripts/run_tests.py --running-type="performance" | tee build/perf_stat_dir/perf_log.txt
-python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
+python3 scripts/create_perf_table.py --input "${PPC_PERF_OUTPUT}" --output build/perf_stat_dir
+
+# Regression gate: compare against stored baselines, or refresh them with PPC_PERF_RECORD_BASELINE=1
+if [[ -n "${PPC_PERF_BASELINE_DIR:-}" ]]; then
+  if [[ "${PPC_PERF_RECORD_BASELINE:-0}" == "1" ]]; then
+    python3 scripts/perf_gate.py record --results "${PPC_PERF_OUTPUT}" --baseline-dir "${PPC_PERF_BASELINE_DIR}"
+  else
+    python3 scripts/perf_gate.py compare --results "${PPC_PERF_OUTPUT}" --baseline-dir "${PPC_PERF_BASELINE_DIR}" \
+      --threshold "${PPC_PERF_THRESHOLD:-0.10}" --report build/perf_stat_dir/perf_gate.csv
+  fi
+fi
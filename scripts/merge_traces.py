@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Merge per-rank timeline traces (PPC_TRACE) into one Chrome trace per test.
+
+Every rank writes "<test>.rank<N>.json" with its clock offset to rank 0; this script
+shifts the timestamps by those offsets, so all ranks share the clock of rank 0, and
+writes "<test>.merged.json" for chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import sys
+from collections import defaultdict
+from pathlib import Path
+
+
+def init_cmd_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", type=Path, help="Per-rank trace files or directories containing them")
+    parser.add_argument(
+        "-o",
+        "--output-dir",
+        type=Path,
+        default=None,
+        help="Directory for merged traces (default: next to the per-rank files)",
+    )
+    return parser.parse_args()
+
+
+def collect_rank_files(inputs):
+    files = []
+    for path in inputs:
+        files.extend(sorted(path.glob("*.rank*.json")) if path.is_dir() else [path])
+    return files
+
+
+def load_rank_traces(files):
+    """Returns {label: [(rank, offset_us, events, path), ...]}."""
+    groups = defaultdict(list)
+    for path in files:
+        with open(path, encoding="utf-8") as file:
+            trace = json.load(file)
+        info = trace.get("otherData", {})
+        if "rank" not in info:
+            print(f"skipping {path}: not a per-rank trace", file=sys.stderr)
+            continue
+        groups[info["label"]].append((info["rank"], info.get("clock_offset_us", 0.0), trace["traceEvents"], path))
+    return groups
+
+
+def merge(ranks):
+    events = []
+    for _, offset, rank_events, _ in sorted(ranks, key=lambda entry: entry[0]):
+        for event in rank_events:
+            if "ts" in event:
+                event = dict(event, ts=event["ts"] + offset)
+            events.append(event)
+    # Start the timeline at zero; viewers show absolute steady-clock values poorly
+    start = min((event["ts"] for event in events if "ts" in event), default=0.0)
+    for event in events:
+        if "ts" in event:
+            event["ts"] -= start
+    return events
+
+
+def main():
+    args = init_cmd_args()
+    groups = load_rank_traces(collect_rank_files(args.inputs))
+    if not groups:
+        sys.exit("no per-rank traces found")
+    for label, ranks in sorted(groups.items()):
+        first_path = ranks[0][3]
+        output_dir = args.output_dir if args.output_dir is not None else first_path.parent
+        output_dir.mkdir(parents=True, exist_ok=True)
+        target = output_dir / (first_path.name.rsplit(".rank", 1)[0] + ".merged.json")
+        merged = {
+            "traceEvents": merge(ranks),
+            "displayTimeUnit": "ms",
+            "otherData": {"label": label, "ranks": len(ranks)},
+        }
+        with open(target, "w", encoding="utf-8") as file:
+            json.dump(merged, file)
+        print(f"{label}: {len(ranks)} ranks -> {target}")
+
+
+if __name__ == "__main__":
+    main()
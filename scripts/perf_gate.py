@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""Store perf baselines and fail on statistically significant slowdowns.
+
+Works on the JSON lines written through PPC_PERF_OUTPUT and needs only the Python
+standard library, so it runs offline on a single machine.
+
+    # Save the current results as the baselines (one file per task/technology/mode/size)
+    scripts/perf_gate.py record --results build/perf_stat_dir/perf_results.jsonl
+
+    # Compare new results against them; exits with 1 on a regression
+    scripts/perf_gate.py compare --results build/perf_stat_dir/perf_results.jsonl --threshold 0.10
+
+A case regresses when its median per-iteration time grew by more than the threshold
+and the slowdown is significant: a one-sided Mann-Whitney U test on the
+per-iteration samples (default) or a bootstrap confidence interval of the median
+ratio that lies entirely above 1 + threshold.
+"""
+
+import argparse
+import json
+import math
+import random
+import statistics
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+BASELINE_SCHEMA_VERSION = 1
+DEFAULT_BASELINE_DIR = "perf_baselines"
+BOOTSTRAP_SEED = 12345
+
+
+def init_cmd_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    record = subparsers.add_parser("record", help="Write baselines from perf results")
+    compare = subparsers.add_parser("compare", help="Compare perf results against baselines")
+    for subparser in (record, compare):
+        subparser.add_argument("--results", required=True, type=Path, help="PPC_PERF_OUTPUT file (JSON lines)")
+        subparser.add_argument(
+            "--baseline-dir",
+            type=Path,
+            default=Path(DEFAULT_BASELINE_DIR),
+            help=f"Baseline store (default: {DEFAULT_BASELINE_DIR})",
+        )
+    compare.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="Relative slowdown of the median that counts as a regression (default: 0.10 = 10%%)",
+    )
+    compare.add_argument(
+        "--alpha", type=float, default=0.01, help="Significance level of the test (default: 0.01)"
+    )
+    compare.add_argument(
+        "--method",
+        choices=["mannwhitney", "bootstrap"],
+        default="mannwhitney",
+        help="Significance test on the per-iteration samples",
+    )
+    compare.add_argument(
+        "--bootstrap-rounds", type=int, default=2000, help="Resamples for --method bootstrap (default: 2000)"
+    )
+    compare.add_argument(
+        "--report", type=Path, default=None, help="Also write the comparison as CSV to this file"
+    )
+    return parser.parse_args()
+
+
+# -------------------------------
+# Results and baseline store
+# -------------------------------
+
+
+def case_key(record):
+    """Identity of a perf case: results of the same key are comparable.
+
+    The test name tells apart the cases of a task that differ in size or input family.
+    """
+    return (
+        record["task_namespace"],
+        record["test_name"],
+        record["technology"],
+        record["mode"],
+        int(record.get("problem_size") or 0),
+        int(record["num_proc"]),
+        int(record["num_threads"]),
+    )
+
+
+def baseline_path(baseline_dir, key):
+    task, test_name, technology, mode, _, num_proc, num_threads = key
+    return baseline_dir / task / technology / f"{test_name}_{mode}_np{num_proc}_nt{num_threads}.json"
+
+
+def load_results(path):
+    """Per-iteration samples of every case; repeated runs of a case are pooled."""
+    cases = {}
+    with open(path, encoding="utf-8") as file:
+        for line in file:
+            line = line.strip()
+            if not line:
+                continue
+            record = json.loads(line)
+            samples = record.get("samples") or [record["time_sec"]]
+            entry = cases.setdefault(case_key(record), {"samples": [], "host": record.get("host", {})})
+            entry["samples"].extend(float(sample) for sample in samples)
+    return cases
+
+
+def git_revision():
+    try:
+        return subprocess.run(
+            ["git", "rev-parse", "--short", "HEAD"], capture_output=True, text=True, check=True
+        ).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ""
+
+
+def write_baselines(cases, baseline_dir):
+    revision = git_revision()
+    for key, entry in sorted(cases.items()):
+        task, test_name, technology, mode, size, num_proc, num_threads = key
+        path = baseline_path(baseline_dir, key)
+        path.parent.mkdir(parents=True, exist_ok=True)
+        baseline = {
+            "schema_version": BASELINE_SCHEMA_VERSION,
+            "task_namespace": task,
+            "test_name": test_name,
+            "technology": technology,
+            "mode": mode,
+            "problem_size": size,
+            "num_proc": num_proc,
+            "num_threads": num_threads,
+            "recorded_at": int(time.time()),
+            "revision": revision,
+            "host": entry["host"],
+            "median": statistics.median(entry["samples"]),
+            "samples": entry["samples"],
+        }
+        with open(path, "w", encoding="utf-8") as file:
+            json.dump(baseline, file, indent=2)
+            file.write("\n")
+        print(f"{path}: {len(entry['samples'])} samples")
+
+
+def load_baseline(path):
+    with open(path, encoding="utf-8") as file:
+        baseline = json.load(file)
+    if baseline.get("schema_version") != BASELINE_SCHEMA_VERSION:
+        raise ValueError(f"{path}: unsupported baseline schema version {baseline.get('schema_version')}")
+    return baseline
+
+
+# -------------------------------
+# Statistics
+# -------------------------------
+
+
+def min_attainable_p_value(n1, n2):
+    """Smallest one-sided p-value of a rank test with n1 and n2 samples: every current sample above every baseline one.
+
+    Below 1 / alpha arrangements the test can never be significant, e.g. 3 + 3 samples reach only p=0.05.
+    """
+    return 1.0 / math.comb(n1 + n2, n1)
+
+
+def mann_whitney_greater(current, baseline):
+    """One-sided p-value of H1: current samples tend to be larger (slower) than baseline ones.
+
+    Normal approximation with tie and continuity correction; adequate from a handful of samples per side.
+    """
+    n1, n2 = len(current), len(baseline)
+    pooled = sorted([(value, 0) for value in current] + [(value, 1) for value in baseline])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        ties = j - i + 1
+        tie_term += ties**3 - ties
+        i = j + 1
+    rank_sum = sum(rank for rank, (_, group) in zip(ranks, pooled) if group == 0)
+    u_statistic = rank_sum - n1 * (n1 + 1) / 2.0
+    mean = n1 * n2 / 2.0
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (u_statistic - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def bootstrap_ratio_interval(current, baseline, alpha, rounds):
+    """Percentile confidence interval of median(current) / median(baseline)."""
+    rng = random.Random(BOOTSTRAP_SEED)
+    ratios = []
+    for _ in range(rounds):
+        current_median = statistics.median(rng.choices(current, k=len(current)))
+        baseline_median = statistics.median(rng.choices(baseline, k=len(baseline)))
+        ratios.append(current_median / baseline_median if baseline_median > 0.0 else math.inf)
+    ratios.sort()
+    low = ratios[int(math.floor(alpha / 2.0 * (rounds - 1)))]
+    high = ratios[int(math.ceil((1.0 - alpha / 2.0) * (rounds - 1)))]
+    return low, high
+
+
+# -------------------------------
+# Comparison
+# -------------------------------
+
+
+def compare_case(current, baseline, args):
+    """Returns (ratio, evidence, status) for one case."""
+    if not current or not baseline:
+        return None, "", "too few samples"
+    baseline_median = statistics.median(baseline)
+    if baseline_median <= 0.0:
+        return None, "", "zero baseline"
+    ratio = statistics.median(current) / baseline_median
+    # A slowdown of so few samples could never be significant, so "ok" would claim more than the data shows
+    min_p_value = min_attainable_p_value(len(current), len(baseline))
+    if min_p_value >= args.alpha:
+        return ratio, f"min p={min_p_value:.2g}", "too few samples"
+    limit = 1.0 + args.threshold
+    if args.method == "mannwhitney":
+        p_value = mann_whitney_greater(current, baseline)
+        evidence = f"p={p_value:.2g}"
+        regressed = ratio > limit and p_value < args.alpha
+    else:
+        low, high = bootstrap_ratio_interval(current, baseline, args.alpha, args.bootstrap_rounds)
+        evidence = f"ci=[{low:.3f}, {high:.3f}]"
+        regressed = low > limit
+    if regressed:
+        return ratio, evidence, "REGRESSION"
+    return ratio, evidence, "faster" if ratio < 1.0 / limit else "ok"
+
+
+def format_case(key):
+    _, test_name, _, mode, _, num_proc, num_threads = key
+    return f"{test_name} {mode} np={num_proc} nt={num_threads}"
+
+
+def compare(args):
+    cases = load_results(args.results)
+    rows = []
+    for key, entry in sorted(cases.items()):
+        path = baseline_path(args.baseline_dir, key)
+        if not path.exists():
+            rows.append((key, None, "", "no baseline"))
+            continue
+        baseline = load_baseline(path)
+        rows.append((key, *compare_case(entry["samples"], baseline["samples"], args)))
+
+    regressions = 0
+    for key, ratio, evidence, status in rows:
+        ratio_text = f"{ratio:.3f}x" if ratio is not None else "-"
+        print(f"[ {status:^15} ] {format_case(key)}: {ratio_text} {evidence}".rstrip())
+        regressions += status == "REGRESSION"
+    if args.report is not None:
+        with open(args.report, "w", encoding="utf-8") as file:
+            file.write("task,test_name,technology,mode,problem_size,num_proc,num_threads,ratio,evidence,status\n")
+            for key, ratio, evidence, status in rows:
+                ratio_text = f"{ratio:.6f}" if ratio is not None else ""
+                file.write(",".join(map(str, key)) + f",{ratio_text},\"{evidence}\",{status}\n")
+    print(f"{regressions} regression(s) in {len(rows)} case(s), threshold {args.threshold:.0%}, method {args.method}")
+    return 1 if regressions else 0
+
+
+def main():
+    args = init_cmd_args()
+    if args.command == "record":
+        write_baselines(load_results(args.results), args.baseline_dir)
+        return 0
+    return compare(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
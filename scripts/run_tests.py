@@ -131,6 +131,23 @@ class PPCRunner:
             return "mpich", "-n"
         return "unknown", "-np"
 
+    # Optional variables forwarded to every rank when they are set
+    OPTIONAL_ENV_VARS = [
+        "PPC_PERF_OUTPUT",
+        "PPC_PERF_MAX_TIME",
+        "PPC_PERF_SIZES",
+        "PPC_PERF_WARMUP",
+        "PPC_PERF_MAX_CV",
+        "PPC_SHARED_INPUT",
+        "PPC_TRACE",
+        "PPC_BIND",
+        "PPC_NUMA",
+        "PPC_GEMM_KERNEL",
+    ]
+
+    def __optional_env_vars(self):
+        return [var for var in self.OPTIONAL_ENV_VARS if var in self.__ppc_env]
+
     def __build_mpi_cmd(self, ppc_num_proc, additional_mpi_args):
         base = [self.mpi_exec] + shlex.split(additional_mpi_args)
 
@@ -144,6 +161,8 @@ class PPCRunner:
                 "OMP_NUM_THREADS",
                 self.__ppc_env["OMP_NUM_THREADS"],
             ]
+            for var in self.__optional_env_vars():
+                env_args += ["-env", var, self.__ppc_env[var]]
             np_args = ["-n", ppc_num_proc]
             return base + env_args + np_args
 
@@ -155,6 +174,8 @@ class PPCRunner:
                 "-x",
                 "OMP_NUM_THREADS",
             ]
+            for var in self.__optional_env_vars():
+                env_args += ["-x", var]
             np_flag = "-np"
         elif self.mpi_env_mode == "mpich":
             # Explicitly set env variables for all ranks
@@ -166,6 +187,8 @@ class PPCRunner:
                 "OMP_NUM_THREADS",
                 self.__ppc_env["OMP_NUM_THREADS"],
             ]
+            for var in self.__optional_env_vars():
+                env_args += ["-env", var, self.__ppc_env[var]]
             np_flag = "-n"
         else:
             # Unknown MPI flavor: rely on environment inheritance and default to -np
@@ -221,6 +244,12 @@ class PPCRunner:
             )
         mpi_running = self.__build_mpi_cmd(ppc_num_proc, additional_mpi_args)
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
+            # Tests of the core modules that run MPI collectives
+            self.__run_exec(
+                mpi_running
+                + [str(self.work_dir / "core_func_tests")]
+                + self.__get_gtest_settings(1, "MpiTest")
+            )
             for task_type in ["all", "mpi"]:
                 self.__run_exec(
                     mpi_running
@@ -245,6 +274,19 @@ class PPCRunner:
                 + self.__get_gtest_settings(1, "_" + task_type + "_")
             )
 
+    def run_perf_tests(self, gtest_filter, use_mpi, additional_mpi_args=""):
+        """Run the perf binary once for the given gtest filter, under mpirun if use_mpi is set."""
+        command = [
+            str(self.work_dir / "ppc_perf_tests"),
+            "--gtest_color=0",
+            f"--gtest_filter={gtest_filter}",
+        ]
+        if use_mpi:
+            command = (
+                self.__build_mpi_cmd(self.__ppc_num_proc, additional_mpi_args) + command
+            )
+        self.__run_exec(command)
+
 
 def _execute(args_dict, env):
     runner = PPCRunner(verbose=args_dict.get("verbose", False))
@@ -0,0 +1,410 @@
+#!/usr/bin/env python3
+"""Run perf tests over process x thread x size grids and report strong/weak scaling.
+
+Every sweep point is one run of ppc_perf_tests with PPC_NUM_PROC/PPC_NUM_THREADS set;
+results are collected through PPC_PERF_OUTPUT (JSON lines) and turned into speedup,
+efficiency and Karp-Flatt serial fraction tables (CSV) and plots (PNG, needs matplotlib).
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import statistics
+import sys
+from pathlib import Path
+
+from run_tests import PPCRunner
+
+THREAD_TECHNOLOGIES = ["seq", "omp", "tbb", "stl"]
+PROCESS_TECHNOLOGIES = ["mpi", "all"]
+
+# Perf case names end in "_enabled", then "_<variant>" for tasks with several inputs and "_size<N>" for sized cases
+CASE_SUFFIX = re.compile(
+    r"_enabled(?:_(?P<variant>(?!size\d).*?))?(?:_size(?P<size>\d+))?$"
+)
+
+
+def init_cmd_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--procs",
+        nargs="+",
+        type=int,
+        default=[1, 2, 4],
+        help="MPI process counts for mpi/all implementations",
+    )
+    parser.add_argument(
+        "--threads",
+        nargs="+",
+        type=int,
+        default=[1, 2, 4],
+        help="Thread counts for omp/tbb/stl/all implementations",
+    )
+    parser.add_argument(
+        "--sizes",
+        nargs="+",
+        type=int,
+        default=[],
+        help="Problem sizes for size-parameterized perf tests (default: every case at its declared size)",
+    )
+    parser.add_argument(
+        "--weak",
+        action="store_true",
+        help="Weak scaling: each size is a per-worker size multiplied by the number of workers",
+    )
+    parser.add_argument(
+        "--tasks",
+        nargs="+",
+        default=["*"],
+        help="Task namespaces (gtest wildcards allowed) to include",
+    )
+    parser.add_argument(
+        "--technologies",
+        nargs="+",
+        default=THREAD_TECHNOLOGIES + PROCESS_TECHNOLOGIES,
+        choices=THREAD_TECHNOLOGIES + PROCESS_TECHNOLOGIES,
+        help="Implementations to sweep; seq is the baseline for the others",
+    )
+    parser.add_argument(
+        "--mode",
+        choices=["pipeline", "task_run"],
+        default="task_run",
+        help="Perf mode used for the tables",
+    )
+    parser.add_argument(
+        "--output",
+        default="build/scaling",
+        help="Directory for the collected records, tables and plots",
+    )
+    parser.add_argument(
+        "--report-only",
+        action="store_true",
+        help="Skip running and rebuild the report from the records in --output",
+    )
+    parser.add_argument(
+        "--max-time",
+        type=float,
+        default=None,
+        help="Value for PPC_PERF_MAX_TIME (large single-worker runs may need more than the default)",
+    )
+    parser.add_argument(
+        "--additional-mpi-args",
+        default="",
+        help="Additional MPI arguments to pass to the mpirun command (optional).",
+    )
+    parser.add_argument(
+        "--verbose", action="store_true", help="Print commands executed by the script"
+    )
+    args = parser.parse_args()
+    if args.weak and not args.sizes and not args.report_only:
+        parser.error("--weak requires --sizes (per-worker problem sizes)")
+    return args
+
+
+def workers_of(technology, num_proc, num_threads):
+    """Number of execution units an implementation uses at the given sweep point."""
+    if technology == "seq":
+        return 1
+    if technology == "mpi":
+        return num_proc
+    if technology == "all":
+        return num_proc * num_threads
+    return num_threads
+
+
+def sweep_points(args):
+    """Yield (technology, num_proc, num_threads) for every run of the sweep."""
+    for technology in args.technologies:
+        if technology == "seq":
+            yield technology, 1, 1
+        elif technology == "mpi":
+            for num_proc in args.procs:
+                yield technology, num_proc, 1
+        elif technology == "all":
+            for num_proc in args.procs:
+                for num_threads in args.threads:
+                    yield technology, num_proc, num_threads
+        else:
+            for num_threads in args.threads:
+                yield technology, 1, num_threads
+
+
+def parse_case(test_name):
+    """Return the variant ("" if none) and the problem size (None if unsized) of a perf case name."""
+    match = CASE_SUFFIX.search(test_name)
+    if match is None:
+        return "", None
+    size = match.group("size")
+    return match.group("variant") or "", int(size) if size else None
+
+
+def gtest_filter(tasks, technology, size, mode):
+    # Every variant of a task is swept; the size, if given, is the last part of the name
+    size_tag = f"_size{size}" if size is not None else ""
+    return ":".join(
+        f"*/{mode}_{task}_{technology}_enabled*{size_tag}" for task in tasks
+    )
+
+
+def run_sweep(args, records_path):
+    records_path.unlink(missing_ok=True)
+    failures = []
+    runner = PPCRunner(verbose=args.verbose)
+    for technology, num_proc, num_threads in sweep_points(args):
+        workers = workers_of(technology, num_proc, num_threads)
+        sizes = args.sizes or [None]
+        for size in sizes:
+            if size is not None and args.weak:
+                size *= workers
+            env = os.environ.copy()
+            env["PPC_NUM_PROC"] = str(num_proc)
+            env["PPC_NUM_THREADS"] = str(num_threads)
+            env["PPC_PERF_OUTPUT"] = str(records_path)
+            if size is not None:
+                # Size-parameterized perf tests generate exactly this case
+                env["PPC_PERF_SIZES"] = str(size)
+            if args.max_time is not None:
+                env["PPC_PERF_MAX_TIME"] = str(args.max_time)
+            print(
+                f"Sweep point: {technology} procs={num_proc} threads={num_threads}"
+                + (f" size={size}" if size is not None else ""),
+                flush=True,
+            )
+            runner.setup_env(env)
+            try:
+                runner.run_perf_tests(
+                    gtest_filter(args.tasks, technology, size, args.mode),
+                    technology in PROCESS_TECHNOLOGIES,
+                    args.additional_mpi_args,
+                )
+            except Exception as error:
+                failures.append(f"{technology} P={num_proc} T={num_threads}: {error}")
+    return failures
+
+
+def load_points(records_path, mode):
+    """Group the measured times by (task, technology, size, workers); repeats are reduced to the median.
+
+    Variants of a task ("road", "rmat", ...) are reported as separate tasks named <namespace>_<variant>.
+    """
+    times = {}
+    with open(records_path, "r") as records_file:
+        for line in records_file:
+            line = line.strip()
+            if not line:
+                continue
+            record = json.loads(line)
+            if record["mode"] != mode or record["time_sec"] <= 0.0:
+                continue
+            variant, name_size = parse_case(record["test_name"])
+            size = record.get("problem_size") or name_size or record["input_size"]
+            task = record["task_namespace"] + (f"_{variant}" if variant else "")
+            technology = record["technology"]
+            workers = workers_of(technology, record["num_proc"], record["num_threads"])
+            key = (
+                task,
+                technology,
+                size,
+                workers,
+                record["num_proc"],
+                record["num_threads"],
+            )
+            times.setdefault(key, []).append(float(record["time_sec"]))
+    return {key: statistics.median(values) for key, values in times.items()}
+
+
+def karp_flatt(speedup, workers):
+    """Experimentally determined serial fraction; undefined for a single worker."""
+    if workers <= 1 or speedup <= 0.0:
+        return None
+    return (1.0 / speedup - 1.0 / workers) / (1.0 - 1.0 / workers)
+
+
+def build_rows(points, weak):
+    """Compute speedup/efficiency/Karp-Flatt for every point against a single-worker baseline.
+
+    The baseline is the same implementation on one worker, falling back to seq. In weak
+    scaling the baseline runs the per-worker size and the speedup is the scaled speedup
+    workers * T(1) / T(p).
+    """
+    baselines = {}
+    for (task, technology, size, workers, _, _), time in points.items():
+        if workers == 1:
+            baselines[(task, technology, size)] = time
+    # Absolute speedup against seq makes implementations with a slow single-worker path visible
+    seq_times = {
+        (task, size): time
+        for (task, technology, size, _, _, _), time in points.items()
+        if technology == "seq"
+    }
+    rows = []
+    for (task, technology, size, workers, num_proc, num_threads), time in sorted(
+        points.items()
+    ):
+        base_size = size // workers if weak and size % workers == 0 else size
+        base_time = baselines.get((task, technology, base_size))
+        if base_time is None:
+            base_time = baselines.get((task, "seq", base_size))
+        row = {
+            "task": task,
+            "technology": technology,
+            "size": size,
+            "procs": num_proc,
+            "threads": num_threads,
+            "workers": workers,
+            "time_sec": time,
+            "speedup": None,
+            "seq_speedup": None,
+            "efficiency": None,
+            "karp_flatt": None,
+        }
+        if base_time is not None:
+            if weak:
+                row["efficiency"] = base_time / time
+                row["speedup"] = workers * row["efficiency"]
+            else:
+                row["speedup"] = base_time / time
+                row["efficiency"] = row["speedup"] / workers
+            row["karp_flatt"] = karp_flatt(row["speedup"], workers)
+        if not weak and (task, size) in seq_times:
+            row["seq_speedup"] = seq_times[(task, size)] / time
+        rows.append(row)
+    return rows
+
+
+def write_table(rows, path):
+    columns = [
+        "task",
+        "technology",
+        "size",
+        "procs",
+        "threads",
+        "workers",
+        "time_sec",
+        "speedup",
+        "seq_speedup",
+        "efficiency",
+        "karp_flatt",
+    ]
+    with open(path, "w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(columns)
+        for row in rows:
+            writer.writerow(
+                ["—" if row[column] is None else row[column] for column in columns]
+            )
+
+
+def print_table(rows):
+    def fmt(value, spec):
+        return f"{'—':>7}" if value is None else format(value, spec)
+
+    header = (
+        f"{'task':<40} {'tech':<5} {'size':>12} {'P':>3} {'T':>3} {'time,s':>12} "
+        f"{'S':>7} {'S_seq':>7} {'E':>7} {'e_KF':>7}"
+    )
+    print(header)
+    print("-" * len(header))
+    for row in rows:
+        print(
+            f"{row['task'][:40]:<40} {row['technology']:<5} {row['size']:>12} {row['procs']:>3} "
+            f"{row['threads']:>3} {row['time_sec']:>12.6f} {fmt(row['speedup'], '7.3f')} "
+            f"{fmt(row['seq_speedup'], '7.3f')} "
+            f"{fmt(row['efficiency'], '7.3f')} {fmt(row['karp_flatt'], '7.3f')}"
+        )
+
+
+def plot_rows(rows, output_dir, weak):
+    try:
+        import matplotlib
+
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("matplotlib is not installed, skipping plots: pip install matplotlib")
+        return
+
+    kind = "weak" if weak else "strong"
+    for task in sorted({row["task"] for row in rows}):
+        task_rows = [
+            row for row in rows if row["task"] == task and row["speedup"] is not None
+        ]
+        if not task_rows:
+            continue
+        fig, (ax_speedup, ax_efficiency, ax_serial) = plt.subplots(
+            1, 3, figsize=(16, 5)
+        )
+        max_workers = 1
+        series = {}
+        for row in task_rows:
+            label = row["technology"]
+            if weak:
+                label += f" size/worker={row['size'] // row['workers']}"
+            elif row["size"]:
+                label += f" size={row['size']}"
+            if row["technology"] == "all":
+                label += f" T={row['threads']}"
+            series.setdefault(label, []).append(row)
+            max_workers = max(max_workers, row["workers"])
+        for label, points in sorted(series.items()):
+            points.sort(key=lambda row: row["workers"])
+            workers = [row["workers"] for row in points]
+            ax_speedup.plot(
+                workers, [row["speedup"] for row in points], "o-", label=label
+            )
+            ax_efficiency.plot(
+                workers, [row["efficiency"] for row in points], "o-", label=label
+            )
+            serial = [row for row in points if row["karp_flatt"] is not None]
+            if serial:
+                ax_serial.plot(
+                    [row["workers"] for row in serial],
+                    [row["karp_flatt"] for row in serial],
+                    "o-",
+                    label=label,
+                )
+        ax_speedup.plot([1, max_workers], [1, max_workers], "k--", label="ideal")
+        ax_speedup.set_xlabel("workers")
+        ax_speedup.set_ylabel("scaled speedup" if weak else "speedup")
+        ax_efficiency.axhline(1.0, color="k", linestyle="--")
+        ax_efficiency.set_xlabel("workers")
+        ax_efficiency.set_ylabel("efficiency")
+        ax_serial.set_xlabel("workers")
+        ax_serial.set_ylabel("Karp-Flatt serial fraction")
+        ax_speedup.legend(fontsize="small")
+        fig.suptitle(f"{task} ({kind} scaling)")
+        fig.tight_layout()
+        fig.savefig(output_dir / f"{task}_{kind}_scaling.png")
+        plt.close(fig)
+
+
+def main():
+    args = init_cmd_args()
+    output_dir = Path(args.output).resolve()
+    output_dir.mkdir(parents=True, exist_ok=True)
+    records_path = output_dir / "scaling_records.jsonl"
+
+    failures = []
+    if not args.report_only:
+        failures = run_sweep(args, records_path)
+    if not records_path.exists():
+        print(f"No records found in {records_path}")
+        return 1
+
+    rows = build_rows(load_points(records_path, args.mode), args.weak)
+    kind = "weak" if args.weak else "strong"
+    table_path = output_dir / f"{kind}_scaling_{args.mode}.csv"
+    write_table(rows, table_path)
+    print_table(rows)
+    plot_rows(rows, output_dir, args.weak)
+    print(f"Scaling table written to {table_path}")
+
+    for failure in failures:
+        print(f"Failed sweep point: {failure}", file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -10,7 +10,7 @@ class AfanasyevAElemVecAvgMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit AfanasyevAElemVecAvgMPI(const InType &in);
+  explicit AfanasyevAElemVecAvgMPI(InType in);
 
  private:
   bool ValidationImpl() override;
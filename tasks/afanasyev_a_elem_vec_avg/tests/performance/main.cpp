@@ -1,21 +1,22 @@
 #include <gtest/gtest.h>
-#include <mpi.h>
 
 #include <cmath>
 #include <cstdint>
 #include <numeric>
-#include <random>
+#include <span>
 
 #include "afanasyev_a_elem_vec_avg/common/include/common.hpp"
 #include "afanasyev_a_elem_vec_avg/mpi/include/ops_mpi.hpp"
 #include "afanasyev_a_elem_vec_avg/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace afanasyev_a_elem_vec_avg {
 
 class AfanasyevAElemVecAvgPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  public:
   static constexpr int kVectorSize = 100000000;
+  static constexpr uint64_t kSeed = 42;
 
  protected:
   void SetUp() override {
@@ -23,30 +24,9 @@ class AfanasyevAElemVecAvgPerfTests : public ppc::util::BaseRunPerfTests<InType,
       input_data_ = {};
       expected_output_ = 0.0;
     } else {
+      // Counter-based generator: the same input on every rank without a broadcast seed, filled by all OpenMP threads
       input_data_.resize(kVectorSize);
-
-      unsigned int seed = 42;
-      int is_mpi_init = 0;
-      MPI_Initialized(&is_mpi_init);
-      if (is_mpi_init != 0) {
-        int rank = 0;
-        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-        if (rank == 0) {
-          std::random_device rd;
-          seed = rd();
-        }
-        MPI_Bcast(&seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
-      } else {
-        std::random_device rd;
-        seed = rd();
-      }
-
-      std::mt19937 gen(seed);
-      std::uniform_int_distribution<> distrib(-10, 10);
-
-      for (int i = 0; i < kVectorSize; ++i) {
-        input_data_[i] = distrib(gen);
-      }
+      ppc::util::FillUniform(ppc::util::CounterRng(kSeed), std::span(input_data_), 0, -10, 10);
 
       int64_t sum = std::accumulate(input_data_.begin(), input_data_.end(), static_cast<int64_t>(0));
       expected_output_ = static_cast<double>(sum) / kVectorSize;
@@ -3,15 +3,16 @@
 #include <cstdlib>
 #include <limits>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "alekseev_a_min_dist_neigh_elem_vec/common/include/common.hpp"
 
 namespace alekseev_a_min_dist_neigh_elem_vec {
 
-AlekseevAMinDistNeighElemVecSEQ::AlekseevAMinDistNeighElemVecSEQ(const InType &in) {
+AlekseevAMinDistNeighElemVecSEQ::AlekseevAMinDistNeighElemVecSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
@@ -2,29 +2,28 @@
 
 #include <climits>
 #include <cstddef>
-#include <random>
+#include <cstdint>
+#include <span>
 
 #include "badanov_a_max_vec_elem/common/include/common.hpp"
 #include "badanov_a_max_vec_elem/mpi/include/ops_mpi.hpp"
 #include "badanov_a_max_vec_elem/seq/include/ops_seq.hpp"
+#include "performance/include/roofline.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace badanov_a_max_vec_elem {
 
 class BadanovAMaxVecElemPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
   const size_t kCount_ = 1000000;
+  const uint64_t kSeed_ = 1;
   InType input_data_;
   OutType expected_val_{};
 
   void SetUp() override {
-    std::random_device rand_dev;
-    std::mt19937 gen(rand_dev());
-    std::uniform_int_distribution<int> rand(-1000000, 1000000);
+    // Counter-based generator: reproducible input, filled by all OpenMP threads
     input_data_.resize(kCount_);
-
-    for (size_t i = 0; i < kCount_; i++) {
-      input_data_[i] = rand(gen);
-    }
+    ppc::util::FillUniform(ppc::util::CounterRng(kSeed_), std::span(input_data_), 0, -1000000, 1000000);
 
     size_t middle_index = kCount_ / 2;
     expected_val_ = 2000000;
@@ -41,6 +40,12 @@ class BadanovAMaxVecElemPerfTests : public ppc::util::BaseRunPerfTests<InType, O
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  // One pass over the vector: memory bound, no floating-point work
+  ppc::performance::Workload GetWorkload(const InType &input) final {
+    const auto count = static_cast<double>(input.size());
+    return {.bytes = count * sizeof(int), .elements = count};
+  }
 };
 
 TEST_P(BadanovAMaxVecElemPerfTests, RunPerfModes) {
@@ -2,8 +2,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <exception>
-#include <random>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "baranov_a_custom_allreduce/mpi/include/ops_mpi.hpp"
 #include "baranov_a_custom_allreduce/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace baranov_a_custom_allreduce {
 
@@ -22,15 +24,11 @@ class BaranovACustomAllreducePerfTests : public ppc::util::BaseRunPerfTests<InTy
     is_mpi_test_ = (task_name.find("mpi") != std::string::npos);
 
     int size = 10000000;
+    const uint64_t seed = 1;
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(-1000.0, 1000.0);
-
+    // Counter-based generator: reproducible input, filled by all OpenMP threads
     std::vector<double> data(size);
-    for (int i = 0; i < size; i++) {
-      data[i] = dis(gen);
-    }
+    ppc::util::FillUniform(ppc::util::CounterRng(seed), std::span(data), 0, -1000.0, 1000.0);
 
     input_data_ = InTypeVariant{data};
   }
@@ -1,29 +1,30 @@
 #include <gtest/gtest.h>
 
-#include <cmath>
-#include <random>
+#include <cstdint>
+#include <span>
 
 #include "baranov_a_sign_alternations/common/include/common.hpp"
 #include "baranov_a_sign_alternations/mpi/include/ops_mpi.hpp"
 #include "baranov_a_sign_alternations/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace baranov_a_sign_alternations {
 
 class BaranovASignAlternationsPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
   void SetUp() override {
     int size = 10000000;
+    const uint64_t seed = 1;
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(-100, 100);
-
+    // Counter-based generator (all OpenMP threads), then the same pattern as before: a positive value, a value in
+    // [-1, 99] and a zero
     input_data_.resize(size);
+    ppc::util::FillUniform(ppc::util::CounterRng(seed), std::span(input_data_), 0, 0, 100);
     for (int i = 0; i < size; i++) {
       if (i % 3 == 0) {
-        input_data_[i] = std::abs(dis(gen)) + 1;
+        input_data_[i] += 1;
       } else if (i % 3 == 1) {
-        input_data_[i] = std::abs(dis(gen)) - 1;
+        input_data_[i] -= 1;
       } else {
         input_data_[i] = 0;
       }
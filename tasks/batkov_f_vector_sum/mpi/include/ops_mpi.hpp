@@ -1,7 +1,5 @@
 #pragma once
 
-#include <cstddef>
-
 #include "batkov_f_vector_sum/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -19,9 +17,6 @@ class BatkovFVectorSumMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
-
-  size_t m_rank_{0};
-  size_t m_mpi_size_{0};
 };
 
 }  // namespace batkov_f_vector_sum
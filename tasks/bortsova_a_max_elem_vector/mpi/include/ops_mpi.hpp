@@ -10,7 +10,7 @@ class BortsovaAMaxElemVectorMpi : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BortsovaAMaxElemVectorMpi(const InType &in);
+  explicit BortsovaAMaxElemVectorMpi(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -3,14 +3,15 @@
 #include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <utility>
 
 #include "bortsova_a_max_elem_vector/common/include/common.hpp"
 
 namespace bortsova_a_max_elem_vector {
 
-BortsovaAMaxElemVectorSeq::BortsovaAMaxElemVectorSeq(const InType &in) {
+BortsovaAMaxElemVectorSeq::BortsovaAMaxElemVectorSeq(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::numeric_limits<int>::min();
 }
 
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
 
 #include "borunov_v_cnt_words/common/include/common.hpp"
 #include "task/include/task.hpp"
@@ -20,7 +19,6 @@ class BorunovVCntWordsMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
-  static void CalculateDistribution(int text_len, int world_size, std::vector<int> &counts, std::vector<int> &displs);
   static uint64_t CountWordsLocal(const char *data, int count, char prev_char);
 };
 
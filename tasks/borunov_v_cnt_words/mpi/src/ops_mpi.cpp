@@ -3,11 +3,13 @@
 #include <mpi.h>
 
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
 #include "borunov_v_cnt_words/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace borunov_v_cnt_words {
 
@@ -25,26 +27,6 @@ bool BorunovVCntWordsMPI::PreProcessingImpl() {
   return true;
 }
 
-void BorunovVCntWordsMPI::CalculateDistribution(int text_len, int world_size, std::vector<int> &counts,
-                                                std::vector<int> &displs) {
-  counts.resize(world_size);
-  displs.resize(world_size);
-
-  if (world_size == 0) {
-    return;
-  }
-
-  int base_count = text_len / world_size;
-  int remainder = text_len % world_size;
-  int current_displ = 0;
-
-  for (int i = 0; i < world_size; ++i) {
-    counts[i] = base_count + (i < remainder ? 1 : 0);
-    displs[i] = current_displ;
-    current_displ += counts[i];
-  }
-}
-
 uint64_t BorunovVCntWordsMPI::CountWordsLocal(const char *data, int count, char prev_char) {
   if (count == 0) {
     return 0;
@@ -96,9 +78,9 @@ bool BorunovVCntWordsMPI::RunImpl() {
     return true;
   }
 
-  std::vector<int> send_counts;
-  std::vector<int> displs;
-  CalculateDistribution(text_len, world_size, send_counts, displs);
+  const ppc::util::BlockPartition partition(static_cast<std::size_t>(text_len), world_size);
+  const std::vector<int> send_counts = partition.Counts();
+  const std::vector<int> displs = partition.Displs();
 
   int local_count = send_counts[rank];
   std::vector<char> local_data(local_count);
@@ -3,10 +3,12 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <vector>
 
 #include "dergachev_a_max_elem_vec/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace dergachev_a_max_elem_vec {
 
@@ -41,16 +43,9 @@ bool DergachevAMaxElemVecMPI::PreProcessingImpl() {
 
   MPI_Bcast(&vector_size_, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-  const int base_chunk_size = vector_size_ / total_processes;
-  const int remainder = vector_size_ % total_processes;
-
-  std::vector<int> send_counts(total_processes);
-  std::vector<int> displacements(total_processes);
-
-  for (int i = 0; i < total_processes; ++i) {
-    send_counts[i] = base_chunk_size + (i < remainder ? 1 : 0);
-    displacements[i] = (i * base_chunk_size) + std::min(i, remainder);
-  }
+  const ppc::util::BlockPartition partition(static_cast<std::size_t>(vector_size_), total_processes);
+  const auto send_counts = partition.Counts();
+  const auto displacements = partition.Displs();
 
   std::vector<InType> full_data;
   if (process_rank == 0) {
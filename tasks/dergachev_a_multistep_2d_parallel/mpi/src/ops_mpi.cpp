@@ -10,25 +10,12 @@
 #include <vector>
 
 #include "dergachev_a_multistep_2d_parallel/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace dergachev_a_multistep_2d_parallel {
 
 namespace {
 
-void ComputeDistribution(int num_intervals, int world_size, std::vector<int> &counts, std::vector<int> &displs) {
-  counts.resize(static_cast<std::size_t>(world_size));
-  displs.resize(static_cast<std::size_t>(world_size));
-
-  int base_count = num_intervals / world_size;
-  int remainder = num_intervals % world_size;
-
-  for (int i = 0; i < world_size; ++i) {
-    auto idx = static_cast<std::size_t>(i);
-    counts[idx] = base_count + ((i < remainder) ? 1 : 0);
-    displs[idx] = (i == 0) ? 0 : (displs[idx - 1] + counts[idx - 1]);
-  }
-}
-
 void PrepareIntervalData(const std::vector<double> &t_values, const std::vector<TrialPoint> &trials, int num_intervals,
                          std::vector<double> &interval_data) {
   interval_data.resize(static_cast<std::size_t>(num_intervals) * 4);
@@ -278,9 +265,9 @@ void DergachevAMultistep2dParallelMPI::ComputeCharacteristicsParallel(double m_v
     return;
   }
 
-  std::vector<int> counts;
-  std::vector<int> displs;
-  ComputeDistribution(num_intervals, world_size_, counts, displs);
+  const ppc::util::BlockPartition partition(static_cast<std::size_t>(num_intervals), world_size_);
+  const auto counts = partition.Counts();
+  const auto displs = partition.Displs();
 
   std::vector<double> interval_data;
   if (world_rank_ == 0) {
@@ -289,13 +276,9 @@ void DergachevAMultistep2dParallelMPI::ComputeCharacteristicsParallel(double m_v
     interval_data.resize(static_cast<std::size_t>(num_intervals) * 4);
   }
 
-  std::vector<int> send_counts(static_cast<std::size_t>(world_size_));
-  std::vector<int> send_displs(static_cast<std::size_t>(world_size_));
-  for (int i = 0; i < world_size_; ++i) {
-    auto idx = static_cast<std::size_t>(i);
-    send_counts[idx] = counts[idx] * 4;
-    send_displs[idx] = displs[idx] * 4;
-  }
+  // Four values per interval
+  const auto send_counts = partition.Counts(4);
+  const auto send_displs = partition.Displs(4);
 
   int local_count = counts[static_cast<std::size_t>(world_rank_)];
   std::vector<double> local_interval_data(static_cast<std::size_t>(local_count) * 4);
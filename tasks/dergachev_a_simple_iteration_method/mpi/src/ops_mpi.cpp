@@ -7,30 +7,12 @@
 #include <vector>
 
 #include "dergachev_a_simple_iteration_method/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace dergachev_a_simple_iteration_method {
 
 namespace {
 
-void ComputeRowDistribution(int n, int size, std::vector<int> &row_counts, std::vector<int> &row_displs,
-                            std::vector<int> &matrix_counts, std::vector<int> &matrix_displs) {
-  int row_offset = 0;
-  int matrix_offset = 0;
-  for (int proc = 0; proc < size; proc++) {
-    int base_rows = n / size;
-    int extra = (proc < (n % size)) ? 1 : 0;
-    int proc_rows = base_rows + extra;
-
-    row_counts[proc] = proc_rows;
-    row_displs[proc] = row_offset;
-    matrix_counts[proc] = proc_rows * n;
-    matrix_displs[proc] = matrix_offset;
-
-    row_offset += proc_rows;
-    matrix_offset += proc_rows * n;
-  }
-}
-
 int ComputeFinalResult(const std::vector<double> &x, int n) {
   double sum = 0.0;
   for (int i = 0; i < n; i++) {
@@ -145,11 +127,11 @@ bool DergachevASimpleIterationMethodMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  std::vector<int> row_counts(size);
-  std::vector<int> row_displs(size);
-  std::vector<int> matrix_counts(size);
-  std::vector<int> matrix_displs(size);
-  ComputeRowDistribution(n, size, row_counts, row_displs, matrix_counts, matrix_displs);
+  const ppc::util::BlockPartition rows(static_cast<std::size_t>(n), size);
+  const auto row_counts = rows.Counts();
+  const auto row_displs = rows.Displs();
+  const auto matrix_counts = rows.Counts(static_cast<std::size_t>(n));
+  const auto matrix_displs = rows.Displs(static_cast<std::size_t>(n));
 
   int local_rows = row_counts[rank];
   int start_row = row_displs[rank];
@@ -10,7 +10,7 @@ class ErmakovANumbViolElemVecMPI : public BaseTask {
   static constexpr auto GetStaticTypeOfTask() -> ppc::task::TypeOfTask {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ErmakovANumbViolElemVecMPI(const InType &in);
+  explicit ErmakovANumbViolElemVecMPI(InType in);
 
  private:
   auto ValidationImpl() -> bool override;
@@ -3,6 +3,7 @@
 #include <mpi.h>
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "ermakov_a_numb_viol_elem_vec/common/include/common.hpp"
@@ -82,9 +83,9 @@ int CheckBoundaryViolation(const std::vector<int> &local, const std::vector<int>
 
 }  // namespace
 
-ErmakovANumbViolElemVecMPI::ErmakovANumbViolElemVecMPI(const InType &in) {
+ErmakovANumbViolElemVecMPI::ErmakovANumbViolElemVecMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
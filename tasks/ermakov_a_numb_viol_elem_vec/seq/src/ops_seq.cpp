@@ -1,14 +1,15 @@
 #include "ermakov_a_numb_viol_elem_vec/seq/include/ops_seq.hpp"
 
+#include <utility>
 #include <vector>
 
 #include "ermakov_a_numb_viol_elem_vec/common/include/common.hpp"
 
 namespace ermakov_a_numb_viol_elem_vec {
 
-ErmakovANumbViolElemVecSEQ::ErmakovANumbViolElemVecSEQ(const InType &in) {
+ErmakovANumbViolElemVecSEQ::ErmakovANumbViolElemVecSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -1,11 +1,14 @@
 #include <gtest/gtest.h>
 
-#include <random>
+#include <cstdint>
+#include <span>
+
 
 #include "ermakov_a_numb_viol_elem_vec/common/include/common.hpp"
 #include "ermakov_a_numb_viol_elem_vec/mpi/include/ops_mpi.hpp"
 #include "ermakov_a_numb_viol_elem_vec/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace ermakov_a_numb_viol_elem_vec {
 
@@ -13,20 +16,15 @@ class ErmakovANumbViolElemVecPerfTests : public ppc::util::BaseRunPerfTests<InTy
  protected:
   void SetUp() override {
     const int k_input_size = 250000000;
+    const uint64_t k_seed = 1;
 
     input_data_.resize(k_input_size);
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> small_dist(0, 50);
-    std::uniform_int_distribution<int> large_dist(100, 500);
-
+    // One counter-based fill (all OpenMP threads) for both ranges: even elements are shifted to [100, 500], odd
+    // ones scaled down to [0, 50]
+    ppc::util::FillUniform(ppc::util::CounterRng(k_seed), std::span(input_data_), 0, 0, 400);
     for (int i = 0; i < k_input_size; ++i) {
-      if ((i % 2) == 0) {
-        input_data_[i] = large_dist(gen);
-      } else {
-        input_data_[i] = small_dist(gen);
-      }
+      input_data_[i] = ((i % 2) == 0) ? input_data_[i] + 100 : input_data_[i] / 8;
     }
 
     expected_count_ = 0;
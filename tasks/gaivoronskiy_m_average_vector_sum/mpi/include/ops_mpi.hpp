@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstddef>
-#include <vector>
 
 #include "gaivoronskiy_m_average_vector_sum/common/include/common.hpp"
 #include "task/include/task.hpp"
@@ -13,7 +12,7 @@ class GaivoronskiyMAverageVecSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit GaivoronskiyMAverageVecSumMPI(const InType &in);
+  explicit GaivoronskiyMAverageVecSumMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -21,8 +20,6 @@ class GaivoronskiyMAverageVecSumMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  InType distributed_values_;
-  std::vector<double> local_buffer_;
   std::size_t total_size_ = 0;
   double local_sum_ = 0.0;
   double global_sum_ = 0.0;
@@ -2,14 +2,15 @@
 
 #include <cmath>
 #include <numeric>
+#include <utility>
 
 #include "gaivoronskiy_m_average_vector_sum/common/include/common.hpp"
 
 namespace gaivoronskiy_m_average_vector_sum {
 
-GaivoronskiyMAverageVecSumSEQ::GaivoronskiyMAverageVecSumSEQ(const InType &in) {
+GaivoronskiyMAverageVecSumSEQ::GaivoronskiyMAverageVecSumSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0.0;
 }
 
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <array>
 #include <cctype>
@@ -15,6 +16,7 @@
 #include "gaivoronskiy_m_average_vector_sum/mpi/include/ops_mpi.hpp"
 #include "gaivoronskiy_m_average_vector_sum/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
+#include "util/include/partition.hpp"
 #include "util/include/util.hpp"
 
 namespace gaivoronskiy_m_average_vector_sum {
@@ -35,6 +37,21 @@ std::vector<double> LoadVectorFromFile(const std::string &file_name) {
   return data;
 }
 
+// The MPI task takes the block of the vector owned by each rank
+std::vector<double> LocalBlock(const std::vector<double> &data) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto range = ppc::util::BlockPartition(data.size(), size).Range(rank);
+  return {data.begin() + static_cast<std::ptrdiff_t>(range.begin),
+          data.begin() + static_cast<std::ptrdiff_t>(range.end)};
+}
+
+bool IsMpiUnderMpirun(const std::string &test_name) {
+  return test_name.find("_mpi_") != std::string::npos && ppc::util::IsUnderMpirun();
+}
+
 std::string StripExtension(const std::string &file_name) {
   const auto pos = file_name.find_last_of('.');
   if (pos == std::string::npos) {
@@ -63,7 +80,11 @@ class AverageVectorSumFuncTests : public ppc::util::BaseRunFuncTests<InType, Out
  protected:
   void SetUp() override {
     const auto &params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
+    const auto &test_name = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kNameTest)>(GetParam());
     input_data_ = LoadVectorFromFile(std::get<0>(params));
+    if (IsMpiUnderMpirun(test_name)) {
+      input_data_ = LocalBlock(input_data_);
+    }
     expected_average_ = std::get<1>(params);
   }
 
@@ -115,7 +136,11 @@ class AverageVectorSumValidationTests : public ppc::util::BaseRunFuncTests<InTyp
  protected:
   void SetUp() override {
     const auto &params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
+    const auto &test_name = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kNameTest)>(GetParam());
     input_data_ = LoadVectorFromFile(std::get<0>(params));
+    if (IsMpiUnderMpirun(test_name)) {
+      input_data_ = LocalBlock(input_data_);
+    }
   }
 
   bool CheckTestOutputData(OutType & /*output_data*/) final {
@@ -1,17 +1,19 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
-#include <array>
-#include <charconv>
 #include <cmath>
 #include <cstddef>
-#include <fstream>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
 #include <numeric>
+#include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <system_error>
-#include <tuple>
-#include <utility>
 #include <vector>
 
 #include "gaivoronskiy_m_average_vector_sum/common/include/common.hpp"
@@ -19,6 +21,7 @@
 #include "gaivoronskiy_m_average_vector_sum/seq/include/ops_seq.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
+#include "util/include/dataset.hpp"
 #include "util/include/perf_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -26,21 +29,67 @@ namespace gaivoronskiy_m_average_vector_sum {
 
 namespace {
 
-constexpr std::array<std::size_t, 4> kPerfSizes = {1'000'000, 5'000'000, 20'000'000, 100'000'000};
-constexpr std::string_view kPerfBaseFile = "perf_vec_base.txt";
-
-std::vector<double> LoadVectorFromFile(const std::string &file_name) {
-  std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_gaivoronskiy_m_average_vector_sum, file_name);
-  std::ifstream file(abs_path);
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open file: " + abs_path);
+const ppc::util::PerfSizes kPerfSizes = {1'000'000, 5'000'000, 20'000'000, 100'000'000};
+constexpr std::string_view kPerfBaseFile = "perf_vec_base.bin";
+
+/// Full-size perf input: perf_vec_base.bin repeated to `size` values. Built once per node and cached in
+/// the temp directory; the name carries the checksum of the base block, so editing it invalidates the cache.
+std::string GetPerfDatasetPath(std::size_t size) {
+  const auto base_path =
+      ppc::util::GetAbsoluteTaskPath(PPC_ID_gaivoronskiy_m_average_vector_sum, std::string(kPerfBaseFile));
+  const auto checksum = ppc::util::ReadDatasetHeader(base_path).checksum;
+  const auto path = std::filesystem::temp_directory_path() /
+                    std::format("gaivoronskiy_m_average_vector_sum_perf_vec_{}_{:08x}.bin", size, checksum);
+
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_free(&node_comm);
+
+  int ok = 1;
+  if (node_rank == 0) {
+    try {
+      const bool cached = std::filesystem::exists(path) &&
+                          ppc::util::ReadDatasetHeader(path.string()).shape == std::vector<uint64_t>{size};
+      if (!cached) {
+        const auto base = ppc::util::MappedDataset::Open(base_path);
+        const auto pattern = base.View<double>();
+        if (pattern.empty()) {
+          throw std::runtime_error("Performance base vector file is empty");
+        }
+        std::vector<double> values(size);
+        for (std::size_t i = 0; i < size; i++) {
+          values[i] = pattern[i % pattern.size()];
+        }
+        // Written aside and renamed, so a concurrent or interrupted run never maps a partial file
+        const auto tmp_path = path.string() + std::format(".{:08x}.tmp", std::random_device{}());
+        ppc::util::WriteDataset(tmp_path, std::span<const double>(values));
+        std::filesystem::rename(tmp_path, path);
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "[  ERROR  ] " << e.what() << '\n';
+      ok = 0;
+    }
   }
-  std::vector<double> data;
-  double value = 0.0;
-  while (file >> value) {
-    data.push_back(value);
+  // Also the barrier that keeps the other ranks from opening the file before it is complete
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (ok == 0) {
+    throw std::runtime_error("Failed to create the performance dataset " + path.string());
   }
-  return data;
+  return path.string();
+}
+
+/// Average of `size` values of the repeated base block, from the block alone.
+double GetExpectedAverage(std::size_t size) {
+  const auto base = ppc::util::MappedDataset::Open(
+      ppc::util::GetAbsoluteTaskPath(PPC_ID_gaivoronskiy_m_average_vector_sum, std::string(kPerfBaseFile)));
+  const auto pattern = base.View<double>();
+  const std::size_t repeats = size / pattern.size();
+  const std::size_t remainder = size % pattern.size();
+  const double sum = (static_cast<double>(repeats) * std::accumulate(pattern.begin(), pattern.end(), 0.0)) +
+                     std::accumulate(pattern.begin(), pattern.begin() + static_cast<std::ptrdiff_t>(remainder), 0.0);
+  return sum / static_cast<double>(size);
 }
 
 }  // namespace
@@ -48,24 +97,20 @@ std::vector<double> LoadVectorFromFile(const std::string &file_name) {
 class GaivoronskiyRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, OutType> {
  protected:
   void SetUp() override {
+    const std::size_t data_size = GetProblemSize();
+    const auto path = GetPerfDatasetPath(data_size);
     const auto &test_name = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kNameTest)>(GetParam());
-    const std::size_t data_size = ResolveInputSizeFromTestParam(test_name);
-    const auto base_pattern = LoadVectorFromFile(std::string(kPerfBaseFile));
-    if (base_pattern.empty()) {
-      throw std::runtime_error("Performance base vector file is empty");
-    }
-    input_data_.clear();
-    input_data_.reserve(data_size);
-    while (input_data_.size() < data_size) {
-      const std::size_t remaining = data_size - input_data_.size();
-      if (remaining >= base_pattern.size()) {
-        input_data_.insert(input_data_.end(), base_pattern.begin(), base_pattern.end());
-      } else {
-        input_data_.insert(input_data_.end(), base_pattern.begin(),
-                           base_pattern.begin() + static_cast<std::ptrdiff_t>(remaining));
-      }
+    // The MPI task takes the block of each rank, so every rank maps only its own rows
+    int rank = 0;
+    int size = 1;
+    if (test_name.find("_mpi_") != std::string::npos) {
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
     }
-    expected_average_ = CalculateAverage(input_data_);
+    const auto dataset = ppc::util::MappedDataset::OpenSlice(path, rank, size);
+    const auto values = dataset.View<double>();
+    input_data_.assign(values.begin(), values.end());
+    expected_average_ = GetExpectedAverage(data_size);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -78,26 +123,6 @@ class GaivoronskiyRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InTy
   }
 
  private:
-  static std::size_t ResolveInputSizeFromTestParam(const std::string &test_name) {
-    constexpr std::string_view kSizeTag = "_size";
-    const auto pos = test_name.rfind(kSizeTag);
-    if (pos == std::string::npos) {
-      return kPerfSizes.front();
-    }
-    const auto suffix = std::string_view(test_name).substr(pos + kSizeTag.size());
-    std::size_t parsed_value = 0;
-    const auto result = std::from_chars(suffix.data(), suffix.data() + suffix.size(), parsed_value);
-    if (result.ec != std::errc() || parsed_value == 0) {
-      return kPerfSizes.front();
-    }
-    return parsed_value;
-  }
-
-  static double CalculateAverage(const InType &values) {
-    const double sum = std::accumulate(values.begin(), values.end(), 0.0);
-    return sum / static_cast<double>(values.size());
-  }
-
   InType input_data_;
   OutType expected_average_ = 0.0;
 };
@@ -106,37 +131,9 @@ TEST_P(GaivoronskiyRunPerfTestProcesses, RunPerfModes) {
   ExecuteTest(GetParam());
 }
 
-namespace {
-
-template <typename TaskType>
-auto MakePerfTaskTuplesForSize(std::size_t size, const std::string &settings_path) {
-  const auto base_name = std::string(ppc::util::GetNamespace<TaskType>()) + "_" +
-                         ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
-  const auto size_suffix = "_size" + std::to_string(size);
-  const auto task_name = base_name + size_suffix;
-  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InType>, task_name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline),
-                         std::make_tuple(ppc::task::TaskGetter<TaskType, InType>, task_name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
-}
-
-template <typename TaskType, std::size_t N, std::size_t... I>
-auto MakePerfTasksForAllSizesImpl(const std::array<std::size_t, N> &sizes, const std::string &settings_path,
-                                  std::index_sequence<I...> /*unused*/) {
-  return std::tuple_cat(MakePerfTaskTuplesForSize<TaskType>(sizes[I], settings_path)...);
-}
-
-template <typename TaskType, std::size_t N>
-auto MakePerfTasksForAllSizes(const std::array<std::size_t, N> &sizes, const std::string &settings_path) {
-  return MakePerfTasksForAllSizesImpl<TaskType>(sizes, settings_path, std::make_index_sequence<N>{});
-}
-
-}  // namespace
-
-const auto kAllPerfTasks = std::tuple_cat(
-    MakePerfTasksForAllSizes<GaivoronskiyMAverageVecSumMPI>(kPerfSizes, PPC_SETTINGS_gaivoronskiy_m_average_vector_sum),
-    MakePerfTasksForAllSizes<GaivoronskiyMAverageVecSumSEQ>(kPerfSizes,
-                                                            PPC_SETTINGS_gaivoronskiy_m_average_vector_sum));
+const auto kAllPerfTasks =
+    ppc::util::MakeAllPerfTasks<InType, GaivoronskiyMAverageVecSumMPI, GaivoronskiyMAverageVecSumSEQ>(
+        PPC_SETTINGS_gaivoronskiy_m_average_vector_sum, kPerfSizes);
 
 const auto kGtestValues = ppc::util::TupleToGTestValues(kAllPerfTasks);
 
@@ -5,13 +5,24 @@
 #include <climits>
 #include <cmath>
 #include <cstddef>
-#include <random>
+#include <cstdint>
+#include <numeric>
+#include <span>
 #include <vector>
 
 #include "klimenko_v_seidel_method/common/include/common.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/random.hpp"
 
 namespace klimenko_v_seidel_method {
 
+namespace {
+
+// Fixed seed: the generated system is the same in every run and for any number of processes
+constexpr uint64_t kSeed = 0x5E1DE1;
+
+}  // namespace
+
 KlimenkoVSeidelMethodMPI::KlimenkoVSeidelMethodMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
@@ -51,28 +62,18 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  std::vector<int> row_counts(size);
-  std::vector<int> row_displs(size);
-  std::vector<int> matrix_counts(size);
-  std::vector<int> matrix_displs(size);
-  ComputeRowDistribution(n, size, row_counts, row_displs, matrix_counts, matrix_displs);
+  const ppc::util::BlockPartition rows(static_cast<std::size_t>(n), size);
+  const std::vector<int> row_counts = rows.Counts();
+  const std::vector<int> row_displs = rows.Displs();
 
   int local_rows = row_counts[rank];
   int start_row = row_displs[rank];
 
-  std::vector<double> flat_matrix;
-  std::vector<double> b;
-  if (rank == 0) {
-    InitializeMatrixAndVector(flat_matrix, b, n);
-  }
-
-  std::vector<double> local_matrix(static_cast<size_t>(local_rows) * n, 0.0);
-  MPI_Scatterv(flat_matrix.data(), matrix_counts.data(), matrix_displs.data(), MPI_DOUBLE, local_matrix.data(),
-               local_rows * n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
-  std::vector<double> local_b(local_rows, 0.0);
-  MPI_Scatterv(b.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, local_b.data(), local_rows, MPI_DOUBLE, 0,
-               MPI_COMM_WORLD);
+  // Every rank generates its own rows: entries are addressed by global position, so the system does not depend on
+  // the number of processes and nothing has to be scattered
+  std::vector<double> local_matrix;
+  std::vector<double> local_b;
+  InitializeLocalRows(local_matrix, local_b, start_row, local_rows, n);
 
   std::vector<double> x(n, 0.0);
   const double epsilon = 1e-6;
@@ -111,26 +112,6 @@ bool KlimenkoVSeidelMethodMPI::PostProcessingImpl() {
   return GetOutput() > 0;
 }
 
-void KlimenkoVSeidelMethodMPI::ComputeRowDistribution(int n, int size, std::vector<int> &row_counts,
-                                                      std::vector<int> &row_displs, std::vector<int> &matrix_counts,
-                                                      std::vector<int> &matrix_displs) {
-  int row_offset = 0;
-  int matrix_offset = 0;
-  for (int proc = 0; proc < size; proc++) {
-    int base_rows = n / size;
-    int extra = (proc < (n % size)) ? 1 : 0;
-    int proc_rows = base_rows + extra;
-
-    row_counts[proc] = proc_rows;
-    row_displs[proc] = row_offset;
-    matrix_counts[proc] = proc_rows * n;
-    matrix_displs[proc] = matrix_offset;
-
-    row_offset += proc_rows;
-    matrix_offset += proc_rows * n;
-  }
-}
-
 int KlimenkoVSeidelMethodMPI::ComputeFinalResult(const std::vector<double> &x, int n) {
   double sum = 0.0;
   for (int i = 0; i < n; i++) {
@@ -139,42 +120,29 @@ int KlimenkoVSeidelMethodMPI::ComputeFinalResult(const std::vector<double> &x, i
   return static_cast<int>(std::round(sum));
 }
 
-void KlimenkoVSeidelMethodMPI::InitializeMatrixAndVector(std::vector<double> &flat_matrix, std::vector<double> &b,
-                                                         int n) {
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_real_distribution<double> dist_off_diag(0.0, 1.0);
-  std::uniform_int_distribution<int> dist_diag(10, 19);
-
-  flat_matrix.resize(static_cast<size_t>(n) * n, 0.0);
-  b.resize(n, 0.0);
+void KlimenkoVSeidelMethodMPI::InitializeLocalRows(std::vector<double> &local_matrix, std::vector<double> &local_b,
+                                                   int start_row, int local_rows, int n) {
+  const ppc::util::CounterRng off_diag_rng(kSeed, 0);
+  const ppc::util::CounterRng diag_rng(kSeed, 1);
 
-  std::vector<double> x_exact(n, 1.0);
+  local_matrix.assign(static_cast<size_t>(local_rows) * n, 0.0);
+  local_b.assign(local_rows, 0.0);
+  // Element (i, j) is value i * n + j of the generator, the local rows are one contiguous run of it
+  ppc::util::FillUniform(off_diag_rng, std::span(local_matrix), static_cast<uint64_t>(start_row) * n, 0.0, 1.0);
 
-  for (int i = 0; i < n; i++) {
-    double row_sum = 0.0;
-
-    for (int j = 0; j < n; j++) {
-      if (i == j) {
-        flat_matrix[(static_cast<size_t>(i) * n) + j] = static_cast<double>(dist_diag(gen));
-      } else {
-        double val = dist_off_diag(gen);
-        flat_matrix[(static_cast<size_t>(i) * n) + j] = val;
-        row_sum += std::abs(val);
-      }
-    }
-
-    if (std::abs(flat_matrix[(static_cast<size_t>(i) * n) + i]) < row_sum) {
-      flat_matrix[(static_cast<size_t>(i) * n) + i] = row_sum + 1.0;
-    }
-  }
-
-  for (int i = 0; i < n; i++) {
-    double sum = 0.0;
-    for (int j = 0; j < n; j++) {
-      sum += flat_matrix[(static_cast<size_t>(i) * n) + j] * x_exact[j];
+  // x_exact is all ones, so b is the row sum
+  for (int i = 0; i < local_rows; i++) {
+    const auto global_i = static_cast<uint64_t>(start_row + i);
+    const std::span<double> row(local_matrix.data() + (static_cast<size_t>(i) * n), static_cast<size_t>(n));
+
+    double &diag = row[start_row + i];
+    diag = 0.0;
+    const double row_sum = std::accumulate(row.begin(), row.end(), 0.0);
+    diag = static_cast<double>(diag_rng.UniformInt(global_i, 10, 19));
+    if (diag < row_sum) {
+      diag = row_sum + 1.0;
     }
-    b[i] = sum;
+    local_b[i] = row_sum + diag;
   }
 }
 
@@ -2,14 +2,21 @@
 
 #include <climits>
 #include <cmath>
+#include <cstdint>
 #include <numeric>
-#include <random>
 #include <vector>
 
 #include "klimenko_v_seidel_method/common/include/common.hpp"
+#include "util/include/random.hpp"
 
 namespace klimenko_v_seidel_method {
 
+namespace {
+
+constexpr uint64_t kSeed = 0x5E1DE1;
+
+}  // namespace
+
 KlimenkoVSeidelMethodSEQ::KlimenkoVSeidelMethodSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
@@ -71,21 +78,20 @@ void KlimenkoVSeidelMethodSEQ::GenerateRandomMatrix(int size, std::vector<std::v
   }
   vector.resize(size, 0.0);
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dist(1, 10);
-  std::uniform_int_distribution<> dist_diag(1, 5);
+  // Fixed seed: the generated system is the same in every run
+  const ppc::util::CounterRng rng(kSeed, 0);
+  const ppc::util::CounterRng diag_rng(kSeed, 1);
 
   for (int i = 0; i < size; ++i) {
     double row_sum = 0.0;
     for (int j = 0; j < size; ++j) {
       if (i != j) {
-        matrix[i][j] = static_cast<double>(dist(gen));
+        matrix[i][j] = static_cast<double>(rng.UniformInt((static_cast<uint64_t>(i) * size) + j, 1, 10));
         row_sum += std::abs(matrix[i][j]);
       }
     }
 
-    matrix[i][i] = row_sum + static_cast<double>(dist_diag(gen));
+    matrix[i][i] = row_sum + static_cast<double>(diag_rng.UniformInt(static_cast<uint64_t>(i), 1, 5));
   }
 }
 
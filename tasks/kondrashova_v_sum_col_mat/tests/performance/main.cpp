@@ -3,13 +3,15 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <random>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include "kondrashova_v_sum_col_mat/common/include/common.hpp"
 #include "kondrashova_v_sum_col_mat/mpi/include/ops_mpi.hpp"
 #include "kondrashova_v_sum_col_mat/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace kondrashova_v_sum_col_mat {
 
@@ -41,14 +43,10 @@ class KondrashovaVSumColMatPerfTestsLittle : public ppc::util::BaseRunPerfTests<
     input_data.push_back(rows);
     input_data.push_back(cols);
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 100);
-
+    // Counter-based generator: reproducible input, filled by all OpenMP threads
+    const uint64_t seed = 1;
     std::vector<int> matrix(static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols));
-    for (int i = 0; i < rows * cols; i++) {
-      matrix[i] = dis(gen);
-    }
+    ppc::util::FillUniform(ppc::util::CounterRng(seed), std::span(matrix), 0, 1, 100);
 
     input_data.insert(input_data.end(), matrix.begin(), matrix.end());
 
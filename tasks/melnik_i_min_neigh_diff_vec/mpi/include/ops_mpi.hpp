@@ -13,7 +13,7 @@ class MelnikIMinNeighDiffVecMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit MelnikIMinNeighDiffVecMPI(const InType &in);
+  explicit MelnikIMinNeighDiffVecMPI(InType in);
 
  private:
   bool ValidationImpl() override;
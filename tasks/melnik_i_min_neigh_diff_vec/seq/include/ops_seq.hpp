@@ -10,7 +10,7 @@ class MelnikIMinNeighDiffVecSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit MelnikIMinNeighDiffVecSEQ(const InType &in);
+  explicit MelnikIMinNeighDiffVecSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -4,15 +4,16 @@
 #include <cstdlib>
 #include <ranges>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "melnik_i_min_neigh_diff_vec/common/include/common.hpp"
 
 namespace melnik_i_min_neigh_diff_vec {
 
-MelnikIMinNeighDiffVecSEQ::MelnikIMinNeighDiffVecSEQ(const InType &in) {
+MelnikIMinNeighDiffVecSEQ::MelnikIMinNeighDiffVecSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
@@ -1,35 +1,30 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
-#include <random>
-#include <vector>
+#include <cstdint>
+#include <span>
 
 #include "melnik_i_min_neigh_diff_vec/common/include/common.hpp"
 #include "melnik_i_min_neigh_diff_vec/mpi/include/ops_mpi.hpp"
 #include "melnik_i_min_neigh_diff_vec/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace melnik_i_min_neigh_diff_vec {
 
 class MelnikIMinNeighDiffVecRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, OutType> {
   InType input_data_;
 
-  void GenerateVector(unsigned int seed) {
+  void GenerateVector(uint64_t seed) {
     const size_t vector_size = 200000000;
 
-    std::vector<int> vector(vector_size);
-    std::mt19937 generator(seed);
-    std::uniform_int_distribution<int> distribution(-1000000, 1000000);
-
-    for (size_t i = 0; i < vector_size; i++) {
-      vector[i] = distribution(generator);
-    }
-
-    input_data_ = vector;
+    // Counter-based generator: reproducible input, filled by all OpenMP threads
+    input_data_.resize(vector_size);
+    ppc::util::FillUniform(ppc::util::CounterRng(seed), std::span(input_data_), 0, -1000000, 1000000);
   }
 
   void SetUp() override {
-    const unsigned int seed = 3301;
+    const uint64_t seed = 3301;
     GenerateVector(seed);
   }
 
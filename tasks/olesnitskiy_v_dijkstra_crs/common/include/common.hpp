@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/partition.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
 
@@ -21,4 +25,23 @@ struct GraphCRS {
   std::vector<int> weights;
 };
 
+/// @brief CRS rows of one block of vertices; offsets are relative to the first edge of the block.
+struct CrsBlock {
+  ppc::util::PartitionRange rows;
+  /// rows.Size() + 1 values starting at 0.
+  std::vector<int> offsets{0};
+  std::vector<int> edges;
+  std::vector<int> weights;
+};
+
+/// @brief Vertex blocks with about the same number of edges each, so high-degree vertices do not overload a rank.
+/// @details A vertex costs its degree plus one: vertices without edges still take some work and are spread as well.
+inline ppc::util::BlockPartition PartitionByEdges(std::span<const int> offsets, int parts) {
+  std::vector<std::int64_t> cost_prefix(offsets.size());
+  for (std::size_t i = 0; i < offsets.size(); ++i) {
+    cost_prefix[i] = static_cast<std::int64_t>(offsets[i]) + static_cast<std::int64_t>(i);
+  }
+  return ppc::util::BlockPartition::Balanced(cost_prefix, parts);
+}
+
 }  // namespace olesnitskiy_v_dijkstra_crs
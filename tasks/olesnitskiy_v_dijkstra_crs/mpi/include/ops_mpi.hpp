@@ -1,12 +1,11 @@
 #pragma once
 
-#include <functional>
-#include <queue>
-#include <utility>
+#include <cstdint>
 #include <vector>
 
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/partition.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
 
@@ -28,52 +27,60 @@ class OlesnitskiyVDijkstraCrsMPI : public BaseTask {
     int distance{0};
   };
 
-  struct DistVertexPair {
-    int dist{0};
-    int vertex{0};
-  };
-
+  /// @brief Graph as seen by one rank: global sizes and the CRS rows of its own block of vertices.
   struct GraphData {
     int vertices{0};
     int source{0};
-    std::vector<int> offsets;
-    std::vector<int> edges;
-    std::vector<int> weights;
+    int max_weight{0};
+    std::int64_t total_edges{0};
+    /// Edge-balanced vertex blocks of all ranks
+    ppc::util::BlockPartition partition{0, 1};
+    CrsBlock block;
   };
 
-  struct DijkstraContext {
+  enum class EdgeClass : std::uint8_t { kLight, kHeavy };
+
+  /// @brief Delta-stepping state of one rank: distances and buckets of its block of vertices.
+  /// @details Bucket b holds the vertices with a tentative distance in [b * delta, (b + 1) * delta). Only
+  /// max_weight / delta + 2 buckets can be non-empty at a time, so they are kept in a ring and entries whose distance
+  /// has moved on are dropped lazily.
+  struct DeltaSteppingContext {
+    int rank{0};
     int start_idx{0};
     int end_idx{0};
     int local_vertices{0};
-    int active{1};
-    std::vector<int> counts;
-    std::vector<int> displs;
+    int delta{1};
+    bool has_heavy_edges{false};
+    ppc::util::BlockPartition partition{0, 1};
     std::vector<int> local_distances;
-    std::vector<bool> local_visited;
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
+    /// Distance each vertex was last relaxed from; relaxing it again from the same distance changes nothing
+    std::vector<int> relaxed_distances;
+    std::vector<std::vector<int>> buckets;
+    /// Vertices settled in the current bucket, whose heavy edges are relaxed once the bucket is done
+    std::vector<int> settled;
+    std::vector<bool> in_settled;
     std::vector<std::vector<Update>> send_bufs;
   };
 
-  static bool IsVertexLocal(int vertex, int start_idx, int end_idx);
-  static int FindOwner(int vertex, const std::vector<int> &displs, const std::vector<int> &counts, int size);
-  static void ProcessLocalVertex(int vertex, int distance, const std::vector<int> &offsets,
-                                 const std::vector<int> &edges, const std::vector<int> &weights, DijkstraContext &ctx,
-                                 int rank, int size);
-  static void ProcessReceivedData(const std::vector<int> &recv_data, int total_recv, DijkstraContext &ctx);
+  /// @brief Checks the CRS arrays, the source and the edge targets and weights; only called on rank 0.
+  static bool IsValidGraph(const InType &input);
+  static void ProcessReceivedData(const std::vector<int> &recv_data, int total_recv, DeltaSteppingContext &ctx);
   static void PrepareSendData(const std::vector<std::vector<Update>> &send_bufs, std::vector<int> &send_data);
   static void CalculateDisplacements(const std::vector<int> &sizes, std::vector<int> &displs, int &total);
   static void PrepareByteArrays(const std::vector<int> &sizes, const std::vector<int> &displs,
                                 std::vector<int> &counts_bytes, std::vector<int> &displs_bytes);
-  static GraphData BroadcastGraphData(int rank, int /*size*/, const InType &input);
-  static DistVertexPair FindGlobalBestVertex(const DistVertexPair &local_best);
-  static bool ShouldStopAlgorithm(const DistVertexPair &global_best);
-  static void ExchangeUpdates(DijkstraContext &ctx);
-  static DijkstraContext InitializeLocalData(int vertices, int size, int rank, int source);
-  static bool FindLocalBestVertex(DijkstraContext &ctx, DistVertexPair &local_best);
-  static void ProcessGlobalVertex(const DistVertexPair &global_best, const GraphData &graph, DijkstraContext &ctx,
-                                  int rank, int size);
-  static bool PerformDijkstraIteration(const GraphData &graph, DijkstraContext &ctx, int rank, int size);
-  static void RunDijkstraAlgorithm(const GraphData &graph, DijkstraContext &ctx, int rank, int size);
-  void CollectResults(const GraphData &graph, const DijkstraContext &ctx, int rank, int size);
+  static GraphData ScatterGraphData(int rank, int size, const InType &input);
+  static int ChooseDelta(const GraphData &graph);
+  static DeltaSteppingContext InitializeLocalData(const GraphData &graph, int size, int rank);
+  static std::vector<int> &BucketOf(int bucket, DeltaSteppingContext &ctx);
+  static void Relax(int vertex, int distance, DeltaSteppingContext &ctx);
+  static void RelaxEdges(int local_idx, EdgeClass edge_class, const GraphData &graph, DeltaSteppingContext &ctx);
+  static void ExchangeUpdates(DeltaSteppingContext &ctx);
+  static bool HasVertices(int bucket, DeltaSteppingContext &ctx);
+  static int FindGlobalMinBucket(int first, DeltaSteppingContext &ctx);
+  static void ProcessLightFrontier(int bucket, const GraphData &graph, DeltaSteppingContext &ctx);
+  static void ProcessBucket(int bucket, const GraphData &graph, DeltaSteppingContext &ctx);
+  static void RunDeltaStepping(const GraphData &graph, DeltaSteppingContext &ctx);
+  void CollectResults(const GraphData &graph, const DeltaSteppingContext &ctx, int rank, int size);
 };
 }  // namespace olesnitskiy_v_dijkstra_crs
@@ -3,24 +3,40 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <limits>
-#include <queue>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
 
 OlesnitskiyVDijkstraCrsMPI::OlesnitskiyVDijkstraCrsMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  // Only rank 0 keeps the graph; the other ranks receive their block of rows in RunImpl
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    GetInput() = in;
+  }
   GetOutput() = std::vector<int>();
 }
 
 bool OlesnitskiyVDijkstraCrsMPI::ValidationImpl() {
-  const auto &input = GetInput();
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  int valid = rank == 0 ? static_cast<int>(IsValidGraph(GetInput())) : 0;
+  MPI_Bcast(&valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return valid != 0;
+}
+
+bool OlesnitskiyVDijkstraCrsMPI::IsValidGraph(const InType &input) {
   int source = std::get<0>(input);
   const auto &offsets = std::get<1>(input);
   const auto &edges = std::get<2>(input);
@@ -39,6 +55,16 @@ bool OlesnitskiyVDijkstraCrsMPI::ValidationImpl() {
   if (edges.size() != weights.size()) {
     return false;
   }
+  if (offsets.front() != 0 || std::cmp_greater(offsets.back(), edges.size()) ||
+      std::ranges::adjacent_find(offsets, std::greater<>()) != offsets.end()) {
+    return false;
+  }
+  if (std::ranges::any_of(edges, [vertices](int v) { return v < 0 || v >= vertices; })) {
+    return false;
+  }
+  if (std::ranges::any_of(weights, [](int w) { return w < 0; })) {
+    return false;
+  }
 
   return true;
 }
@@ -47,45 +73,6 @@ bool OlesnitskiyVDijkstraCrsMPI::PreProcessingImpl() {
   return true;
 }
 
-bool OlesnitskiyVDijkstraCrsMPI::IsVertexLocal(int vertex, int start_idx, int end_idx) {
-  return vertex >= start_idx && vertex < end_idx;
-}
-
-int OlesnitskiyVDijkstraCrsMPI::FindOwner(int vertex, const std::vector<int> &displs, const std::vector<int> &counts,
-                                          int size) {
-  for (int j = 0; j < size; ++j) {
-    if (vertex >= displs[j] && vertex < (displs[j] + counts[j])) {
-      return j;
-    }
-  }
-  return 0;
-}
-
-void OlesnitskiyVDijkstraCrsMPI::ProcessLocalVertex(int vertex, int distance, const std::vector<int> &offsets,
-                                                    const std::vector<int> &edges, const std::vector<int> &weights,
-                                                    DijkstraContext &ctx, int rank, int size) {
-  int start = offsets[vertex];
-  int end = offsets[vertex + 1];
-
-  for (int i = start; i < end; ++i) {
-    int neighbor = edges[i];
-    int weight = weights[i];
-    int new_dist = distance + weight;
-
-    int owner = FindOwner(neighbor, ctx.displs, ctx.counts, size);
-
-    if (owner == rank) {
-      int neighbor_local_idx = neighbor - ctx.start_idx;
-      if (!ctx.local_visited[neighbor_local_idx] && new_dist < ctx.local_distances[neighbor_local_idx]) {
-        ctx.local_distances[neighbor_local_idx] = new_dist;
-        ctx.pq.emplace(new_dist, neighbor);
-      }
-    } else {
-      ctx.send_bufs[owner].push_back(Update{.vertex = neighbor, .distance = new_dist});
-    }
-  }
-}
-
 void OlesnitskiyVDijkstraCrsMPI::PrepareSendData(const std::vector<std::vector<Update>> &send_bufs,
                                                  std::vector<int> &send_data) {
   int idx = 0;
@@ -98,23 +85,9 @@ void OlesnitskiyVDijkstraCrsMPI::PrepareSendData(const std::vector<std::vector<U
 }
 
 void OlesnitskiyVDijkstraCrsMPI::ProcessReceivedData(const std::vector<int> &recv_data, int total_recv,
-                                                     DijkstraContext &ctx) {
+                                                     DeltaSteppingContext &ctx) {
   for (int i = 0; i < total_recv * 2; i += 2) {
-    int neighbor = recv_data[i];
-    int new_dist = recv_data[i + 1];
-
-    if (!IsVertexLocal(neighbor, ctx.start_idx, ctx.end_idx)) {
-      continue;
-    }
-
-    int local_idx = neighbor - ctx.start_idx;
-    bool should_update = !ctx.local_visited[local_idx] && new_dist < ctx.local_distances[local_idx];
-    if (!should_update) {
-      continue;
-    }
-
-    ctx.local_distances[local_idx] = new_dist;
-    ctx.pq.emplace(new_dist, neighbor);
+    Relax(recv_data[i], recv_data[i + 1], ctx);
   }
 }
 
@@ -135,7 +108,7 @@ void OlesnitskiyVDijkstraCrsMPI::PrepareByteArrays(const std::vector<int> &sizes
   }
 }
 
-void OlesnitskiyVDijkstraCrsMPI::ExchangeUpdates(DijkstraContext &ctx) {
+void OlesnitskiyVDijkstraCrsMPI::ExchangeUpdates(DeltaSteppingContext &ctx) {
   int size = static_cast<int>(ctx.send_bufs.size());
   std::vector<int> send_sizes(size);
   std::vector<int> recv_sizes(size);
@@ -179,159 +152,198 @@ void OlesnitskiyVDijkstraCrsMPI::ExchangeUpdates(DijkstraContext &ctx) {
   ProcessReceivedData(recv_data, total_recv, ctx);
 }
 
-OlesnitskiyVDijkstraCrsMPI::DijkstraContext OlesnitskiyVDijkstraCrsMPI::InitializeLocalData(int vertices, int size,
-                                                                                            int rank, int source) {
-  DijkstraContext ctx;
-  ctx.counts.resize(size);
-  ctx.displs.resize(size);
-
-  for (int idx = 0; idx < size; ++idx) {
-    ctx.counts[idx] = (vertices / size) + (idx < (vertices % size) ? 1 : 0);
-    ctx.displs[idx] = (idx == 0) ? 0 : ctx.displs[idx - 1] + ctx.counts[idx - 1];
-  }
-
-  ctx.start_idx = ctx.displs[rank];
-  ctx.end_idx = ctx.start_idx + ctx.counts[rank];
-  ctx.local_vertices = ctx.counts[rank];
-
-  ctx.local_distances.resize(ctx.local_vertices, std::numeric_limits<int>::max());
-  ctx.local_visited.resize(ctx.local_vertices, false);
-
-  if (IsVertexLocal(source, ctx.start_idx, ctx.end_idx)) {
-    ctx.local_distances[source - ctx.start_idx] = 0;
-    ctx.pq.emplace(0, source);
-  }
-
-  ctx.send_bufs.resize(size);
-  return ctx;
-}
-
-OlesnitskiyVDijkstraCrsMPI::GraphData OlesnitskiyVDijkstraCrsMPI::BroadcastGraphData(int rank, int /*size*/,
-                                                                                     const InType &input) {
+OlesnitskiyVDijkstraCrsMPI::GraphData OlesnitskiyVDijkstraCrsMPI::ScatterGraphData(int rank, int size,
+                                                                                   const InType &input) {
+  // Only rank 0 reads the input; every rank receives just the CRS rows of its own vertex block
+  const auto &[source, offsets, edges, weights] = input;
   GraphData graph;
-
+  std::vector<std::uint64_t> boundaries(static_cast<std::size_t>(size) + 1);
+  std::vector<int> edge_counts;
+  std::vector<int> edge_displs;
+  std::array<int, 4> header{};
   if (rank == 0) {
-    const auto &inp = input;
-    graph.source = std::get<0>(inp);
-    graph.offsets = std::get<1>(inp);
-    graph.edges = std::get<2>(inp);
-    graph.weights = std::get<3>(inp);
-    graph.vertices = static_cast<int>(graph.offsets.size()) - 1;
-  }
-
-  MPI_Bcast(&graph.vertices, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&graph.source, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  if (rank != 0) {
-    graph.offsets.resize(graph.vertices + 1);
-  }
-  MPI_Bcast(graph.offsets.data(), graph.vertices + 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  int total_edges = 0;
-  if (rank == 0) {
-    total_edges = static_cast<int>(graph.edges.size());
+    header = {static_cast<int>(offsets.size()) - 1, source, offsets.back(),
+              weights.empty() ? 0 : std::ranges::max(weights)};
+    const auto partition = PartitionByEdges(offsets, size);
+    for (int part = 0; part < size; ++part) {
+      boundaries[part] = partition.Begin(part);
+      edge_displs.push_back(offsets[partition.Begin(part)]);
+      edge_counts.push_back(offsets[partition.End(part)] - offsets[partition.Begin(part)]);
+    }
+    boundaries.back() = partition.Total();
   }
-  MPI_Bcast(&total_edges, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  if (rank != 0) {
-    graph.edges.resize(total_edges);
-    graph.weights.resize(total_edges);
+  MPI_Bcast(header.data(), static_cast<int>(header.size()), MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(boundaries.data(), size + 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+  graph.vertices = header[0];
+  graph.source = header[1];
+  graph.total_edges = header[2];
+  graph.max_weight = header[3];
+  graph.partition = ppc::util::BlockPartition::FromBoundaries({boundaries.begin(), boundaries.end()});
+
+  auto &block = graph.block;
+  block.rows = graph.partition.Range(rank);
+  const auto row_counts = graph.partition.Counts();
+  const auto row_displs = graph.partition.Displs();
+  int local_edges = 0;
+  MPI_Scatter(edge_counts.data(), 1, MPI_INT, &local_edges, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  // Row starts only: the end of a block is the start of the next one, and MPI_Scatterv must not read twice
+  block.offsets.resize(block.rows.Size() + 1);
+  MPI_Scatterv(offsets.data(), row_counts.data(), row_displs.data(), MPI_INT, block.offsets.data(),
+               static_cast<int>(block.rows.Size()), MPI_INT, 0, MPI_COMM_WORLD);
+  const int first_edge = block.rows.Size() == 0 ? 0 : block.offsets.front();
+  for (std::size_t i = 0; i < block.rows.Size(); ++i) {
+    block.offsets[i] -= first_edge;
   }
-  MPI_Bcast(graph.edges.data(), total_edges, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(graph.weights.data(), total_edges, MPI_INT, 0, MPI_COMM_WORLD);
-
+  block.offsets.back() = local_edges;
+
+  block.edges.resize(local_edges);
+  block.weights.resize(local_edges);
+  MPI_Scatterv(edges.data(), edge_counts.data(), edge_displs.data(), MPI_INT, block.edges.data(), local_edges,
+               MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Scatterv(weights.data(), edge_counts.data(), edge_displs.data(), MPI_INT, block.weights.data(), local_edges,
+               MPI_INT, 0, MPI_COMM_WORLD);
   return graph;
 }
 
-bool OlesnitskiyVDijkstraCrsMPI::FindLocalBestVertex(DijkstraContext &ctx, DistVertexPair &local_best) {
-  local_best.dist = std::numeric_limits<int>::max();
-  local_best.vertex = -1;
+int OlesnitskiyVDijkstraCrsMPI::ChooseDelta(const GraphData &graph) {
+  // Meyer and Sanders: a bucket width of about max_weight / degree keeps the light phases short while the number of
+  // buckets (and so of global rounds) stays small
+  const auto average_degree = std::max<std::int64_t>(1, (graph.total_edges + graph.vertices - 1) / graph.vertices);
+  return std::max(1, static_cast<int>(graph.max_weight / average_degree));
+}
 
-  if (!ctx.pq.empty()) {
-    local_best.dist = ctx.pq.top().first;
-    local_best.vertex = ctx.pq.top().second;
-    int local_idx = local_best.vertex - ctx.start_idx;
+OlesnitskiyVDijkstraCrsMPI::DeltaSteppingContext OlesnitskiyVDijkstraCrsMPI::InitializeLocalData(
+    const GraphData &graph, int size, int rank) {
+  DeltaSteppingContext ctx;
+  ctx.rank = rank;
+  ctx.partition = graph.partition;
 
-    if (ctx.local_visited[local_idx]) {
-      ctx.pq.pop();
-      return false;
-    }
-  }
+  ctx.start_idx = static_cast<int>(ctx.partition.Begin(rank));
+  ctx.end_idx = static_cast<int>(ctx.partition.End(rank));
+  ctx.local_vertices = static_cast<int>(ctx.partition.Count(rank));
 
-  return true;
-}
+  ctx.delta = ChooseDelta(graph);
+  ctx.has_heavy_edges = graph.max_weight > ctx.delta;
+
+  ctx.local_distances.resize(ctx.local_vertices, std::numeric_limits<int>::max());
+  ctx.relaxed_distances.resize(ctx.local_vertices, std::numeric_limits<int>::max());
+  ctx.in_settled.resize(ctx.local_vertices, false);
+  ctx.buckets.resize(static_cast<std::size_t>(graph.max_weight / ctx.delta) + 2);
+  ctx.send_bufs.resize(size);
 
-OlesnitskiyVDijkstraCrsMPI::DistVertexPair OlesnitskiyVDijkstraCrsMPI::FindGlobalBestVertex(
-    const DistVertexPair &local_best) {
-  DistVertexPair global_best{};
-  MPI_Allreduce(&local_best, &global_best, 1, MPI_2INT, MPI_MINLOC, MPI_COMM_WORLD);
-  return global_best;
+  if (graph.source >= ctx.start_idx && graph.source < ctx.end_idx) {
+    Relax(graph.source, 0, ctx);
+  }
+  return ctx;
 }
 
-bool OlesnitskiyVDijkstraCrsMPI::ShouldStopAlgorithm(const DistVertexPair &global_best) {
-  return global_best.vertex == -1 || global_best.dist == std::numeric_limits<int>::max();
+std::vector<int> &OlesnitskiyVDijkstraCrsMPI::BucketOf(int bucket, DeltaSteppingContext &ctx) {
+  return ctx.buckets[static_cast<std::size_t>(bucket) % ctx.buckets.size()];
 }
 
-void OlesnitskiyVDijkstraCrsMPI::ProcessGlobalVertex(const DistVertexPair &global_best, const GraphData &graph,
-                                                     DijkstraContext &ctx, int rank, int size) {
-  if (!IsVertexLocal(global_best.vertex, ctx.start_idx, ctx.end_idx)) {
+void OlesnitskiyVDijkstraCrsMPI::Relax(int vertex, int distance, DeltaSteppingContext &ctx) {
+  const int owner = ctx.partition.Owner(static_cast<std::size_t>(vertex));
+  if (owner != ctx.rank) {
+    ctx.send_bufs[owner].push_back(Update{.vertex = vertex, .distance = distance});
     return;
   }
-
-  int local_idx = global_best.vertex - ctx.start_idx;
-  if (ctx.local_visited[local_idx]) {
-    return;
+  const int local_idx = vertex - ctx.start_idx;
+  if (distance < ctx.local_distances[local_idx]) {
+    ctx.local_distances[local_idx] = distance;
+    BucketOf(distance / ctx.delta, ctx).push_back(local_idx);
   }
+}
 
-  ctx.local_visited[local_idx] = true;
-  if (!ctx.pq.empty() && ctx.pq.top().second == global_best.vertex) {
-    ctx.pq.pop();
+void OlesnitskiyVDijkstraCrsMPI::RelaxEdges(int local_idx, EdgeClass edge_class, const GraphData &graph,
+                                            DeltaSteppingContext &ctx) {
+  const auto &block = graph.block;
+  const int distance = ctx.local_distances[local_idx];
+  for (int i = block.offsets[local_idx]; i < block.offsets[local_idx + 1]; ++i) {
+    const bool light = block.weights[i] <= ctx.delta;
+    if (light == (edge_class == EdgeClass::kLight)) {
+      Relax(block.edges[i], distance + block.weights[i], ctx);
+    }
   }
+}
 
-  ProcessLocalVertex(global_best.vertex, global_best.dist, graph.offsets, graph.edges, graph.weights, ctx, rank, size);
+bool OlesnitskiyVDijkstraCrsMPI::HasVertices(int bucket, DeltaSteppingContext &ctx) {
+  auto &entries = BucketOf(bucket, ctx);
+  std::erase_if(entries, [&](int local_idx) { return ctx.local_distances[local_idx] / ctx.delta != bucket; });
+  return !entries.empty();
 }
 
-bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph, DijkstraContext &ctx, int rank,
-                                                          int size) {
-  DistVertexPair local_best;
-  if (!FindLocalBestVertex(ctx, local_best)) {
-    return true;
+int OlesnitskiyVDijkstraCrsMPI::FindGlobalMinBucket(int first, DeltaSteppingContext &ctx) {
+  int local_min = std::numeric_limits<int>::max();
+  for (int bucket = first; bucket < first + static_cast<int>(ctx.buckets.size()); ++bucket) {
+    if (HasVertices(bucket, ctx)) {
+      local_min = bucket;
+      break;
+    }
   }
+  int global_min = std::numeric_limits<int>::max();
+  MPI_Allreduce(&local_min, &global_min, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  return global_min;
+}
 
-  DistVertexPair global_best = FindGlobalBestVertex(local_best);
-
-  if (ShouldStopAlgorithm(global_best)) {
-    return false;
+void OlesnitskiyVDijkstraCrsMPI::ProcessLightFrontier(int bucket, const GraphData &graph,
+                                                      DeltaSteppingContext &ctx) {
+  const auto frontier = std::exchange(BucketOf(bucket, ctx), {});
+  for (int local_idx : frontier) {
+    const int distance = ctx.local_distances[local_idx];
+    if (distance / ctx.delta != bucket || ctx.relaxed_distances[local_idx] == distance) {
+      continue;
+    }
+    ctx.relaxed_distances[local_idx] = distance;
+    if (!ctx.in_settled[local_idx]) {
+      ctx.in_settled[local_idx] = true;
+      ctx.settled.push_back(local_idx);
+    }
+    RelaxEdges(local_idx, EdgeClass::kLight, graph, ctx);
   }
+}
 
-  ProcessGlobalVertex(global_best, graph, ctx, rank, size);
-  ExchangeUpdates(ctx);
-
-  int local_active = !ctx.pq.empty() ? 1 : 0;
-  MPI_Allreduce(&local_active, &ctx.active, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+void OlesnitskiyVDijkstraCrsMPI::ProcessBucket(int bucket, const GraphData &graph, DeltaSteppingContext &ctx) {
+  // Light edges can put vertices back into this bucket: repeat until it stays empty on every rank
+  int active = 1;
+  while (active != 0) {
+    ProcessLightFrontier(bucket, graph, ctx);
+    ExchangeUpdates(ctx);
+    const int local_active = HasVertices(bucket, ctx) ? 1 : 0;
+    MPI_Allreduce(&local_active, &active, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+  }
 
-  return true;
+  // Distances in the bucket are final now; heavy edges only reach later buckets, so one pass suffices
+  if (ctx.has_heavy_edges) {
+    for (int local_idx : ctx.settled) {
+      RelaxEdges(local_idx, EdgeClass::kHeavy, graph, ctx);
+    }
+    ExchangeUpdates(ctx);
+  }
+  for (int local_idx : ctx.settled) {
+    ctx.in_settled[local_idx] = false;
+  }
+  ctx.settled.clear();
 }
 
-void OlesnitskiyVDijkstraCrsMPI::RunDijkstraAlgorithm(const GraphData &graph, DijkstraContext &ctx, int rank,
-                                                      int size) {
-  ctx.active = 1;
-  while (ctx.active > 0) {
-    if (!PerformDijkstraIteration(graph, ctx, rank, size)) {
-      break;
-    }
+void OlesnitskiyVDijkstraCrsMPI::RunDeltaStepping(const GraphData &graph, DeltaSteppingContext &ctx) {
+  // Every round settles a whole bucket, so the number of collective rounds follows the number of distinct
+  // distance ranges rather than the number of vertices
+  for (int bucket = FindGlobalMinBucket(0, ctx); bucket != std::numeric_limits<int>::max();
+       bucket = FindGlobalMinBucket(bucket + 1, ctx)) {
+    ProcessBucket(bucket, graph, ctx);
   }
 }
 
-void OlesnitskiyVDijkstraCrsMPI::CollectResults(const GraphData &graph, const DijkstraContext &ctx, int rank,
+void OlesnitskiyVDijkstraCrsMPI::CollectResults(const GraphData &graph, const DeltaSteppingContext &ctx, int rank,
                                                 int size) {
   if (rank == 0) {
     std::vector<int> global_distances(graph.vertices, std::numeric_limits<int>::max());
     std::ranges::copy(ctx.local_distances, global_distances.begin() + ctx.start_idx);
 
     for (int src = 1; src < size; ++src) {
-      MPI_Recv(global_distances.data() + ctx.displs[src], ctx.counts[src], MPI_INT, src, 0, MPI_COMM_WORLD,
-               MPI_STATUS_IGNORE);
+      MPI_Recv(global_distances.data() + ctx.partition.Begin(src), static_cast<int>(ctx.partition.Count(src)), MPI_INT,
+               src, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
     }
 
     GetOutput() = global_distances;
@@ -347,11 +359,11 @@ bool OlesnitskiyVDijkstraCrsMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  GraphData graph = BroadcastGraphData(rank, size, GetInput());
+  GraphData graph = ScatterGraphData(rank, size, GetInput());
 
-  DijkstraContext ctx = InitializeLocalData(graph.vertices, size, rank, graph.source);
+  DeltaSteppingContext ctx = InitializeLocalData(graph, size, rank);
 
-  RunDijkstraAlgorithm(graph, ctx, rank, size);
+  RunDeltaStepping(graph, ctx);
 
   CollectResults(graph, ctx, rank, size);
 
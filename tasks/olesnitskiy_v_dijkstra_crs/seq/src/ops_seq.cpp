@@ -1,5 +1,6 @@
 #include "olesnitskiy_v_dijkstra_crs/seq/include/ops_seq.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <queue>
@@ -35,6 +36,16 @@ bool OlesnitskiyVDijkstraCrsSEQ::ValidationImpl() {
   if (edges.size() != weights.size()) {
     return false;
   }
+  if (offsets.front() != 0 || std::cmp_greater(offsets.back(), edges.size()) ||
+      std::ranges::adjacent_find(offsets, std::greater<>()) != offsets.end()) {
+    return false;
+  }
+  if (std::ranges::any_of(edges, [vertices](int v) { return v < 0 || v >= vertices; })) {
+    return false;
+  }
+  if (std::ranges::any_of(weights, [](int w) { return w < 0; })) {
+    return false;
+  }
   return true;
 }
 
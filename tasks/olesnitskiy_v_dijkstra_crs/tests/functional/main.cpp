@@ -430,6 +430,17 @@ TEST_P(OlesnitskiyVDijkstraCrsFuncTests, DijkstraCRSTest) {
   ExecuteTest(GetParam());
 }
 
+TEST(OlesnitskiyVDijkstraCrsBlocks, PartitionsVerticesByEdges) {
+  // Vertex 0 holds most of the edges, so it gets a block of its own when the graph is split in two
+  const std::vector<int> offsets = {0, 10, 11, 12, 13, 14, 15, 16};
+  for (int parts = 1; parts <= 3; ++parts) {
+    const auto partition = PartitionByEdges(offsets, parts);
+    EXPECT_EQ(partition.Parts(), parts);
+    EXPECT_EQ(partition.Total(), 7U);
+  }
+  EXPECT_EQ(PartitionByEdges(offsets, 2).Range(0).Size(), 1U);
+}
+
 const std::array<TestType, 14> kTestParam = {
     std::make_tuple(0, "single_vertex"),   std::make_tuple(1, "two_vertices"),
     std::make_tuple(2, "chain_5"),         std::make_tuple(3, "star_6"),
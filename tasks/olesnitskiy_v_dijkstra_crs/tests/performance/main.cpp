@@ -1,89 +1,192 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
 #include "olesnitskiy_v_dijkstra_crs/mpi/include/ops_mpi.hpp"
 #include "olesnitskiy_v_dijkstra_crs/seq/include/ops_seq.hpp"
+#include "performance/include/roofline.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
-class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  const int kVertices_ = 1000000;
-  [[nodiscard]] InType GenerateTestGraph() const {
-    std::vector<int> offsets(kVertices_ + 1, 0);
-    std::vector<int> edges;
-    std::vector<int> weights;
-    for (int i = 0; i < kVertices_; ++i) {
-      for (int edge_num = 0; edge_num < 100; ++edge_num) {
-        int j = (i + edge_num * 97) % kVertices_;
-        if (j == i) {
-          j = (j + 1) % kVertices_;
-        }
-        edges.push_back(j);
-        int weight = 1 + ((i + j + edge_num) % 20);
-        weights.push_back(weight);
-        offsets[i + 1]++;
+
+namespace {
+
+constexpr std::uint64_t kGraphSeed = 2024;
+
+/// Builds a CRS graph from an edge list with a counting sort on the source vertex.
+InType MakeCrsGraph(int vertices, const std::vector<std::pair<int, int>> &arcs, const std::vector<int> &arc_weights) {
+  std::vector<int> offsets(vertices + 1, 0);
+  for (const auto &[from, to] : arcs) {
+    offsets[from + 1]++;
+  }
+  for (int i = 0; i < vertices; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+  std::vector<int> edges(arcs.size());
+  std::vector<int> weights(arcs.size());
+  std::vector<int> next(offsets.begin(), offsets.end() - 1);
+  for (std::size_t i = 0; i < arcs.size(); ++i) {
+    const int pos = next[arcs[i].first]++;
+    edges[pos] = arcs[i].second;
+    weights[pos] = arc_weights[i];
+  }
+  return std::make_tuple(0, std::move(offsets), std::move(edges), std::move(weights));
+}
+
+/// Road-like graph: a square grid where every vertex has up to four neighbours, weights 1..100.
+InType GenerateRoadGraph(int vertices) {
+  const int width = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(vertices))));
+  const ppc::util::CounterRng rng(kGraphSeed);
+  std::vector<std::pair<int, int>> arcs;
+  arcs.reserve(static_cast<std::size_t>(vertices) * 4);
+  for (int v = 0; v < vertices; ++v) {
+    const int column = v % width;
+    for (int u : {column > 0 ? v - 1 : -1, column + 1 < width ? v + 1 : -1, v - width, v + width}) {
+      if (u >= 0 && u < vertices) {
+        arcs.emplace_back(v, u);
       }
     }
-    for (int i = 0; i < kVertices_; ++i) {
-      offsets[i + 1] += offsets[i];
+  }
+  std::vector<int> weights(arcs.size());
+  ppc::util::FillUniform(rng, std::span<int>(weights), 0, 1, 100);
+  return MakeCrsGraph(vertices, arcs, weights);
+}
+
+/// Power-law graph: R-MAT with (a, b, c) = (0.57, 0.19, 0.19), 16 arcs per vertex, weights 1..255.
+InType GeneratePowerLawGraph(int vertices) {
+  constexpr int kArcsPerVertex = 16;
+  constexpr double kA = 0.57;
+  constexpr double kB = 0.19;
+  constexpr double kC = 0.19;
+  int scale = 0;
+  while ((1LL << scale) < vertices) {
+    ++scale;
+  }
+  const ppc::util::CounterRng rng(kGraphSeed, 1);
+  const auto num_arcs = static_cast<std::size_t>(vertices) * kArcsPerVertex;
+  std::vector<std::pair<int, int>> arcs(num_arcs);
+  for (std::size_t i = 0; i < num_arcs; ++i) {
+    std::int64_t from = 0;
+    std::int64_t to = 0;
+    for (int level = 0; level < scale; ++level) {
+      const double r = rng.Uniform((i * static_cast<std::size_t>(scale)) + static_cast<std::size_t>(level));
+      from = (from << 1) | static_cast<std::int64_t>(r >= kA + kB);
+      to = (to << 1) | static_cast<std::int64_t>((r >= kA && r < kA + kB) || r >= kA + kB + kC);
     }
-    int source = 0;
-    return std::make_tuple(source, offsets, edges, weights);
+    arcs[i] = {static_cast<int>(from % vertices), static_cast<int>(to % vertices)};
   }
+  std::vector<int> weights(num_arcs);
+  ppc::util::FillUniform(rng.Stream(2), std::span<int>(weights), 0, 1, 255);
+  return MakeCrsGraph(vertices, arcs, weights);
+}
 
-  InType input_data_;
+}  // namespace
+
+class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
+ protected:
+  virtual InType GenerateGraph(int vertices) = 0;
 
   void SetUp() override {
-    input_data_ = GenerateTestGraph();
+    input_data_ = GenerateGraph(static_cast<int>(GetProblemSize()));
   }
 
+  /// Checks the distances with an SSSP certificate instead of a reference run: the source is at 0, no edge can
+  /// shorten a distance, and every other reached vertex has an incoming edge that realises its distance.
   bool CheckTestOutputData(OutType &output_data) final {
     if (output_data.empty()) {
       return true;
     }
-    if (!output_data.empty()) {
-      if (output_data[0] != 0) {
-        return false;
+    const auto &[source, offsets, edges, weights] = input_data_;
+    const int vertices = static_cast<int>(offsets.size()) - 1;
+    if (std::cmp_not_equal(output_data.size(), vertices) || output_data[source] != 0) {
+      return false;
+    }
+    constexpr int kInf = std::numeric_limits<int>::max();
+    std::vector<bool> tight(vertices, false);
+    tight[source] = true;
+    for (int u = 0; u < vertices; ++u) {
+      if (output_data[u] == kInf) {
+        continue;
       }
-      for (int dist : output_data) {
-        if (dist < 0) {
+      for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+        const std::int64_t through_u = static_cast<std::int64_t>(output_data[u]) + weights[i];
+        if (through_u < output_data[edges[i]]) {
           return false;
         }
-      }
-      int reachable_count = 0;
-      for (int dist : output_data) {
-        if (dist < std::numeric_limits<int>::max()) {
-          reachable_count++;
+        if (through_u == output_data[edges[i]]) {
+          tight[edges[i]] = true;
         }
       }
-      if (reachable_count < kVertices_ / 2) {
+    }
+    for (int v = 0; v < vertices; ++v) {
+      if (output_data[v] != kInf && !tight[v]) {
         return false;
       }
     }
-
     return true;
   }
 
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  /// Traversed edges per second: every edge with its weight is read once, offsets and distances once per vertex.
+  ppc::performance::Workload GetWorkload(const InType &input) override {
+    const auto vertices = static_cast<double>(std::get<1>(input).size() - 1);
+    const auto arcs = static_cast<double>(std::get<2>(input).size());
+    return {.bytes = (8.0 * arcs) + (8.0 * vertices), .elements = arcs};
+  }
+
+ private:
+  InType input_data_;
+};
+
+class OlesnitskiyVDijkstraCrsRoadPerfTest : public OlesnitskiyVDijkstraCrsPerfTest {
+ protected:
+  InType GenerateGraph(int vertices) override {
+    return GenerateRoadGraph(vertices);
+  }
 };
 
-TEST_P(OlesnitskiyVDijkstraCrsPerfTest, RunPerfModes) {
+class OlesnitskiyVDijkstraCrsPowerLawPerfTest : public OlesnitskiyVDijkstraCrsPerfTest {
+ protected:
+  InType GenerateGraph(int vertices) override {
+    return GeneratePowerLawGraph(vertices);
+  }
+};
+
+TEST_P(OlesnitskiyVDijkstraCrsRoadPerfTest, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(OlesnitskiyVDijkstraCrsPowerLawPerfTest, RunPerfModes) {
   ExecuteTest(GetParam());
 }
 
-const auto kAllPerfTasks = ppc::util::MakeAllPerfTasks<InType, OlesnitskiyVDijkstraCrsMPI, OlesnitskiyVDijkstraCrsSEQ>(
-    PPC_SETTINGS_olesnitskiy_v_dijkstra_crs);
+const ppc::util::PerfSizes kRoadSizes = {1 << 20};
+const ppc::util::PerfSizes kPowerLawSizes = {1 << 18};
 
-const auto kGtestValues = ppc::util::TupleToGTestValues(kAllPerfTasks);
+const auto kRoadPerfTasks = ppc::util::MakeAllPerfTasks<InType, OlesnitskiyVDijkstraCrsMPI, OlesnitskiyVDijkstraCrsSEQ>(
+    PPC_SETTINGS_olesnitskiy_v_dijkstra_crs, kRoadSizes, "road");
+const auto kPowerLawPerfTasks =
+    ppc::util::MakeAllPerfTasks<InType, OlesnitskiyVDijkstraCrsMPI, OlesnitskiyVDijkstraCrsSEQ>(
+        PPC_SETTINGS_olesnitskiy_v_dijkstra_crs, kPowerLawSizes, "power_law");
 
 const auto kPerfTestName = OlesnitskiyVDijkstraCrsPerfTest::CustomPerfTestName;
 
-INSTANTIATE_TEST_SUITE_P(RunModeTests, OlesnitskiyVDijkstraCrsPerfTest, kGtestValues, kPerfTestName);
+INSTANTIATE_TEST_SUITE_P(RunModeTests, OlesnitskiyVDijkstraCrsRoadPerfTest,
+                         ppc::util::TupleToGTestValues(kRoadPerfTasks), kPerfTestName);
+INSTANTIATE_TEST_SUITE_P(RunModeTests, OlesnitskiyVDijkstraCrsPowerLawPerfTest,
+                         ppc::util::TupleToGTestValues(kPowerLawPerfTasks), kPerfTestName);
 
 }  // namespace olesnitskiy_v_dijkstra_crs
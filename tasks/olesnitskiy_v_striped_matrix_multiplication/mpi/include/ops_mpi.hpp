@@ -1,20 +1,33 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <vector>
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/node_shared.hpp"
 
 namespace olesnitskiy_v_striped_matrix_multiplication {
 
+/// @brief How OlesnitskiyVStripedMatrixMultiplicationMPI runs.
+struct StripedOptions {
+  /// Splits B into column panels: the broadcast of panel j + 1 (MPI_Ibcast) runs while panel j is multiplied, and
+  /// the finished columns of C go back to rank 0 with MPI_Igatherv while the next panel is multiplied.
+  bool pipelined = false;
+  /// Columns of B in one panel of the pipelined mode.
+  std::size_t panel_cols = 256;
+  /// Whether every rank gets the whole C; otherwise only rank 0 has it and the other ranks return an empty matrix.
+  bool broadcast_result = true;
+};
+
 class OlesnitskiyVStripedMatrixMultiplicationMPI : public ppc::task::Task<InType, OutType> {
  public:
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
 
-  explicit OlesnitskiyVStripedMatrixMultiplicationMPI(const InType &in);
+  explicit OlesnitskiyVStripedMatrixMultiplicationMPI(const InType &in, StripedOptions options = {});
 
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
@@ -28,6 +41,7 @@ class OlesnitskiyVStripedMatrixMultiplicationMPI : public ppc::task::Task<InType
   bool ScatterData();
   bool BroadcastMatrixB();
   bool ComputeLocalC();
+  bool RunPipelined();
   bool GatherResults();
   bool BroadcastResults();
   bool SetOutput();
@@ -39,7 +53,8 @@ class OlesnitskiyVStripedMatrixMultiplicationMPI : public ppc::task::Task<InType
   void MultiplyRow(size_t row_start, size_t row_end);
   void MultiplySingleProcessMatrix();
   std::vector<double> local_a_;
-  std::vector<double> local_b_;
+  ppc::util::NodeSharedBuffer shared_b_;
+  std::span<const double> local_b_;
   std::vector<double> local_c_;
   int rows_a_local_{0};
   std::vector<int> sendcounts_a_;
@@ -63,6 +78,14 @@ class OlesnitskiyVStripedMatrixMultiplicationMPI : public ppc::task::Task<InType
 
   int rank_{-1};
   int world_size_{-1};
+  StripedOptions options_;
+};
+
+/// @brief The pipelined mode of OlesnitskiyVStripedMatrixMultiplicationMPI, as a task of its own for the tests.
+class OlesnitskiyVStripedMatrixMultiplicationPipelinedMPI : public OlesnitskiyVStripedMatrixMultiplicationMPI {
+ public:
+  explicit OlesnitskiyVStripedMatrixMultiplicationPipelinedMPI(const InType &in)
+      : OlesnitskiyVStripedMatrixMultiplicationMPI(in, {.pipelined = true}) {}
 };
 
 }  // namespace olesnitskiy_v_striped_matrix_multiplication
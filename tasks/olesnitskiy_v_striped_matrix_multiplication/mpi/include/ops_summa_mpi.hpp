@@ -0,0 +1,28 @@
+#pragma once
+
+#include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
+#include "task/include/task.hpp"
+
+namespace olesnitskiy_v_striped_matrix_multiplication {
+
+/// @brief The product on a 2D process grid (ppc::collective::SummaMultiply) instead of row stripes: every rank
+/// receives blocks of both A and B rather than all of B, so the communication volume shrinks as the grid grows.
+/// Only rank 0 gets the product; the output of the other ranks is empty.
+class OlesnitskiyVStripedMatrixMultiplicationSummaMPI : public ppc::task::Task<InType, OutType> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  explicit OlesnitskiyVStripedMatrixMultiplicationSummaMPI(const InType &in);
+
+  bool ValidationImpl() override;
+  bool PreProcessingImpl() override;
+  bool RunImpl() override;
+  bool PostProcessingImpl() override;
+
+ private:
+  int rank_{-1};
+};
+
+}  // namespace olesnitskiy_v_striped_matrix_multiplication
@@ -2,16 +2,65 @@
 
 #include <mpi.h>
 
+#include <array>
 #include <cstddef>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
+#include "util/include/gemm.hpp"
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/node_shared.hpp"
 
 namespace olesnitskiy_v_striped_matrix_multiplication {
 
-OlesnitskiyVStripedMatrixMultiplicationMPI::OlesnitskiyVStripedMatrixMultiplicationMPI(const InType &in) {
+namespace {
+
+/// Columns [begin, end) of B while they are broadcast from rank 0; rank 0 multiplies straight from B.
+struct BPanel {
+  std::vector<double> buffer;
+  ppc::util::MpiDatatype type;
+  MPI_Request request = MPI_REQUEST_NULL;
+  const double *data = nullptr;
+  size_t ld = 0;
+};
+
+void PostBPanel(std::vector<double> &data_b, size_t rows_b, size_t cols_b, size_t begin, size_t end, int rank,
+                BPanel &panel) {
+  const size_t width = end - begin;
+  if (rank == 0) {
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    MPI_Type_vector(static_cast<int>(rows_b), static_cast<int>(width), static_cast<int>(cols_b), MPI_DOUBLE, &type);
+    panel.type = ppc::util::MpiDatatype(type);
+    panel.data = data_b.data() + begin;
+    panel.ld = cols_b;
+    MPI_Ibcast(data_b.data() + begin, 1, panel.type.Get(), 0, MPI_COMM_WORLD, &panel.request);
+  } else {
+    panel.buffer.resize(rows_b * width);
+    panel.data = panel.buffer.data();
+    panel.ld = width;
+    MPI_Ibcast(panel.buffer.data(), static_cast<int>(panel.buffer.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD,
+               &panel.request);
+  }
+}
+
+/// `width` consecutive elements of a row, with the extent of a whole row of `cols` elements, so that a count of
+/// rows of it describes a column block of a row-major matrix.
+ppc::util::MpiDatatype RowSegmentType(size_t width, size_t cols) {
+  MPI_Datatype segment = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(static_cast<int>(width), MPI_DOUBLE, &segment);
+  MPI_Datatype row = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(segment, 0, static_cast<MPI_Aint>(cols * sizeof(double)), &row);
+  MPI_Type_free(&segment);
+  return ppc::util::MpiDatatype(row);
+}
+
+}  // namespace
+
+OlesnitskiyVStripedMatrixMultiplicationMPI::OlesnitskiyVStripedMatrixMultiplicationMPI(const InType &in,
+                                                                                       StripedOptions options)
+    : options_(options) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
   GetOutput() = {0UL, 0UL, std::vector<double>()};
@@ -55,7 +104,7 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::ValidationImpl() {
     return false;
   }
 
-  if (cols_a != rows_b) {
+  if (cols_a != rows_b || options_.panel_cols == 0) {
     return false;
   }
   return true;
@@ -114,28 +163,15 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::ScatterData() {
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::BroadcastMatrixB() {
-  if (rows_b_ > 0 && cols_b_ > 0) {
-    local_b_.resize(rows_b_ * cols_b_);
-    if (rank_ == 0) {
-      local_b_ = data_b_;
-    }
-    MPI_Bcast(local_b_.data(), static_cast<int>(local_b_.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
-  } else {
-    local_b_.clear();
-  }
+  // With PPC_SHARED_INPUT=1 the ranks of a node read one shared copy of B instead of receiving their own
+  shared_b_ = ppc::util::NodeSharedBuffer::FromRoot(data_b_);
+  local_b_ = shared_b_.View<double>();
   return true;
 }
 
 void OlesnitskiyVStripedMatrixMultiplicationMPI::MultiplyRow(size_t row_start, size_t row_end) {
-  for (size_t local_row = row_start; local_row < row_end; ++local_row) {
-    for (size_t col = 0; col < cols_c_; ++col) {
-      double sum = 0.0;
-      for (size_t k = 0; k < cols_a_; ++k) {
-        sum += local_a_[(local_row * cols_a_) + k] * local_b_[(k * cols_b_) + col];
-      }
-      local_c_[(local_row * cols_c_) + col] = sum;
-    }
-  }
+  ppc::util::Gemm(row_end - row_start, cols_c_, cols_a_, local_a_.data() + (row_start * cols_a_), cols_a_,
+                  local_b_.data(), cols_b_, local_c_.data() + (row_start * cols_c_), cols_c_);
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::ComputeLocalC() {
@@ -218,6 +254,10 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::ReceiveResultsFromRoot() {
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::BroadcastResults() {
+  if (!options_.broadcast_result) {
+    return SetOutput();
+  }
+
   if (rank_ == 0) {
     return BroadcastResultsFromRoot();
   }
@@ -245,6 +285,10 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::RunImpl() {
     return false;
   }
 
+  if (options_.pipelined) {
+    return RunPipelined() && BroadcastResults();
+  }
+
   if (!BroadcastMatrixB()) {
     return false;
   }
@@ -265,16 +309,47 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::RunImpl() {
   return true;
 }
 
-void OlesnitskiyVStripedMatrixMultiplicationMPI::MultiplySingleProcessMatrix() {
-  for (size_t i = 0; i < rows_a_; ++i) {
-    for (size_t j = 0; j < cols_b_; ++j) {
-      double sum = 0.0;
-      for (size_t k = 0; k < cols_a_; ++k) {
-        sum += data_a_[(i * cols_a_) + k] * data_b_[(k * cols_b_) + j];
-      }
-      result_c_[(i * cols_c_) + j] = sum;
+bool OlesnitskiyVStripedMatrixMultiplicationMPI::RunPipelined() {
+  const size_t local_rows = static_cast<size_t>(rows_a_local_);
+  local_c_.assign(local_rows * cols_c_, 0.0);
+  if (rank_ == 0) {
+    result_c_.assign(rows_c_ * cols_c_, 0.0);
+  }
+
+  std::vector<size_t> panels;
+  for (size_t begin = 0; begin < cols_b_; begin += options_.panel_cols) {
+    panels.push_back(begin);
+  }
+  panels.push_back(cols_b_);
+  const size_t num_panels = panels.size() - 1;
+
+  // Two panels of B in flight: the broadcast of panel j + 1 runs while panel j is multiplied
+  std::array<BPanel, 2> b_panels;
+  std::vector<ppc::util::MpiDatatype> c_types;
+  std::vector<MPI_Request> c_requests(num_panels, MPI_REQUEST_NULL);
+  PostBPanel(data_b_, cols_a_, cols_b_, panels[0], panels[1], rank_, b_panels[0]);
+  for (size_t j = 0; j < num_panels; ++j) {
+    if (j + 1 < num_panels) {
+      PostBPanel(data_b_, cols_a_, cols_b_, panels[j + 1], panels[j + 2], rank_, b_panels[(j + 1) % 2]);
     }
+    BPanel &panel = b_panels[j % 2];
+    MPI_Wait(&panel.request, MPI_STATUS_IGNORE);
+    const size_t width = panels[j + 1] - panels[j];
+    ppc::util::Gemm(local_rows, width, cols_a_, local_a_.data(), cols_a_, panel.data, panel.ld,
+                    local_c_.data() + panels[j], cols_c_);
+
+    // The columns of this panel are final: send them to rank 0 while the next panel is multiplied
+    const auto &row_type = c_types.emplace_back(RowSegmentType(width, cols_c_));
+    MPI_Igatherv(local_c_.data() + panels[j], rows_a_local_, row_type.Get(),
+                 rank_ == 0 ? result_c_.data() + panels[j] : nullptr, row_counts_.data(), row_displs_.data(),
+                 row_type.Get(), 0, MPI_COMM_WORLD, &c_requests[j]);
   }
+  MPI_Waitall(static_cast<int>(c_requests.size()), c_requests.data(), MPI_STATUSES_IGNORE);
+  return true;
+}
+
+void OlesnitskiyVStripedMatrixMultiplicationMPI::MultiplySingleProcessMatrix() {
+  ppc::util::Gemm(rows_a_, cols_b_, cols_a_, data_a_, data_b_, result_c_);
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::ComputeSingleProcess() {
@@ -291,18 +366,12 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::ComputeSingleProcess() {
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::RunOnSingleProcess() {
-  if (rank_ == 0) {
-    if (!ComputeSingleProcess()) {
-      return false;
-    }
+  if (rank_ == 0 && !ComputeSingleProcess()) {
+    return false;
+  }
 
-    if (!BroadcastResultsFromRoot()) {
-      return false;
-    }
-  } else {
-    if (!ReceiveResultsFromRoot()) {
-      return false;
-    }
+  if (!BroadcastResults()) {
+    return false;
   }
 
   MPI_Barrier(MPI_COMM_WORLD);
@@ -0,0 +1,50 @@
+#include "olesnitskiy_v_striped_matrix_multiplication/mpi/include/ops_summa_mpi.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "collective/include/summa.hpp"
+#include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
+
+namespace olesnitskiy_v_striped_matrix_multiplication {
+
+OlesnitskiyVStripedMatrixMultiplicationSummaMPI::OlesnitskiyVStripedMatrixMultiplicationSummaMPI(const InType &in) {
+  SetTypeOfTask(GetStaticTypeOfTask());
+  GetInput() = in;
+  GetOutput() = {0UL, 0UL, std::vector<double>()};
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+}
+
+bool OlesnitskiyVStripedMatrixMultiplicationSummaMPI::ValidationImpl() {
+  const auto &[rows_a, cols_a, data_a, rows_b, cols_b, data_b] = GetInput();
+  if (rows_a == 0 || cols_a == 0 || rows_b == 0 || cols_b == 0) {
+    return false;
+  }
+  return data_a.size() == rows_a * cols_a && data_b.size() == rows_b * cols_b && cols_a == rows_b;
+}
+
+bool OlesnitskiyVStripedMatrixMultiplicationSummaMPI::PreProcessingImpl() {
+  return true;
+}
+
+bool OlesnitskiyVStripedMatrixMultiplicationSummaMPI::RunImpl() {
+  const auto &[rows_a, cols_a, data_a, rows_b, cols_b, data_b] = GetInput();
+  auto result = ppc::collective::SummaMultiply(rows_a, cols_b, cols_a, data_a, data_b);
+
+  // The product stays on rank 0; broadcasting m x n values would cost more than the multiplication saves
+  if (rank_ == 0) {
+    GetOutput() = {rows_a, cols_b, std::move(result)};
+  } else {
+    GetOutput() = {0UL, 0UL, std::vector<double>()};
+  }
+  return true;
+}
+
+bool OlesnitskiyVStripedMatrixMultiplicationSummaMPI::PostProcessingImpl() {
+  return true;
+}
+
+}  // namespace olesnitskiy_v_striped_matrix_multiplication
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
+#include "util/include/gemm.hpp"
 
 namespace olesnitskiy_v_striped_matrix_multiplication {
 
@@ -92,15 +93,7 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::RunImpl() {
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationSEQ::MultiplySimple() {
-  for (size_t i = 0; i < rows_a_; ++i) {
-    for (size_t j = 0; j < cols_b_; ++j) {
-      double sum = 0.0;
-      for (size_t k = 0; k < cols_a_; ++k) {
-        sum += data_a_[(i * cols_a_) + k] * data_b_[(k * cols_b_) + j];
-      }
-      result_c_[(i * cols_b_) + j] = sum;
-    }
-  }
+  ppc::util::Gemm(rows_a_, cols_b_, cols_a_, data_a_, data_b_, result_c_);
   return true;
 }
 
@@ -108,19 +101,9 @@ bool OlesnitskiyVStripedMatrixMultiplicationSEQ::ProcessStripePair(int stripe_a,
                                                                    size_t cols_per_stripe) {
   const size_t start_row_a = static_cast<size_t>(stripe_a) * rows_per_stripe;
   const size_t start_col_b = static_cast<size_t>(stripe_b) * cols_per_stripe;
-
-  for (size_t i = 0; i < rows_per_stripe; ++i) {
-    const size_t row_idx = start_row_a + i;
-    for (size_t j = 0; j < cols_per_stripe; ++j) {
-      const size_t col_idx = start_col_b + j;
-      double sum = 0.0;
-
-      for (size_t k = 0; k < cols_a_; ++k) {
-        sum += data_a_[(row_idx * cols_a_) + k] * data_b_[(k * cols_b_) + col_idx];
-      }
-      result_c_[(row_idx * cols_b_) + col_idx] = sum;
-    }
-  }
+  ppc::util::Gemm(rows_per_stripe, cols_per_stripe, cols_a_, data_a_.data() + (start_row_a * cols_a_), cols_a_,
+                  data_b_.data() + start_col_b, cols_b_, result_c_.data() + (start_row_a * cols_b_) + start_col_b,
+                  cols_b_);
   return true;
 }
 
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <array>
 #include <cmath>
@@ -10,6 +11,7 @@
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
 #include "olesnitskiy_v_striped_matrix_multiplication/mpi/include/ops_mpi.hpp"
+#include "olesnitskiy_v_striped_matrix_multiplication/mpi/include/ops_summa_mpi.hpp"
 #include "olesnitskiy_v_striped_matrix_multiplication/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
@@ -28,7 +30,7 @@ class OlesnitskiyVStripedMatrixMultiplicationFuncTests : public ppc::util::BaseR
     input_data_ = std::get<0>(params);
   }
 
-  bool CheckTestOutputData(OutType &output_data) final {
+  bool CheckTestOutputData(OutType &output_data) override {
     TestType params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
     const auto &expected_output = std::get<1>(params);
 
@@ -57,12 +59,30 @@ class OlesnitskiyVStripedMatrixMultiplicationFuncTests : public ppc::util::BaseR
   InType input_data_;
 };
 
+/// @brief The same cases for the tasks that return the product on rank 0 only.
+class OlesnitskiyVStripedMatrixMultiplicationRootOutputFuncTests
+    : public OlesnitskiyVStripedMatrixMultiplicationFuncTests {
+ protected:
+  bool CheckTestOutputData(OutType &output_data) final {
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) {
+      return std::get<2>(output_data).empty();
+    }
+    return OlesnitskiyVStripedMatrixMultiplicationFuncTests::CheckTestOutputData(output_data);
+  }
+};
+
 namespace {
 
 TEST_P(OlesnitskiyVStripedMatrixMultiplicationFuncTests, MatrixMultiplication) {
   ExecuteTest(GetParam());
 }
 
+TEST_P(OlesnitskiyVStripedMatrixMultiplicationRootOutputFuncTests, MatrixMultiplication) {
+  ExecuteTest(GetParam());
+}
+
 std::vector<double> CreateMatrix(size_t rows, size_t cols, double start_value = 1.0) {
   std::vector<double> matrix(rows * cols);
   for (size_t i = 0; i < rows; ++i) {
@@ -182,6 +202,74 @@ const auto kPerfTestName = OlesnitskiyVStripedMatrixMultiplicationFuncTests::Pri
 INSTANTIATE_TEST_SUITE_P(MatrixMultiplicationTests, OlesnitskiyVStripedMatrixMultiplicationFuncTests, kGtestValues,
                          kPerfTestName);
 
+// The 2D grid and pipelined versions share the task type with the striped one, so their cases get their own prefix
+const auto kSummaTasksList = ppc::util::AddFuncTask<OlesnitskiyVStripedMatrixMultiplicationSummaMPI, InType>(
+    kTestParam, PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication);
+
+INSTANTIATE_TEST_SUITE_P(SummaMatrixMultiplicationTests, OlesnitskiyVStripedMatrixMultiplicationRootOutputFuncTests,
+                         ppc::util::ExpandToValues(kSummaTasksList),
+                         OlesnitskiyVStripedMatrixMultiplicationRootOutputFuncTests::PrintFuncTestName<
+                             OlesnitskiyVStripedMatrixMultiplicationRootOutputFuncTests>);
+
+const auto kPipelinedTasksList = ppc::util::AddFuncTask<OlesnitskiyVStripedMatrixMultiplicationPipelinedMPI, InType>(
+    kTestParam, PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication);
+
+INSTANTIATE_TEST_SUITE_P(PipelinedMatrixMultiplicationTests, OlesnitskiyVStripedMatrixMultiplicationFuncTests,
+                         ppc::util::ExpandToValues(kPipelinedTasksList), kPerfTestName);
+
+OutType RunStriped(const InType &input, StripedOptions options) {
+  OlesnitskiyVStripedMatrixMultiplicationMPI task(input, options);
+  EXPECT_TRUE(task.Validation());
+  EXPECT_TRUE(task.PreProcessing());
+  EXPECT_TRUE(task.Run());
+  EXPECT_TRUE(task.PostProcessing());
+  return task.GetOutput();
+}
+
+TEST(OlesnitskiyVStripedMatrixMultiplicationOptions, PipelinedPanelsMatchProduct) {
+  if (!ppc::util::IsUnderMpirun()) {
+    GTEST_SKIP();
+  }
+  // 3-column panels with a narrower last one
+  const auto a = CreateMatrix(11, 6, 0.5);
+  const auto b = CreateMatrix(6, 8, -1.0);
+  const auto expected = MultiplyMatrices(a, 11, 6, b, 6, 8);
+  const auto [rows, cols, data] = RunStriped(std::make_tuple(11UL, 6UL, a, 6UL, 8UL, b),
+                                             {.pipelined = true, .panel_cols = 3});
+  EXPECT_EQ(rows, 11UL);
+  EXPECT_EQ(cols, 8UL);
+  ASSERT_EQ(data.size(), expected.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    EXPECT_NEAR(data[i], expected[i], 1e-9);
+  }
+}
+
+TEST(OlesnitskiyVStripedMatrixMultiplicationOptions, ResultCanStayOnRoot) {
+  if (!ppc::util::IsUnderMpirun()) {
+    GTEST_SKIP();
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  const auto a = CreateMatrix(9, 4, 1.0);
+  const auto b = CreateMatrix(4, 5, 2.0);
+  const auto expected = MultiplyMatrices(a, 9, 4, b, 4, 5);
+  for (bool pipelined : {false, true}) {
+    const auto [rows, cols, data] = RunStriped(std::make_tuple(9UL, 4UL, a, 4UL, 5UL, b),
+                                               {.pipelined = pipelined, .panel_cols = 2, .broadcast_result = false});
+    if (rank == 0) {
+      EXPECT_EQ(rows, 9UL);
+      ASSERT_EQ(data.size(), expected.size());
+      for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_NEAR(data[i], expected[i], 1e-9);
+      }
+    } else {
+      EXPECT_EQ(rows, 0UL);
+      EXPECT_EQ(cols, 0UL);
+      EXPECT_TRUE(data.empty());
+    }
+  }
+}
+
 }  // namespace
 
 }  // namespace olesnitskiy_v_striped_matrix_multiplication
@@ -7,11 +7,28 @@
 
 #include "olesnitskiy_v_striped_matrix_multiplication/common/include/common.hpp"
 #include "olesnitskiy_v_striped_matrix_multiplication/mpi/include/ops_mpi.hpp"
+#include "olesnitskiy_v_striped_matrix_multiplication/mpi/include/ops_summa_mpi.hpp"
 #include "olesnitskiy_v_striped_matrix_multiplication/seq/include/ops_seq.hpp"
+#include "performance/include/roofline.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace olesnitskiy_v_striped_matrix_multiplication {
 
+// The SUMMA version leaves the product on rank 0, so the striped versions are also measured without the final
+// broadcast to compare them on equal terms
+class OlesnitskiyVStripedMatrixMultiplicationRootOutputMPI : public OlesnitskiyVStripedMatrixMultiplicationMPI {
+ public:
+  explicit OlesnitskiyVStripedMatrixMultiplicationRootOutputMPI(const InType &in)
+      : OlesnitskiyVStripedMatrixMultiplicationMPI(in, {.broadcast_result = false}) {}
+};
+
+class OlesnitskiyVStripedMatrixMultiplicationPipelinedRootOutputMPI
+    : public OlesnitskiyVStripedMatrixMultiplicationMPI {
+ public:
+  explicit OlesnitskiyVStripedMatrixMultiplicationPipelinedRootOutputMPI(const InType &in)
+      : OlesnitskiyVStripedMatrixMultiplicationMPI(in, {.pipelined = true, .broadcast_result = false}) {}
+};
+
 class OlesnitskiyVStripedMatrixMultiplicationPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
   InType input_data_;
 
@@ -39,20 +56,43 @@ class OlesnitskiyVStripedMatrixMultiplicationPerfTests : public ppc::util::BaseR
 
   bool CheckTestOutputData(OutType &output_data) final {
     const auto &[out_rows, out_cols, out_data] = output_data;
+    if (ppc::util::GetMPIRank() != 0) {
+      return true;
+    }
     return !out_data.empty() && out_rows == 1024 && out_cols == 1024;
   }
 
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  // 2 * n * k * m operations; at least A and B are read and C is written once
+  ppc::performance::Workload GetWorkload(const InType &input) final {
+    const auto &[rows_a, cols_a, matrix_a, rows_b, cols_b, matrix_b] = input;
+    const auto n = static_cast<double>(rows_a);
+    const auto k = static_cast<double>(cols_a);
+    const auto m = static_cast<double>(cols_b);
+    return {.bytes = ((n * k) + (k * m) + (n * m)) * sizeof(double), .flops = 2.0 * n * k * m, .elements = n * m};
+  }
 };
 
 TEST_P(OlesnitskiyVStripedMatrixMultiplicationPerfTests, RunPerfModes) {
   ExecuteTest(GetParam());
 }
-const auto kAllPerfTasks = ppc::util::MakeAllPerfTasks<InType, OlesnitskiyVStripedMatrixMultiplicationMPI,
-                                                       OlesnitskiyVStripedMatrixMultiplicationSEQ>(
-    PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication);
+// The pipelined and SUMMA cases run next to the striped ones; compare their time and the comm_bytes of their _ranks
+// lines
+const auto kAllPerfTasks = std::tuple_cat(
+    ppc::util::MakeAllPerfTasks<InType, OlesnitskiyVStripedMatrixMultiplicationMPI,
+                                OlesnitskiyVStripedMatrixMultiplicationSEQ>(
+        PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication),
+    ppc::util::MakePerfTaskTuples<OlesnitskiyVStripedMatrixMultiplicationPipelinedMPI, InType>(
+        PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication, 0, "pipelined"),
+    ppc::util::MakePerfTaskTuples<OlesnitskiyVStripedMatrixMultiplicationRootOutputMPI, InType>(
+        PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication, 0, "root_output"),
+    ppc::util::MakePerfTaskTuples<OlesnitskiyVStripedMatrixMultiplicationPipelinedRootOutputMPI, InType>(
+        PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication, 0, "pipelined_root_output"),
+    ppc::util::MakePerfTaskTuples<OlesnitskiyVStripedMatrixMultiplicationSummaMPI, InType>(
+        PPC_SETTINGS_olesnitskiy_v_striped_matrix_multiplication, 0, "summa"));
 const auto kGtestValues = ppc::util::TupleToGTestValues(kAllPerfTasks);
 const auto kPerfTestName = OlesnitskiyVStripedMatrixMultiplicationPerfTests::CustomPerfTestName;
 INSTANTIATE_TEST_SUITE_P(RunModeTests, OlesnitskiyVStripedMatrixMultiplicationPerfTests, kGtestValues, kPerfTestName);
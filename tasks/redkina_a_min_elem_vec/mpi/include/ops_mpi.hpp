@@ -10,7 +10,7 @@ class RedkinaAMinElemVecMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit RedkinaAMinElemVecMPI(const InType &in);
+  explicit RedkinaAMinElemVecMPI(InType in);
 
  private:
   bool ValidationImpl() override;
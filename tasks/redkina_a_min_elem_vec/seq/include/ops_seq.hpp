@@ -10,7 +10,7 @@ class RedkinaAMinElemVecSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit RedkinaAMinElemVecSEQ(const InType &in);
+  explicit RedkinaAMinElemVecSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
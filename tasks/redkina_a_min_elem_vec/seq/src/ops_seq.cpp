@@ -2,15 +2,16 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "redkina_a_min_elem_vec/common/include/common.hpp"
 
 namespace redkina_a_min_elem_vec {
 
-RedkinaAMinElemVecSEQ::RedkinaAMinElemVecSEQ(const InType &in) {
+RedkinaAMinElemVecSEQ::RedkinaAMinElemVecSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -1,29 +1,27 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
-#include <random>
+#include <cstdint>
+#include <span>
 
 #include "redkina_a_min_elem_vec/common/include/common.hpp"
 #include "redkina_a_min_elem_vec/mpi/include/ops_mpi.hpp"
 #include "redkina_a_min_elem_vec/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace redkina_a_min_elem_vec {
 
 class RedkinaAMinElemVecRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  public:
   static constexpr size_t kSize = 100000000;
+  static constexpr uint64_t kSeed = 1;
 
  protected:
   void SetUp() override {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> rand(-1000, 1000);
-
+    // Counter-based generator: reproducible input, filled by all OpenMP threads
     input_vec_.resize(kSize);
-    for (size_t i = 0; i < kSize; i++) {
-      input_vec_[i] = rand(gen);
-    }
+    ppc::util::FillUniform(ppc::util::CounterRng(kSeed), std::span(input_vec_), 0, -1000, 1000);
 
     expected_res_ = -2000;
     input_vec_[kSize / 2] = expected_res_;
@@ -3,9 +3,11 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <vector>
 
 #include "safronov_m_bubble_sort_odd_even/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace safronov_m_bubble_sort_odd_even {
 
@@ -36,22 +38,10 @@ void SafronovMBubbleSortOddEvenMPI::SendingVector(int rank) {
 }
 
 std::vector<int> SafronovMBubbleSortOddEvenMPI::CalculatingInterval(int size_prcs, int rank, int size_arr) {
-  std::vector<int> vec(2);
-  int whole_part = size_arr / size_prcs;
-  int real_part = size_arr % size_prcs;
-  int start = rank * whole_part;
-  if ((rank - 1 < real_part) && (rank - 1 != -1)) {
-    start += rank;
-  } else if (rank != 0) {
-    start += real_part;
-  }
-  int end = start + whole_part - 1;
-  if (rank < real_part) {
-    end += 1;
-  }
-  vec[0] = start;
-  vec[1] = end;
-  return vec;
+  // Inclusive interval [start, end]; an empty block has end = start - 1
+  const ppc::util::BlockPartition partition(static_cast<std::size_t>(size_arr), size_prcs);
+  const auto start = static_cast<int>(partition.Begin(rank));
+  return {start, start + static_cast<int>(partition.Count(rank)) - 1};
 }
 
 void SafronovMBubbleSortOddEvenMPI::OddEvenBubble(std::vector<int> &own_data, int own_size, int begin, int phase) {
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "safronov_m_sum_values_matrix/common/include/common.hpp"
+#include "util/include/partition.hpp"
 
 namespace safronov_m_sum_values_matrix {
 
@@ -45,22 +46,10 @@ std::vector<double> SafronovMSumValuesMatrixMPI::SummValues(const int start, con
 }
 
 std::vector<int> SafronovMSumValuesMatrixMPI::CalculatingInterval(int size_prcs, int rank, int count_column) {
-  std::vector<int> vec(2);
-  int whole_part = count_column / size_prcs;
-  int real_part = count_column % size_prcs;
-  int start = rank * whole_part;
-  if ((rank - 1 < real_part) && (rank - 1 != -1)) {
-    start += rank;
-  } else if (rank != 0) {
-    start += real_part;
-  }
-  int end = start + whole_part - 1;
-  if (rank < real_part) {
-    end += 1;
-  }
-  vec[0] = start;
-  vec[1] = end;
-  return vec;
+  // Inclusive interval [start, end]; an empty block has end = start - 1
+  const ppc::util::BlockPartition partition(static_cast<std::size_t>(count_column), size_prcs);
+  const auto start = static_cast<int>(partition.Begin(rank));
+  return {start, start + static_cast<int>(partition.Count(rank)) - 1};
 }
 
 std::vector<double> SafronovMSumValuesMatrixMPI::ConversionToVector(int rows, int cols, int rank) {
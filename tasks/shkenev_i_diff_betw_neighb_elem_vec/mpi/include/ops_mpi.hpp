@@ -10,7 +10,7 @@ class ShkenevIDiffBetwNeighbElemVecMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ShkenevIDiffBetwNeighbElemVecMPI(const InType &in);
+  explicit ShkenevIDiffBetwNeighbElemVecMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -10,7 +10,7 @@ class ShkenevIDiffBetwNeighbElemVecSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ShkenevIDiffBetwNeighbElemVecSEQ(const InType &in);
+  explicit ShkenevIDiffBetwNeighbElemVecSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,12 +2,14 @@
 
 #include <algorithm>
 #include <cmath>
-#include <random>
+#include <cstdint>
+#include <span>
 
 #include "shkenev_i_diff_betw_neighb_elem_vec/common/include/common.hpp"
 #include "shkenev_i_diff_betw_neighb_elem_vec/mpi/include/ops_mpi.hpp"
 #include "shkenev_i_diff_betw_neighb_elem_vec/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace shkenev_i_diff_betw_neighb_elem_vec {
 
@@ -15,20 +17,15 @@ class ShkenevIDiffBetwNeighbElemVecPerfTests : public ppc::util::BaseRunPerfTest
  protected:
   void SetUp() override {
     const int k_vector_size = 200000000;
+    const uint64_t k_seed = 1;
 
     input_data_.resize(k_vector_size);
 
-    std::random_device random;
-    std::mt19937 gen(random());
-    std::uniform_int_distribution<int> small_dist(0, 100);
-    std::uniform_int_distribution<int> large_dist(1000, 10000);
-
+    // One counter-based fill (all OpenMP threads) for both ranges: even elements are scaled down to [0, 100], odd
+    // ones shifted to [1000, 10000]
+    ppc::util::FillUniform(ppc::util::CounterRng(k_seed), std::span(input_data_), 0, 0, 9000);
     for (int i = 0; i < k_vector_size; i++) {
-      if (i % 2 == 0) {
-        input_data_[i] = small_dist(gen);
-      } else {
-        input_data_[i] = large_dist(gen);
-      }
+      input_data_[i] = (i % 2 == 0) ? input_data_[i] / 90 : input_data_[i] + 1000;
     }
 
     expected_max_diff_ = 0;
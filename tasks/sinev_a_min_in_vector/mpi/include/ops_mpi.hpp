@@ -10,7 +10,7 @@ class SinevAMinInVectorMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit SinevAMinInVectorMPI(const InType &in);
+  explicit SinevAMinInVectorMPI(InType in);
 
  private:
   bool ValidationImpl() override;
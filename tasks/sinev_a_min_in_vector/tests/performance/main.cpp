@@ -1,15 +1,19 @@
 #include <gtest/gtest.h>
 
-#include <random>
+#include <cstdint>
+#include <span>
+
 
 #include "sinev_a_min_in_vector/common/include/common.hpp"
 #include "sinev_a_min_in_vector/mpi/include/ops_mpi.hpp"
 #include "sinev_a_min_in_vector/seq/include/ops_seq.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace sinev_a_min_in_vector {
 
 class SinevAMinInVectorPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  const uint64_t kSeed_ = 1;
   int real_min_{};
   InType input_data_;
 
@@ -17,14 +21,8 @@ class SinevAMinInVectorPerfTests : public ppc::util::BaseRunPerfTests<InType, Ou
     int size = 100000000;
     input_data_.resize(size);
 
-    // Заполняем сложными данными
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dist(1, 1000000);
-
-    for (int i = 0; i < size; i++) {
-      input_data_[i] = dist(gen);
-    }
+    // Counter-based generator: reproducible input, filled by all OpenMP threads
+    ppc::util::FillUniform(ppc::util::CounterRng(kSeed_), std::span(input_data_), 0, 1, 1000000);
 
     // Добавляем явный минимум
     input_data_[size / 2] = -1000;
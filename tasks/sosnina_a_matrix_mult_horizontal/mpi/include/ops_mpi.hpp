@@ -1,9 +1,12 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/node_shared.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
@@ -13,7 +16,9 @@ class SosninaAMatrixMultHorizontalMPI : public BaseTask {
     return ppc::task::TypeOfTask::kMPI;
   }
 
-  explicit SosninaAMatrixMultHorizontalMPI(const InType &in);
+  /// @param broadcast_result Whether every rank gets the product; otherwise only rank 0 does and the output of the
+  /// other ranks stays empty.
+  explicit SosninaAMatrixMultHorizontalMPI(const InType &in, bool broadcast_result = true);
 
  private:
   bool ValidationImpl() override;
@@ -23,10 +28,10 @@ class SosninaAMatrixMultHorizontalMPI : public BaseTask {
   bool RunSequential();
 
   bool PrepareAndValidateSizes(int &rows_a, int &cols_a, int &rows_b, int &cols_b);
-  void PrepareAndBroadcastMatrixB(std::vector<double> &b_flat, int rows_b, int cols_b);
+  [[nodiscard]] ppc::util::NodeSharedBuffer PrepareAndBroadcastMatrixB() const;
   void DistributeMatrixAData(std::vector<int> &my_row_indices, std::vector<double> &local_a_flat, int &local_rows,
                              int rows_a, int cols_a);
-  static void ComputeLocalMultiplication(const std::vector<double> &local_a_flat, const std::vector<double> &b_flat,
+  static void ComputeLocalMultiplication(const std::vector<double> &local_a_flat, std::span<const double> b_flat,
                                          std::vector<double> &local_result_flat, int local_rows, int cols_a,
                                          int cols_b);
   void GatherResults(std::vector<double> &final_result_flat, const std::vector<int> &my_row_indices,
@@ -45,11 +50,12 @@ class SosninaAMatrixMultHorizontalMPI : public BaseTask {
 
   void ConvertToMatrix(const std::vector<double> &final_result_flat, int rows_a, int cols_b);
 
-  std::vector<std::vector<double>> matrix_A_;
-  std::vector<std::vector<double>> matrix_B_;
+  ppc::util::Matrix<double> matrix_A_;
+  ppc::util::Matrix<double> matrix_B_;
   std::vector<std::vector<double>> result_matrix_;
   int rank_ = 0;
   int world_size_ = 1;
+  bool broadcast_result_ = true;
 };
 
 }  // namespace sosnina_a_matrix_mult_horizontal
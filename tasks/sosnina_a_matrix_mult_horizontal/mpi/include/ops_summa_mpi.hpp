@@ -0,0 +1,31 @@
+#pragma once
+
+#include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
+#include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
+
+namespace sosnina_a_matrix_mult_horizontal {
+
+/// @brief The product on a 2D process grid (ppc::collective::SummaMultiply) instead of cyclic row stripes; the
+/// matrices are only read on rank 0, like in SosninaAMatrixMultHorizontalMPI. Only rank 0 gets the product; the
+/// output of the other ranks is empty.
+class SosninaAMatrixMultHorizontalSummaMPI : public BaseTask {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  explicit SosninaAMatrixMultHorizontalSummaMPI(const InType &in);
+
+ private:
+  bool ValidationImpl() override;
+  bool PreProcessingImpl() override;
+  bool RunImpl() override;
+  bool PostProcessingImpl() override;
+
+  ppc::util::Matrix<double> matrix_A_;
+  ppc::util::Matrix<double> matrix_B_;
+  int rank_ = 0;
+};
+
+}  // namespace sosnina_a_matrix_mult_horizontal
@@ -2,16 +2,23 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <span>
 #include <vector>
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
+#include "util/include/gemm.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/node_shared.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
-SosninaAMatrixMultHorizontalMPI::SosninaAMatrixMultHorizontalMPI(const InType &in) {
+SosninaAMatrixMultHorizontalMPI::SosninaAMatrixMultHorizontalMPI(const InType &in, bool broadcast_result)
+    : broadcast_result_(broadcast_result) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetOutput() = std::vector<std::vector<double>>();
 
@@ -19,8 +26,8 @@ SosninaAMatrixMultHorizontalMPI::SosninaAMatrixMultHorizontalMPI(const InType &i
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   if (rank == 0) {
-    matrix_A_ = in.first;
-    matrix_B_ = in.second;
+    matrix_A_ = ppc::util::Matrix<double>::FromRows(in.first);
+    matrix_B_ = ppc::util::Matrix<double>::FromRows(in.second);
   }
 }
 
@@ -64,8 +71,7 @@ bool SosninaAMatrixMultHorizontalMPI::RunImpl() {
     return true;
   }
 
-  std::vector<double> b_flat(static_cast<size_t>(rows_b) * static_cast<size_t>(cols_b));
-  PrepareAndBroadcastMatrixB(b_flat, rows_b, cols_b);
+  const ppc::util::NodeSharedBuffer shared_b = PrepareAndBroadcastMatrixB();
 
   std::vector<int> my_row_indices;
   std::vector<double> local_a_flat;
@@ -73,12 +79,14 @@ bool SosninaAMatrixMultHorizontalMPI::RunImpl() {
   DistributeMatrixAData(my_row_indices, local_a_flat, local_rows, rows_a, cols_a);
 
   std::vector<double> local_result_flat(static_cast<size_t>(local_rows) * static_cast<size_t>(cols_b), 0.0);
-  ComputeLocalMultiplication(local_a_flat, b_flat, local_result_flat, local_rows, cols_a, cols_b);
+  ComputeLocalMultiplication(local_a_flat, shared_b.View<double>(), local_result_flat, local_rows, cols_a, cols_b);
 
   std::vector<double> final_result_flat;
   GatherResults(final_result_flat, my_row_indices, local_result_flat, local_rows, rows_a, cols_b);
 
-  ConvertToMatrix(final_result_flat, rows_a, cols_b);
+  if (broadcast_result_ || rank_ == 0) {
+    ConvertToMatrix(final_result_flat, rows_a, cols_b);
+  }
 
   return true;
 }
@@ -91,36 +99,25 @@ bool SosninaAMatrixMultHorizontalMPI::RunSequential() {
   const auto &matrix_a = matrix_A_;
   const auto &matrix_b = matrix_B_;
 
-  if (matrix_a.empty() || matrix_b.empty()) {
+  if (matrix_a.Rows() == 0 || matrix_b.Rows() == 0) {
     GetOutput() = std::vector<std::vector<double>>();
     return true;
   }
 
-  size_t rows_a = matrix_a.size();
-  size_t cols_a = matrix_a[0].size();
-  size_t cols_b = matrix_b[0].size();
-
-  auto &output = GetOutput();
-  output = std::vector<std::vector<double>>(rows_a, std::vector<double>(cols_b, 0.0));
-
-  for (size_t i = 0; i < rows_a; ++i) {
-    for (size_t k = 0; k < cols_a; ++k) {
-      double aik = matrix_a[i][k];
-      for (size_t j = 0; j < cols_b; ++j) {
-        output[i][j] += aik * matrix_b[k][j];
-      }
-    }
-  }
+  ppc::util::Matrix<double> result(matrix_a.Rows(), matrix_b.Cols());
+  ppc::util::Gemm(matrix_a.Rows(), matrix_b.Cols(), matrix_a.Cols(), matrix_a.Data(), matrix_a.Stride(),
+                  matrix_b.Data(), matrix_b.Stride(), result.Data(), result.Stride());
+  GetOutput() = result.ToRows();
 
   return true;
 }
 
 bool SosninaAMatrixMultHorizontalMPI::PrepareAndValidateSizes(int &rows_a, int &cols_a, int &rows_b, int &cols_b) {
   if (rank_ == 0) {
-    rows_a = static_cast<int>(matrix_A_.size());
-    cols_a = rows_a > 0 ? static_cast<int>(matrix_A_[0].size()) : 0;
-    rows_b = static_cast<int>(matrix_B_.size());
-    cols_b = rows_b > 0 ? static_cast<int>(matrix_B_[0].size()) : 0;
+    rows_a = static_cast<int>(matrix_A_.Rows());
+    cols_a = static_cast<int>(matrix_A_.Cols());
+    rows_b = static_cast<int>(matrix_B_.Rows());
+    cols_b = static_cast<int>(matrix_B_.Cols());
   }
 
   std::array<int, 4> sizes = {rows_a, cols_a, rows_b, cols_b};
@@ -139,25 +136,17 @@ bool SosninaAMatrixMultHorizontalMPI::PrepareAndValidateSizes(int &rows_a, int &
   return true;
 }
 
-void SosninaAMatrixMultHorizontalMPI::PrepareAndBroadcastMatrixB(std::vector<double> &b_flat, int rows_b, int cols_b) {
-  if (rank_ == 0) {
-    for (int i = 0; i < rows_b; ++i) {
-      for (int j = 0; j < cols_b; ++j) {
-        b_flat[(static_cast<size_t>(i) * static_cast<size_t>(cols_b)) + static_cast<size_t>(j)] = matrix_B_[i][j];
-      }
-    }
-  }
-
-  MPI_Bcast(b_flat.data(), rows_b * cols_b, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+ppc::util::NodeSharedBuffer SosninaAMatrixMultHorizontalMPI::PrepareAndBroadcastMatrixB() const {
+  // The matrix is stored flat without padding, so it is shared as is
+  return ppc::util::NodeSharedBuffer::FromRoot(
+      std::span<const double>(matrix_B_.Data(), matrix_B_.Rows() * matrix_B_.Cols()));
 }
 
 void SosninaAMatrixMultHorizontalMPI::FillLocalAFlat(const std::vector<int> &my_row_indices,
                                                      std::vector<double> &local_a_flat, int cols_a) {
   for (size_t idx = 0; idx < my_row_indices.size(); ++idx) {
-    int global_row = my_row_indices[idx];
-    for (int j = 0; j < cols_a; ++j) {
-      local_a_flat[(idx * static_cast<size_t>(cols_a)) + static_cast<size_t>(j)] = matrix_A_[global_row][j];
-    }
+    const auto row = matrix_A_.Row(static_cast<size_t>(my_row_indices[idx]));
+    std::ranges::copy(row, local_a_flat.begin() + static_cast<std::ptrdiff_t>(idx * static_cast<size_t>(cols_a)));
   }
 }
 
@@ -169,16 +158,12 @@ void SosninaAMatrixMultHorizontalMPI::SendRowsToProcess(int dest, const std::vec
     std::vector<int> rows_copy = dest_rows;
     MPI_Send(rows_copy.data(), dest_row_count, MPI_INT, dest, 1, MPI_COMM_WORLD);
 
-    std::vector<double> buffer(static_cast<size_t>(dest_row_count) * static_cast<size_t>(cols_a));
-    for (int idx = 0; idx < dest_row_count; ++idx) {
-      int global_row = dest_rows[idx];
-      for (int j = 0; j < cols_a; ++j) {
-        buffer[(static_cast<size_t>(idx) * static_cast<size_t>(cols_a)) + static_cast<size_t>(j)] =
-            matrix_A_[global_row][j];
-      }
-    }
-
-    MPI_Send(buffer.data(), dest_row_count * cols_a, MPI_DOUBLE, dest, 2, MPI_COMM_WORLD);
+    // The rows of dest are every world_size_-th row starting at dest_rows[0]: send them in place, without packing
+    MPI_Datatype rows_type = MPI_DATATYPE_NULL;
+    MPI_Type_vector(dest_row_count, cols_a, world_size_ * static_cast<int>(matrix_A_.Stride()), MPI_DOUBLE,
+                    &rows_type);
+    const ppc::util::MpiDatatype strided_rows(rows_type);
+    MPI_Send(&matrix_A_(static_cast<size_t>(dest_rows[0]), 0), 1, strided_rows.Get(), dest, 2, MPI_COMM_WORLD);
   }
 }
 
@@ -282,33 +267,22 @@ void SosninaAMatrixMultHorizontalMPI::GatherResults(std::vector<double> &final_r
     for (int src = 1; src < world_size_; ++src) {
       ReceiveResultsFromProcess(src, final_result_flat, cols_b);
     }
-
-    MPI_Bcast(final_result_flat.data(), rows_a * cols_b, MPI_DOUBLE, 0, MPI_COMM_WORLD);
   } else {
     SendLocalResults(local_result_flat, local_rows, cols_b);
-
     final_result_flat.resize(static_cast<size_t>(rows_a) * static_cast<size_t>(cols_b));
+  }
+
+  if (broadcast_result_) {
     MPI_Bcast(final_result_flat.data(), rows_a * cols_b, MPI_DOUBLE, 0, MPI_COMM_WORLD);
   }
 }
 
 void SosninaAMatrixMultHorizontalMPI::ComputeLocalMultiplication(const std::vector<double> &local_a_flat,
-                                                                 const std::vector<double> &b_flat,
+                                                                 std::span<const double> b_flat,
                                                                  std::vector<double> &local_result_flat, int local_rows,
                                                                  int cols_a, int cols_b) {
-  for (int i = 0; i < local_rows; ++i) {
-    const double *a_row = &local_a_flat[static_cast<size_t>(i) * static_cast<size_t>(cols_a)];
-    double *result_row = &local_result_flat[static_cast<size_t>(i) * static_cast<size_t>(cols_b)];
-
-    for (int k = 0; k < cols_a; ++k) {
-      double aik = a_row[k];
-      const double *b_row = &b_flat[static_cast<size_t>(k) * static_cast<size_t>(cols_b)];
-
-      for (int j = 0; j < cols_b; ++j) {
-        result_row[j] += aik * b_row[j];
-      }
-    }
-  }
+  ppc::util::Gemm(static_cast<size_t>(local_rows), static_cast<size_t>(cols_b), static_cast<size_t>(cols_a),
+                  local_a_flat, b_flat, local_result_flat);
 }
 
 void SosninaAMatrixMultHorizontalMPI::ConvertToMatrix(const std::vector<double> &final_result_flat, int rows_a,
@@ -0,0 +1,65 @@
+#include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_summa_mpi.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "collective/include/summa.hpp"
+#include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
+#include "util/include/matrix.hpp"
+
+namespace sosnina_a_matrix_mult_horizontal {
+
+SosninaAMatrixMultHorizontalSummaMPI::SosninaAMatrixMultHorizontalSummaMPI(const InType &in) {
+  SetTypeOfTask(GetStaticTypeOfTask());
+  GetOutput() = std::vector<std::vector<double>>();
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+  if (rank_ == 0) {
+    matrix_A_ = ppc::util::Matrix<double>::FromRows(in.first);
+    matrix_B_ = ppc::util::Matrix<double>::FromRows(in.second);
+  }
+}
+
+bool SosninaAMatrixMultHorizontalSummaMPI::ValidationImpl() {
+  int mpi_initialized = 0;
+  MPI_Initialized(&mpi_initialized);
+  return mpi_initialized != 0;
+}
+
+bool SosninaAMatrixMultHorizontalSummaMPI::PreProcessingImpl() {
+  GetOutput() = std::vector<std::vector<double>>();
+  return true;
+}
+
+bool SosninaAMatrixMultHorizontalSummaMPI::RunImpl() {
+  // FromRows stores the matrices without padding, so they are passed to SummaMultiply as they are
+  std::array<std::size_t, 4> sizes = {matrix_A_.Rows(), matrix_A_.Cols(), matrix_B_.Rows(), matrix_B_.Cols()};
+  MPI_Bcast(sizes.data(), static_cast<int>(sizes.size()), MPI_UINT64_T, 0, MPI_COMM_WORLD);
+  const auto [rows_a, cols_a, rows_b, cols_b] = sizes;
+  if (cols_a != rows_b || rows_a == 0 || cols_a == 0 || cols_b == 0) {
+    return true;
+  }
+
+  auto result_flat = ppc::collective::SummaMultiply(
+      rows_a, cols_b, cols_a, std::span<const double>(matrix_A_.Data(), rank_ == 0 ? rows_a * cols_a : 0),
+      std::span<const double>(matrix_B_.Data(), rank_ == 0 ? rows_b * cols_b : 0));
+  // Only rank 0 gets the product, the other ranks keep an empty output
+  if (rank_ != 0) {
+    return true;
+  }
+
+  ppc::util::Matrix<double> result(rows_a, cols_b);
+  std::ranges::copy(result_flat, result.Data());
+  GetOutput() = result.ToRows();
+  return true;
+}
+
+bool SosninaAMatrixMultHorizontalSummaMPI::PostProcessingImpl() {
+  return true;
+}
+
+}  // namespace sosnina_a_matrix_mult_horizontal
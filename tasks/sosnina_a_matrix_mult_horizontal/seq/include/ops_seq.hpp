@@ -1,10 +1,12 @@
 #pragma once
 
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/gemm.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
@@ -17,7 +19,9 @@ class SosninaAMatrixMultHorizontalSEQ : public BaseTask {
     return ppc::task::TypeOfTask::kSEQ;
   }
 
-  explicit SosninaAMatrixMultHorizontalSEQ(InTypeTriple in);
+  /// @param kernel GEMM kernel of the product; the default one (PPC_GEMM_KERNEL or the fastest) if not given.
+  explicit SosninaAMatrixMultHorizontalSEQ(InTypeTriple in,
+                                           std::optional<ppc::util::GemmKernel> kernel = std::nullopt);
 
   [[nodiscard]] std::vector<std::vector<double>> GetResultMatrix() const;
 
@@ -28,6 +32,7 @@ class SosninaAMatrixMultHorizontalSEQ : public BaseTask {
   bool PostProcessingImpl() override;
   InTypeTriple input_;
   std::vector<std::vector<double>> result_matrix_;
+  std::optional<ppc::util::GemmKernel> kernel_;
 };
 
 }  // namespace sosnina_a_matrix_mult_horizontal
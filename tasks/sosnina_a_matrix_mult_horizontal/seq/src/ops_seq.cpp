@@ -1,12 +1,18 @@
 #include "sosnina_a_matrix_mult_horizontal/seq/include/ops_seq.hpp"
 
 #include <cstddef>
+#include <optional>
 #include <utility>
 #include <vector>
 
+#include "util/include/gemm.hpp"
+#include "util/include/matrix.hpp"
+
 namespace sosnina_a_matrix_mult_horizontal {
 
-SosninaAMatrixMultHorizontalSEQ::SosninaAMatrixMultHorizontalSEQ(InTypeTriple in) : input_(std::move(in)) {
+SosninaAMatrixMultHorizontalSEQ::SosninaAMatrixMultHorizontalSEQ(InTypeTriple in,
+                                                                 std::optional<ppc::util::GemmKernel> kernel)
+    : input_(std::move(in)), kernel_(kernel) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetOutput() = std::vector<std::vector<double>>();
 }
@@ -42,25 +48,19 @@ bool SosninaAMatrixMultHorizontalSEQ::PreProcessingImpl() {
 }
 
 bool SosninaAMatrixMultHorizontalSEQ::RunImpl() {
-  const auto &matrix_a = input_.first;
-  const auto &matrix_b = input_.second;
-
-  size_t rows_a = matrix_a.size();
-  size_t cols_a = matrix_a[0].size();
-  size_t cols_b = matrix_b[0].size();
-
-  auto &output = GetOutput();
-  output = std::vector<std::vector<double>>(rows_a, std::vector<double>(cols_b, 0.0));
+  const auto matrix_a = ppc::util::Matrix<double>::FromRows(input_.first);
+  const auto matrix_b = ppc::util::Matrix<double>::FromRows(input_.second);
+  ppc::util::Matrix<double> result(matrix_a.Rows(), matrix_b.Cols());
 
   // Умножение матриц
-  for (size_t i = 0; i < rows_a; i++) {
-    for (size_t k = 0; k < cols_a; k++) {
-      double aik = matrix_a[i][k];
-      for (size_t j = 0; j < cols_b; j++) {
-        output[i][j] += aik * matrix_b[k][j];
-      }
-    }
+  if (kernel_.has_value()) {
+    ppc::util::Gemm(matrix_a.Rows(), matrix_b.Cols(), matrix_a.Cols(), matrix_a.Data(), matrix_a.Stride(),
+                    matrix_b.Data(), matrix_b.Stride(), result.Data(), result.Stride(), *kernel_);
+  } else {
+    ppc::util::Gemm(matrix_a.Rows(), matrix_b.Cols(), matrix_a.Cols(), matrix_a.Data(), matrix_a.Stride(),
+                    matrix_b.Data(), matrix_b.Stride(), result.Data(), result.Stride());
   }
+  GetOutput() = result.ToRows();
 
   return true;
 }
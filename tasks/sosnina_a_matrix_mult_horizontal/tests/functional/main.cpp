@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <array>
 #include <cmath>
@@ -10,6 +11,7 @@
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_mpi.hpp"
+#include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_summa_mpi.hpp"
 #include "sosnina_a_matrix_mult_horizontal/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
@@ -31,7 +33,7 @@ class SosninaAMatrixMultHorizontalFuncTests : public ppc::util::BaseRunFuncTests
     expected_ = std::get<3>(params);
   }
 
-  bool CheckTestOutputData(OutType &output_data) final {
+  bool CheckTestOutputData(OutType &output_data) override {
     // Проверяем размеры
     if (output_data.size() != expected_.size()) {
       return false;
@@ -64,8 +66,25 @@ class SosninaAMatrixMultHorizontalFuncTests : public ppc::util::BaseRunFuncTests
   std::vector<std::vector<double>> expected_;
 };
 
+/// @brief The same cases for the tasks that return the product on rank 0 only.
+class SosninaAMatrixMultHorizontalRootOutputFuncTests : public SosninaAMatrixMultHorizontalFuncTests {
+ protected:
+  bool CheckTestOutputData(OutType &output_data) final {
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) {
+      return output_data.empty();
+    }
+    return SosninaAMatrixMultHorizontalFuncTests::CheckTestOutputData(output_data);
+  }
+};
+
 namespace {
 
+TEST_P(SosninaAMatrixMultHorizontalRootOutputFuncTests, FunctionalTests) {
+  ExecuteTest(GetParam());
+}
+
 // Functional Tests
 TEST_P(SosninaAMatrixMultHorizontalFuncTests, FunctionalTests) {
   ExecuteTest(GetParam());
@@ -230,6 +249,19 @@ inline const auto kPerfTestName =
 INSTANTIATE_TEST_SUITE_P(Functional, SosninaAMatrixMultHorizontalFuncTests, kFunctionalGtestValues, kPerfTestName);
 INSTANTIATE_TEST_SUITE_P(Coverage, SosninaAMatrixMultHorizontalFuncTests, kCoverageGtestValues, kPerfTestName);
 
+// The 2D grid version shares the task type with the striped one, so its cases get their own prefix
+const auto kSummaTasksList =
+    std::tuple_cat(ppc::util::AddFuncTask<SosninaAMatrixMultHorizontalSummaMPI, InType>(
+                       kFunctionalTests, PPC_SETTINGS_sosnina_a_matrix_mult_horizontal),
+                   ppc::util::AddFuncTask<SosninaAMatrixMultHorizontalSummaMPI, InType>(
+                       kCoverageTests, PPC_SETTINGS_sosnina_a_matrix_mult_horizontal));
+
+const auto kRootOutputTestName =
+    SosninaAMatrixMultHorizontalRootOutputFuncTests::PrintFuncTestName<SosninaAMatrixMultHorizontalRootOutputFuncTests>;
+
+INSTANTIATE_TEST_SUITE_P(Summa, SosninaAMatrixMultHorizontalRootOutputFuncTests,
+                         ppc::util::ExpandToValues(kSummaTasksList), kRootOutputTestName);
+
 }  // namespace
 
 }  // namespace sosnina_a_matrix_mult_horizontal
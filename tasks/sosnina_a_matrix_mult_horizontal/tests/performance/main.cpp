@@ -1,16 +1,35 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "performance/include/roofline.hpp"
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_mpi.hpp"
+#include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_summa_mpi.hpp"
 #include "sosnina_a_matrix_mult_horizontal/seq/include/ops_seq.hpp"
+#include "util/include/gemm.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
+// The SUMMA version leaves the product on rank 0, so the striped version is also measured without the final
+// broadcast to compare them on equal terms
+class SosninaAMatrixMultHorizontalRootOutputMPI : public SosninaAMatrixMultHorizontalMPI {
+ public:
+  explicit SosninaAMatrixMultHorizontalRootOutputMPI(const InType &in) : SosninaAMatrixMultHorizontalMPI(in, false) {}
+};
+
+// The untiled triple loop on the same input: its GFLOP/s next to the ones of the seq case show what the blocked
+// kernel gains (PPC_GEMM_KERNEL selects the kernel of the other cases)
+class SosninaAMatrixMultHorizontalReferenceGemmSEQ : public SosninaAMatrixMultHorizontalSEQ {
+ public:
+  explicit SosninaAMatrixMultHorizontalReferenceGemmSEQ(const InType &in)
+      : SosninaAMatrixMultHorizontalSEQ(in, ppc::util::GemmKernel::kReference) {}
+};
+
 class SosninaAMatrixMultHorizontalRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  public:
   static constexpr size_t kSize = 800;
@@ -29,13 +48,21 @@ class SosninaAMatrixMultHorizontalRunPerfTests : public ppc::util::BaseRunPerfTe
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
-    return !output_data.empty();
+    return !output_data.empty() || ppc::util::GetMPIRank() != 0;
   }
 
   InType GetTestInputData() final {
     return std::make_pair(matrix_a_, matrix_b_);
   }
 
+  // 2 * n * k * m operations; at least A and B are read and C is written once
+  ppc::performance::Workload GetWorkload(const InType &input) final {
+    const auto n = static_cast<double>(input.first.size());
+    const auto k = static_cast<double>(input.second.size());
+    const auto m = static_cast<double>(input.second.front().size());
+    return {.bytes = ((n * k) + (k * m) + (n * m)) * sizeof(double), .flops = 2.0 * n * k * m, .elements = n * m};
+  }
+
  private:
   std::vector<std::vector<double>> matrix_a_;
   std::vector<std::vector<double>> matrix_b_;
@@ -45,9 +72,16 @@ TEST_P(SosninaAMatrixMultHorizontalRunPerfTests, RunPerfModes) {
   ExecuteTest(GetParam());
 }
 
-const auto kAllPerfTasks =
+// The SUMMA cases run next to the striped ones; compare their time and the comm_bytes of their _ranks lines
+const auto kAllPerfTasks = std::tuple_cat(
     ppc::util::MakeAllPerfTasks<InType, SosninaAMatrixMultHorizontalMPI, SosninaAMatrixMultHorizontalSEQ>(
-        PPC_SETTINGS_sosnina_a_matrix_mult_horizontal);
+        PPC_SETTINGS_sosnina_a_matrix_mult_horizontal),
+    ppc::util::MakePerfTaskTuples<SosninaAMatrixMultHorizontalRootOutputMPI, InType>(
+        PPC_SETTINGS_sosnina_a_matrix_mult_horizontal, 0, "root_output"),
+    ppc::util::MakePerfTaskTuples<SosninaAMatrixMultHorizontalSummaMPI, InType>(
+        PPC_SETTINGS_sosnina_a_matrix_mult_horizontal, 0, "summa"),
+    ppc::util::MakePerfTaskTuples<SosninaAMatrixMultHorizontalReferenceGemmSEQ, InType>(
+        PPC_SETTINGS_sosnina_a_matrix_mult_horizontal, 0, "reference_gemm"));
 const auto kGtestValues = ppc::util::TupleToGTestValues(kAllPerfTasks);
 
 const auto kPerfTestName = SosninaAMatrixMultHorizontalRunPerfTests::CustomPerfTestName;
@@ -5,15 +5,16 @@
 #include <cstdlib>
 #include <limits>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "tsyplakov_k_vec_neighbours/common/include/common.hpp"
 
 namespace tsyplakov_k_vec_neighbours {
 
-TsyplakovKVecNeighboursMPI::TsyplakovKVecNeighboursMPI(const InType &in) {
+TsyplakovKVecNeighboursMPI::TsyplakovKVecNeighboursMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::make_tuple(-1, -1);
 }
 
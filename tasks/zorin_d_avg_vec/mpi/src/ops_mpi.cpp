@@ -3,15 +3,16 @@
 #include <mpi.h>
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "zorin_d_avg_vec/common/include/common.hpp"
 
 namespace zorin_d_avg_vec {
 
-ZorinDAvgVecMPI::ZorinDAvgVecMPI(const InType &in) {
+ZorinDAvgVecMPI::ZorinDAvgVecMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0.0;
 }
 
@@ -10,7 +10,7 @@ class ZorinDAvgVecSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ZorinDAvgVecSEQ(const InType &in);
+  explicit ZorinDAvgVecSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -1,15 +1,16 @@
 #include "zorin_d_avg_vec/seq/include/ops_seq.hpp"
 
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "zorin_d_avg_vec/common/include/common.hpp"
 
 namespace zorin_d_avg_vec {
 
-ZorinDAvgVecSEQ::ZorinDAvgVecSEQ(const InType &in) {
+ZorinDAvgVecSEQ::ZorinDAvgVecSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 